@@ -7,6 +7,14 @@
 
 #include "gch/small_vector.hpp"
 
+#include "gch/aligned_allocator.hpp"
+#include "gch/arena_allocator.hpp"
+
+#ifdef __linux__
+#  include "gch/huge_page_allocator.hpp"
+#  include "gch/mmap_allocator.hpp"
+#endif
+
 #ifdef GCH_WITH_BOOST
 #  include <boost/container/small_vector.hpp>
 #endif
@@ -20,7 +28,9 @@
 #endif
 
 #include <array>
+#include <fstream>
 #include <iostream>
+#include <memory>
 #include <typeinfo>
 #include <random>
 #include <vector>
@@ -67,8 +77,8 @@ struct benched_containers<T, static_cast<std::size_t> (-1)>
 template <typename T, std::size_t BufferSize = static_cast<std::size_t> (-1)>
 using benched_containers_t = typename benched_containers<T, BufferSize>::type;
 
-template <typename T, unsigned N, typename Allocator>
-struct container_name<gch::small_vector<T, N, Allocator>>
+template <typename T, unsigned N, typename Allocator, typename Options>
+struct container_name<gch::small_vector<T, N, Allocator, Options>>
 {
   static constexpr
   const char *
@@ -119,6 +129,32 @@ struct container_name<folly::small_vector<T, N>>
 
 #endif
 
+template <typename GrowthPolicy>
+struct growth_options
+  : gch::small_vector_default_options
+{
+  using growth_policy = GrowthPolicy;
+};
+
+template <typename T, typename GrowthPolicy>
+using small_vector_with_growth =
+  gch::small_vector<T, gch::default_buffer_size<std::allocator<T>>::value, std::allocator<T>,
+                    growth_options<GrowthPolicy>>;
+
+template <typename T, typename Layout>
+using small_vector_with_layout =
+  gch::small_vector<T,
+                    gch::default_buffer_size<std::allocator<T>,
+                                             gch::small_vector_layout_options<Layout>>::value,
+                    std::allocator<T>,
+                    gch::small_vector_layout_options<Layout>>;
+
+template <typename T>
+using small_vector_with_basic_guarantee =
+  gch::small_vector<T, gch::default_buffer_size<std::allocator<T>>::value, std::allocator<T>,
+                    gch::small_vector_exception_guarantee_options<
+                      gch::small_vector_exception_guarantee::basic>>;
+
 using std::chrono::milliseconds;
 using std::chrono::microseconds;
 
@@ -185,6 +221,43 @@ namespace
   {
     return sizeof (T) <= sizeof (std::size_t);
   }
+
+#ifdef __linux__
+
+  // Reads a field (in KiB) from /proc/self/status.
+  std::size_t
+  read_status_kib (const std::string& field)
+  {
+    std::ifstream status ("/proc/self/status");
+    std::string line;
+    while (std::getline (status, line))
+    {
+      if (line.compare (0, field.size (), field) == 0)
+        return std::stoul (line.substr (field.size ()));
+    }
+    return 0;
+  }
+
+  // Resets the peak resident set size of the process to the current resident set size.
+  void
+  reset_peak_rss (void)
+  {
+    std::ofstream ("/proc/self/clear_refs") << "5";
+  }
+
+  std::size_t
+  current_rss_kib (void)
+  {
+    return read_status_kib ("VmRSS:");
+  }
+
+  std::size_t
+  peak_rss_kib (void)
+  {
+    return read_status_kib ("VmHWM:");
+  }
+
+#endif
 } //end of anonymous namespace
 
 // tested types
@@ -279,6 +352,86 @@ public:
   }
 };
 
+// non trivial, holds a heap allocated string
+class NonTrivialString
+{
+private:
+  std::string data { "some pretty long string to make sure it is not optimized with SSO" };
+
+public:
+  std::size_t a { 0 };
+
+  NonTrivialString (void) = default;
+
+  NonTrivialString (std::size_t a_)
+    : a (a_)
+  { }
+
+  bool operator< (const NonTrivialString& other) const { return a < other.a; }
+};
+
+// libc++ doesn't store a pointer into the object itself for short strings, so we can relocate it
+// with memcpy. This isn't true for libstdc++.
+#ifdef _LIBCPP_VERSION
+
+namespace gch
+{
+
+  template <>
+  struct is_trivially_relocatable<NonTrivialString>
+    : std::true_type
+  { };
+
+}
+
+#endif
+
+// non trivial, owns a heap allocation through a `std::unique_ptr`
+class NonTrivialUniquePtr
+{
+private:
+  std::unique_ptr<std::size_t> ptr { new std::size_t (0) };
+
+public:
+  std::size_t a { 0 };
+
+  NonTrivialUniquePtr            (void)                           = default;
+//NonTrivialUniquePtr            (const NonTrivialUniquePtr&)     = impl;
+  NonTrivialUniquePtr            (NonTrivialUniquePtr&&) noexcept = default;
+//NonTrivialUniquePtr& operator= (const NonTrivialUniquePtr&)     = impl;
+  NonTrivialUniquePtr& operator= (NonTrivialUniquePtr&&) noexcept = default;
+  ~NonTrivialUniquePtr           (void)                           = default;
+
+  NonTrivialUniquePtr (const NonTrivialUniquePtr& other)
+    : ptr (new std::size_t (*other.ptr)),
+      a (other.a)
+  { }
+
+  NonTrivialUniquePtr&
+  operator= (const NonTrivialUniquePtr& other)
+  {
+    *ptr = *other.ptr;
+    a = other.a;
+    return *this;
+  }
+
+  NonTrivialUniquePtr (std::size_t a_)
+    : a (a_)
+  { }
+
+  bool operator< (const NonTrivialUniquePtr& other) const { return a < other.a; }
+};
+
+namespace gch
+{
+
+  template <>
+  struct is_trivially_relocatable<NonTrivialUniquePtr>
+    : std::true_type
+  { };
+
+}
+
 // non trivial, quite expensive to copy and move
 template <int N>
 class NonTrivialArray
@@ -319,6 +472,8 @@ using TrivialMonster = Trivial<4 * 1024>;  static_assert (
 
 static_assert (is_non_trivial_nothrow_movable<NonTrivialStringMovableNoExcept> (), "Invalid type");
 static_assert (is_non_trivial_non_nothrow_movable<NonTrivialStringMovable> (), "Invalid type");
+static_assert (is_non_trivial_nothrow_movable<NonTrivialString> (), "Invalid type");
+static_assert (is_non_trivial_nothrow_movable<NonTrivialUniquePtr> (), "Invalid type");
 
 using NonTrivialArrayMedium = NonTrivialArray<32>;
 static_assert (is_non_trivial_of_size<NonTrivialArrayMedium> (32), "Invalid type");
@@ -413,6 +568,13 @@ struct bench_fill_back
       std::begin (sizes),
       std::end (sizes),
       " with reserve");
+
+    // This only differs from `gch::small_vector` if `T` has a throwing move constructor.
+    bench<small_vector_with_basic_guarantee<T>, microseconds, Empty, FillBack> (
+      g,
+      "gch::small_vector (basic guarantee)",
+      std::begin (sizes),
+      std::end (sizes));
   }
 };
 
@@ -537,6 +699,12 @@ struct bench_random_insert
       g,
       std::begin (sizes),
       std::end (sizes));
+
+    bench<small_vector_with_basic_guarantee<T>, microseconds, FilledRandom, Insert> (
+      g,
+      "gch::small_vector (basic guarantee)",
+      std::begin (sizes),
+      std::end (sizes));
   }
 };
 
@@ -711,8 +879,481 @@ struct bench_find
   }
 };
 
+template <typename T>
+struct bench_growth_policy
+{
+  static void run (graphs::graph_manager& graph_man)
+  {
+    using namespace gch::small_vector_growth;
+
+    graphs::graph& g = add_graph<T> (graph_man, "growth_policy fill_back", "us");
+    constexpr auto sizes = to_array (big_sizes);
+
+    bench<small_vector_with_growth<T, doubling>, microseconds, Empty, FillBack> (
+      g,
+      "gch::small_vector (doubling)",
+      std::begin (sizes),
+      std::end (sizes));
+
+    bench<small_vector_with_growth<T, one_and_a_half>, microseconds, Empty, FillBack> (
+      g,
+      "gch::small_vector (one_and_a_half)",
+      std::begin (sizes),
+      std::end (sizes));
+
+    bench<small_vector_with_growth<T, chunked<1024 * 1024>>, microseconds, Empty, FillBack> (
+      g,
+      "gch::small_vector (chunked after 1 MiB)",
+      std::begin (sizes),
+      std::end (sizes));
+
+    // `exact` reallocates on every insertion here, so it is only measured with chunked appends.
+    graphs::graph& h = add_graph<T> (graph_man, "growth_policy fill_back chunks", "us");
+    constexpr auto chunked_sizes = to_array (medium_sizes);
+
+    bench<small_vector_with_growth<T, doubling>, microseconds, Empty, FillBackChunks> (
+      h,
+      "gch::small_vector (doubling)",
+      std::begin (chunked_sizes),
+      std::end (chunked_sizes));
+
+    bench<small_vector_with_growth<T, one_and_a_half>, microseconds, Empty, FillBackChunks> (
+      h,
+      "gch::small_vector (one_and_a_half)",
+      std::begin (chunked_sizes),
+      std::end (chunked_sizes));
+
+    bench<small_vector_with_growth<T, exact>, microseconds, Empty, FillBackChunks> (
+      h,
+      "gch::small_vector (exact)",
+      std::begin (chunked_sizes),
+      std::end (chunked_sizes));
+
+    bench<small_vector_with_growth<T, chunked<1024 * 1024>>, microseconds, Empty,
+          FillBackChunks> (
+      h,
+      "gch::small_vector (chunked after 1 MiB)",
+      std::begin (chunked_sizes),
+      std::end (chunked_sizes));
+  }
+};
+
+template <typename T>
+struct bench_layout
+{
+  template <typename Layout>
+  static
+  void
+  run_layout (graphs::graph& size_graph, graphs::graph& traversal_graph,
+              graphs::graph& move_graph, graphs::graph& destroy_graph, const std::string& name)
+  {
+    using vector_type = small_vector_with_layout<T, Layout>;
+    using nested_type = std::vector<vector_type>;
+
+    size_graph.add_result (name, "sizeof", sizeof (vector_type));
+
+    constexpr auto sizes = to_array (medium_sizes);
+    bench<nested_type, microseconds, FilledNested, IterateNested> (
+      traversal_graph,
+      name,
+      std::begin (sizes),
+      std::end (sizes));
+
+    // The nested vectors are a mix of inlined and allocated vectors.
+    constexpr auto big = to_array (big_sizes);
+    bench<nested_type, microseconds, FilledNested, MoveNested> (
+      move_graph,
+      name,
+      std::begin (big),
+      std::end (big));
+
+    bench<nested_type, microseconds, FilledNested, DestroyNested> (
+      destroy_graph,
+      name,
+      std::begin (big),
+      std::end (big));
+  }
+
+  static void run (graphs::graph_manager& graph_man)
+  {
+    using namespace gch::small_vector_layout;
+
+    graphs::graph& s = add_graph<T> (graph_man, "layout sizeof", "bytes");
+    graphs::graph& g = add_graph<T> (graph_man, "layout nested traversal", "us");
+    graphs::graph& m = add_graph<T> (graph_man, "layout nested move", "us");
+    graphs::graph& d = add_graph<T> (graph_man, "layout nested destroy", "us");
+
+    run_layout<standard> (s, g, m, d, "gch::small_vector (standard)");
+    run_layout<compact> (s, g, m, d, "gch::small_vector (compact)");
+    run_layout<heap_header> (s, g, m, d, "gch::small_vector (heap header)");
+  }
+};
+
+template <typename T>
+struct bench_nested_reallocation
+{
+  template <typename Inner>
+  static
+  void
+  run_nested (graphs::graph& copy_graph, graphs::graph& reallocation_graph,
+              const std::string& name)
+  {
+    using nested_type = std::vector<Inner>;
+
+    // The nested vectors are a mix of inlined and allocated vectors.
+    constexpr auto sizes = to_array (big_sizes);
+    bench<nested_type, microseconds, FilledNested, CopyNested> (
+      copy_graph,
+      name,
+      std::begin (sizes),
+      std::end (sizes));
+
+    bench<nested_type, microseconds, FilledNested, ReallocateNested> (
+      reallocation_graph,
+      name,
+      std::begin (sizes),
+      std::end (sizes));
+  }
+
+  static void run (graphs::graph_manager& graph_man)
+  {
+    graphs::graph& c = add_graph<T> (graph_man, "nested copy", "us");
+    graphs::graph& r = add_graph<T> (graph_man, "nested reallocation", "us");
+
+    // Compile with `GCH_SMALL_VECTOR_MAX_BLOCK_COPY_SIZE=0` to compare against copies of only the
+    // elements of inlined vectors.
+    run_nested<gch::small_vector<T>> (c, r, "gch::small_vector");
+    run_nested<small_vector_with_layout<T, gch::small_vector_layout::compact>> (
+      c, r, "gch::small_vector (compact)");
+    run_nested<std::vector<T>> (c, r, "std::vector");
+  }
+};
+
+template <typename T>
+struct bench_unchecked
+{
+  static void run (graphs::graph_manager& graph_man)
+  {
+    using vector_type = gch::small_vector<T>;
+
+    graphs::graph& g = add_graph<T> (graph_man, "unchecked fill_back with reserve", "us");
+    graphs::graph& e = add_graph<T> (graph_man, "unchecked emplace_back with reserve", "us");
+    graphs::graph& a = add_graph<T> (graph_man, "unchecked append with reserve", "us");
+
+    constexpr auto sizes = to_array (big_sizes);
+
+    bench<vector_type, microseconds, Empty, ReserveSize, FillBack> (
+      g,
+      "gch::small_vector (push_back)",
+      std::begin (sizes),
+      std::end (sizes));
+
+    bench<vector_type, microseconds, Empty, ReserveSize, UncheckedFillBack> (
+      g,
+      "gch::small_vector (unchecked_push_back)",
+      std::begin (sizes),
+      std::end (sizes));
+
+    bench<vector_type, microseconds, Empty, ReserveSize, EmplaceBack> (
+      e,
+      "gch::small_vector (emplace_back)",
+      std::begin (sizes),
+      std::end (sizes));
+
+    bench<vector_type, microseconds, Empty, ReserveSize, UncheckedEmplaceBack> (
+      e,
+      "gch::small_vector (unchecked_emplace_back)",
+      std::begin (sizes),
+      std::end (sizes));
+
+    bench<vector_type, microseconds, Empty, ReserveSize, AppendChunks> (
+      a,
+      "gch::small_vector (append)",
+      std::begin (sizes),
+      std::end (sizes));
+
+    bench<vector_type, microseconds, Empty, ReserveSize, UncheckedAppendChunks> (
+      a,
+      "gch::small_vector (unchecked_append)",
+      std::begin (sizes),
+      std::end (sizes));
+  }
+};
+
 //Launch the benchmark
 
+#ifdef __linux__
+
+template <typename T>
+struct bench_mmap
+{
+  template <typename Vector>
+  static
+  void
+  run_vector (graphs::graph& time_graph, graphs::graph& rss_graph, const std::string& name)
+  {
+    constexpr auto sizes = to_array (big_sizes);
+
+    bench<Vector, microseconds, Empty, FillBack> (
+      time_graph,
+      name,
+      std::begin (sizes),
+      std::end (sizes));
+
+    // The peak is measured relative to the resident set size before filling.
+    for (std::size_t size : sizes)
+    {
+      const std::size_t baseline = current_rss_kib ();
+      reset_peak_rss ();
+      {
+        Vector v;
+        FillBack<Vector> { } (v, size);
+      }
+      rss_graph.add_result (name, std::to_string (size), peak_rss_kib () - baseline);
+    }
+  }
+
+  static void run (graphs::graph_manager& graph_man)
+  {
+    graphs::graph& g = add_graph<T> (graph_man, "mmap fill_back", "us");
+    graphs::graph& r = add_graph<T> (graph_man, "mmap fill_back peak RSS", "KiB");
+
+    // `mmap_allocator` grows with `mremap` if `T` is trivially relocatable.
+    run_vector<gch::small_vector<T>> (g, r, "gch::small_vector");
+    run_vector<gch::small_vector<T, 0, gch::mmap_allocator<T>>> (
+      g, r, "gch::small_vector (mmap_allocator)");
+    run_vector<std::vector<T>> (g, r, "std::vector");
+  }
+};
+
+template <typename T>
+struct bench_huge_pages
+{
+  static void run (graphs::graph_manager& graph_man)
+  {
+    graphs::graph& g = add_graph<T> (graph_man, "huge pages random_access", "us");
+    constexpr auto sizes = to_array (big_sizes);
+
+    bench<gch::small_vector<T>, microseconds, Filled, RandomAccess> (
+      g,
+      "gch::small_vector",
+      std::begin (sizes),
+      std::end (sizes));
+
+    bench<gch::small_vector<T, 0, gch::huge_page_allocator<T>>, microseconds, Filled,
+          RandomAccess> (
+      g,
+      "gch::small_vector (huge_page_allocator)",
+      std::begin (sizes),
+      std::end (sizes));
+
+    bench<std::vector<T>, microseconds, Filled, RandomAccess> (
+      g,
+      "std::vector",
+      std::begin (sizes),
+      std::end (sizes));
+  }
+};
+
+#endif
+
+template <typename T>
+struct bench_alignment
+{
+  static void run (graphs::graph_manager& graph_man)
+  {
+    using aligned_vector_type =
+      gch::small_vector<T, gch::default_buffer_size<std::allocator<T>>::value,
+                        gch::aligned_allocator<T, 64>, gch::small_vector_alignment_options<64>>;
+
+    graphs::graph& g = add_graph<T> (graph_man, "alignment reduce", "us");
+    constexpr auto sizes = to_array (big_sizes);
+
+    bench<gch::small_vector<T>, microseconds, Filled, Reduce> (
+      g,
+      "gch::small_vector",
+      std::begin (sizes),
+      std::end (sizes));
+
+    bench<aligned_vector_type, microseconds, Filled, Reduce> (
+      g,
+      "gch::small_vector (aligned to 64)",
+      std::begin (sizes),
+      std::end (sizes));
+
+    bench<std::vector<T>, microseconds, Filled, Reduce> (
+      g,
+      "std::vector",
+      std::begin (sizes),
+      std::end (sizes));
+  }
+};
+
+// Handles requests with vectors which allocate from the global heap.
+template <typename Vector>
+struct heap_request_handler
+{
+  Vector
+  make_vector (void) const
+  {
+    return Vector ();
+  }
+
+  void
+  consume (const Vector& v) noexcept
+  {
+    checksum += static_cast<std::size_t> (v.back ().a);
+  }
+
+  void
+  end_request (void) const noexcept
+  { }
+
+  std::size_t checksum = 0;
+};
+
+// Handles requests with vectors which allocate from an arena. The arena is released all at once at
+// the end of each request.
+template <typename Vector>
+struct arena_request_handler
+{
+  Vector
+  make_vector (void) const
+  {
+    return Vector (*arena);
+  }
+
+  void
+  consume (const Vector& v) noexcept
+  {
+    checksum += static_cast<std::size_t> (v.back ().a);
+  }
+
+  void
+  end_request (void) const noexcept
+  {
+    arena->release ();
+  }
+
+  std::unique_ptr<gch::arena> arena { new gch::arena };
+  std::size_t checksum = 0;
+};
+
+template <typename T>
+struct bench_arena
+{
+  static void run (graphs::graph_manager& graph_man)
+  {
+    constexpr unsigned N = 8;
+    using heap_vector_type  = gch::small_vector<T, N>;
+    using arena_vector_type = gch::small_vector<T, N, gch::arena_allocator<T>>;
+
+    graphs::graph& g = add_graph<T> (graph_man, "arena request churn", "us");
+    constexpr auto sizes = to_array (medium_sizes);
+
+    bench<heap_request_handler<heap_vector_type>, microseconds, Empty, HandleRequests> (
+      g,
+      "gch::small_vector",
+      std::begin (sizes),
+      std::end (sizes));
+
+    bench<arena_request_handler<arena_vector_type>, microseconds, Empty, HandleRequests> (
+      g,
+      "gch::small_vector (arena_allocator)",
+      std::begin (sizes),
+      std::end (sizes));
+
+    bench<heap_request_handler<std::vector<T>>, microseconds, Empty, HandleRequests> (
+      g,
+      "std::vector",
+      std::begin (sizes),
+      std::end (sizes));
+  }
+};
+
+#ifdef GCH_LIB_MEMORY_RESOURCE
+
+// Handles requests with vectors which allocate from a memory resource. If the resource is a
+// `std::pmr::monotonic_buffer_resource`, it is released at the end of each request.
+template <typename Vector, typename Resource>
+struct pmr_request_handler
+{
+  Vector
+  make_vector (void) const
+  {
+    return Vector (resource.get ());
+  }
+
+  void
+  consume (const Vector& v) noexcept
+  {
+    checksum += static_cast<std::size_t> (v.back ().a);
+  }
+
+  void
+  end_request (void) const noexcept
+  {
+    release (*resource);
+  }
+
+  static
+  void
+  release (std::pmr::monotonic_buffer_resource& r) noexcept
+  {
+    r.release ();
+  }
+
+  static
+  void
+  release (std::pmr::memory_resource&) noexcept
+  { }
+
+  std::unique_ptr<Resource> resource { new Resource };
+  std::size_t checksum = 0;
+};
+
+template <typename T>
+struct bench_pmr
+{
+  static void run (graphs::graph_manager& graph_man)
+  {
+    constexpr unsigned N = 8;
+    using pmr_vector_type = gch::pmr::small_vector<T, N>;
+
+    graphs::graph& g = add_graph<T> (graph_man, "pmr request churn", "us");
+    constexpr auto sizes = to_array (medium_sizes);
+
+    bench<heap_request_handler<gch::small_vector<T, N>>, microseconds, Empty, HandleRequests> (
+      g,
+      "gch::small_vector",
+      std::begin (sizes),
+      std::end (sizes));
+
+    bench<pmr_request_handler<pmr_vector_type, std::pmr::unsynchronized_pool_resource>,
+          microseconds, Empty, HandleRequests> (
+      g,
+      "gch::pmr::small_vector (unsynchronized_pool_resource)",
+      std::begin (sizes),
+      std::end (sizes));
+
+    bench<pmr_request_handler<pmr_vector_type, std::pmr::monotonic_buffer_resource>,
+          microseconds, Empty, HandleRequests> (
+      g,
+      "gch::pmr::small_vector (monotonic_buffer_resource)",
+      std::begin (sizes),
+      std::end (sizes));
+
+    bench<pmr_request_handler<std::pmr::vector<T>, std::pmr::unsynchronized_pool_resource>,
+          microseconds, Empty, HandleRequests> (
+      g,
+      "std::pmr::vector (unsynchronized_pool_resource)",
+      std::begin (sizes),
+      std::end (sizes));
+  }
+};
+
+#endif
+
 template <typename ...Types>
 graphs::graph_manager&
 bench_all (graphs::graph_manager& graph_man)
@@ -730,6 +1371,19 @@ bench_all (graphs::graph_manager& graph_man)
   // bench_types<bench_destruction, Types...> (graph_man);
   // bench_types<bench_erase_1, Types...> (graph_man);
   bench_types<bench_erase_10, Types...> (graph_man);
+  bench_types<bench_growth_policy, Types...> (graph_man);
+  bench_types<bench_layout, Types...> (graph_man);
+  bench_types<bench_nested_reallocation, Types...> (graph_man);
+  bench_types<bench_unchecked, Types...> (graph_man);
+  bench_types<bench_alignment, Types...> (graph_man);
+  bench_types<bench_arena, Types...> (graph_man);
+#ifdef GCH_LIB_MEMORY_RESOURCE
+  bench_types<bench_pmr, Types...> (graph_man);
+#endif
+#ifdef __linux__
+  bench_types<bench_mmap, Types...> (graph_man);
+  bench_types<bench_huge_pages, Types...> (graph_man);
+#endif
   // bench_types<bench_erase_25, Types...> (graph_man);
   // bench_types<bench_erase_50, Types...> (graph_man);
 
@@ -754,6 +1408,8 @@ main (void)
       // , TrivialMonster
       , NonTrivialStringMovable
       , NonTrivialStringMovableNoExcept
+      , NonTrivialString
+      , NonTrivialUniquePtr
       // , NonTrivialArray<32>
       > (graph_man);
 
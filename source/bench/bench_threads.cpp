@@ -0,0 +1,198 @@
+/** bench_threads.cpp
+ * Benchmarks of vectors which are created and destroyed at a high
+ * rate on several threads at once.
+ *
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "gch/small_vector.hpp"
+#include "gch/caching_allocator.hpp"
+
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+
+using std::chrono::milliseconds;
+
+namespace
+{
+
+  struct element
+  {
+    std::size_t a;
+  };
+
+  constexpr std::size_t thread_counts[] { 1, 2, 4, 8 };
+
+  // The number of requests handled by each thread.
+  constexpr std::size_t num_requests = 20000;
+
+  // Each request fills a few vectors. Most of them spill out of their inline storage.
+  template <typename Vector>
+  std::size_t
+  handle_request (std::size_t request)
+  {
+    std::size_t checksum = 0;
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+      Vector v;
+      for (std::size_t j = 0; j < 4 * (i + 1); ++j)
+        v.push_back ({ request + j });
+      checksum += v.back ().a;
+    }
+    return checksum;
+  }
+
+  template <typename Function>
+  std::size_t
+  time_threads (std::size_t num_threads, Function f)
+  {
+    using namespace std::chrono;
+
+    std::vector<std::thread> threads;
+    threads.reserve (num_threads);
+
+    time_point<high_resolution_clock> t0 = high_resolution_clock::now ();
+    for (std::size_t i = 0; i < num_threads; ++i)
+      threads.emplace_back (f, i);
+    for (std::thread& t : threads)
+      t.join ();
+    time_point<high_resolution_clock> t1 = high_resolution_clock::now ();
+
+    return static_cast<std::size_t> (duration_cast<milliseconds> (t1 - t0).count ());
+  }
+
+  // Every thread handles its own requests.
+  template <typename Vector>
+  void
+  bench_churn (graphs::graph& g, const std::string& name)
+  {
+    for (std::size_t num_threads : thread_counts)
+    {
+      std::vector<std::size_t> checksums (num_threads);
+      const std::size_t duration = time_threads (num_threads, [&](std::size_t id) {
+        for (std::size_t request = 0; request < num_requests; ++request)
+          checksums[id] += handle_request<Vector> (request);
+      });
+      g.add_result (name, std::to_string (num_threads), duration);
+    }
+  }
+
+  // Hands batches of vectors from producers to consumers, so every vector is destroyed on a
+  // different thread from the one which allocated it.
+  template <typename Vector>
+  class batch_queue
+  {
+  public:
+    void
+    push (std::vector<Vector>&& batch)
+    {
+      std::unique_lock<std::mutex> lock (m_mutex);
+      m_not_full.wait (lock, [this] { return m_batches.size () < 4; });
+      m_batches.push_back (std::move (batch));
+      m_not_empty.notify_one ();
+    }
+
+    std::vector<Vector>
+    pop (void)
+    {
+      std::unique_lock<std::mutex> lock (m_mutex);
+      m_not_empty.wait (lock, [this] { return ! m_batches.empty (); });
+      std::vector<Vector> ret (std::move (m_batches.back ()));
+      m_batches.pop_back ();
+      m_not_full.notify_one ();
+      return ret;
+    }
+
+  private:
+    std::mutex                       m_mutex;
+    std::condition_variable          m_not_empty;
+    std::condition_variable          m_not_full;
+    std::vector<std::vector<Vector>> m_batches;
+  };
+
+  template <typename Vector>
+  void
+  bench_handoff (graphs::graph& g, const std::string& name)
+  {
+    constexpr std::size_t batch_size  = 64;
+    constexpr std::size_t num_batches = num_requests / batch_size;
+
+    for (std::size_t num_threads : thread_counts)
+    {
+      if (num_threads < 2)
+        continue;
+
+      // Even threads produce and odd threads consume.
+      std::vector<batch_queue<Vector>> queues (num_threads / 2);
+      std::vector<std::size_t> checksums (num_threads);
+      const std::size_t duration = time_threads (num_threads, [&](std::size_t id) {
+        batch_queue<Vector>& queue = queues[id / 2];
+        for (std::size_t b = 0; b < num_batches; ++b)
+        {
+          if (id % 2 == 0)
+          {
+            std::vector<Vector> batch (batch_size);
+            for (std::size_t i = 0; i < batch_size; ++i)
+            {
+              for (std::size_t j = 0; j < 4 * (i % 8 + 1); ++j)
+                batch[i].push_back ({ b + j });
+            }
+            queue.push (std::move (batch));
+          }
+          else
+          {
+            for (const Vector& v : queue.pop ())
+              checksums[id] += v.back ().a;
+          }
+        }
+      });
+      g.add_result (name, std::to_string (num_threads), duration);
+    }
+  }
+
+  template <typename Vector>
+  void
+  bench_vector (graphs::graph& churn_graph, graphs::graph& handoff_graph,
+                const std::string& name)
+  {
+    bench_churn<Vector> (churn_graph, name);
+    bench_handoff<Vector> (handoff_graph, name);
+  }
+
+}
+
+int
+main (void)
+{
+  graphs::graph_manager graph_man;
+
+  try
+  {
+    graphs::graph& c = graph_man.add_graph (tag ("threaded request churn"),
+                                            "threaded request churn", "ms");
+    graphs::graph& h = graph_man.add_graph (tag ("threaded handoff churn"),
+                                            "threaded handoff churn", "ms");
+
+    bench_vector<gch::small_vector<element, 8>> (c, h, "gch::small_vector");
+    bench_vector<gch::small_vector<element, 8, gch::caching_allocator<element>>> (
+      c, h, "gch::small_vector (caching_allocator)");
+    bench_vector<std::vector<element>> (c, h, "std::vector");
+
+    graph_man.generate_output (graphs::graph_manager::output_type::GOOGLE);
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << e.what () << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
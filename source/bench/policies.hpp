@@ -80,6 +80,28 @@ struct FilledRandom
   }
 };
 
+// Create a container of `size` small containers. Their lengths cycle through [0, 16) so that
+// both inlined and allocated inner containers are measured.
+
+template <class Container>
+struct FilledNested
+{
+  static
+  Container
+  make (std::size_t size)
+  {
+    Container container;
+    container.reserve (size);
+    for (std::size_t i = 0 ; i < size ; ++i)
+    {
+      container.emplace_back ();
+      for (std::size_t j = 0 ; j < i % 16 ; ++j)
+        container.back ().push_back ({ j });
+    }
+    return container;
+  }
+};
+
 template <class Container>
 struct FilledRandomInsert
 {
@@ -214,6 +236,20 @@ struct FillBackInserter
   }
 };
 
+template <class Container>
+struct FillBackChunks
+{
+  const typename Container::value_type value { };
+
+  void
+  operator() (Container& c, std::size_t size)
+  {
+    constexpr std::size_t chunk_size = 1000;
+    for (std::size_t i = 0 ; i < size ; i += chunk_size)
+      c.insert (c.end (), (std::min) (chunk_size, size - i), value);
+  }
+};
+
 template <class Container>
 struct EmplaceBack
 {
@@ -225,6 +261,60 @@ struct EmplaceBack
   }
 };
 
+// The container must already have capacity for `size` elements.
+template <class Container>
+struct UncheckedFillBack
+{
+  const typename Container::value_type value { };
+
+  void
+  operator() (Container& c, std::size_t size)
+  {
+    for (size_t i = 0 ; i < size ; ++i)
+      c.unchecked_push_back (value);
+  }
+};
+
+template <class Container>
+struct UncheckedEmplaceBack
+{
+  void
+  operator() (Container& c, std::size_t size)
+  {
+    for (size_t i = 0 ; i < size ; ++i)
+      c.unchecked_emplace_back ();
+  }
+};
+
+template <class Container>
+struct AppendChunks
+{
+  std::array<typename Container::value_type, 16> chunk { };
+
+  void
+  operator() (Container& c, std::size_t size)
+  {
+    for (std::size_t i = 0 ; i < size ; i += chunk.size ())
+      c.append (chunk.begin (), chunk.begin () + (std::min) (chunk.size (), size - i));
+  }
+};
+
+// The container must already have capacity for `size` elements.
+template <class Container>
+struct UncheckedAppendChunks
+{
+  std::array<typename Container::value_type, 16> chunk { };
+
+  void
+  operator() (Container& c, std::size_t size)
+  {
+    for (std::size_t i = 0 ; i < size ; i += chunk.size ())
+    {
+      c.unchecked_append (chunk.begin (), chunk.begin () + (std::min) (chunk.size (), size - i));
+    }
+  }
+};
+
 template <class Container>
 struct EmplaceBackMultiple
 {
@@ -386,6 +476,125 @@ struct Iterate
   }
 };
 
+// Visits every element once in a scattered order, so that most accesses land on a different page.
+// The stride is a prime larger than any of the sizes, so it is coprime with the size.
+template <class Container>
+struct RandomAccess
+{
+  void
+  operator() (Container& c, std::size_t size)
+  {
+    std::size_t idx = 0;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      idx = (idx + 1000003) % size;
+      ++(c[idx].a);
+    }
+  }
+};
+
+// Sums the elements through `data ()`, which the compiler may vectorize. The sum is stored in the
+// last element so that the loop is not optimized away.
+template <class Container>
+struct Reduce
+{
+  void
+  operator() (Container& c, std::size_t size)
+  {
+    const auto *p = c.data ();
+    std::size_t sum = 0;
+    for (std::size_t i = 0; i < size; ++i)
+      sum += p[i].a;
+    c[size - 1].a = sum;
+  }
+};
+
+// Handles `size` requests which each fill a few short-lived vectors. Most of the vectors spill
+// out of their inline storage. The handler provides the vectors and is told when a request ends.
+template <class Handler>
+struct HandleRequests
+{
+  void
+  operator() (Handler& h, std::size_t size)
+  {
+    for (std::size_t request = 0; request < size; ++request)
+    {
+      for (std::size_t i = 0; i < 8; ++i)
+      {
+        auto v = h.make_vector ();
+        for (std::size_t j = 0; j < 4 * (i + 1); ++j)
+          v.push_back ({ j });
+        h.consume (v);
+      }
+      h.end_request ();
+    }
+  }
+};
+
+template <class Container>
+struct IterateNested
+{
+  void
+  operator() (Container& c, std::size_t)
+  {
+    for (auto& inner : c)
+    {
+      for (auto& v : inner)
+        ++(v.a);
+    }
+  }
+};
+
+template <class Container>
+struct MoveNested
+{
+  void
+  operator() (Container& c, std::size_t)
+  {
+    Container moved;
+    moved.reserve (c.size ());
+    for (auto& inner : c)
+      moved.push_back (std::move (inner));
+
+    for (std::size_t i = 0 ; i + 1 < moved.size () ; i += 2)
+      moved[i].swap (moved[i + 1]);
+
+    c.swap (moved);
+  }
+};
+
+template <class Container>
+struct DestroyNested
+{
+  void
+  operator() (Container& c, std::size_t) { c.clear (); }
+};
+
+template <class Container>
+struct CopyNested
+{
+  void
+  operator() (Container& c, std::size_t)
+  {
+    Container copied (c);
+    c.swap (copied);
+  }
+};
+
+// The outer container is not reserved, so the inner containers are moved on each reallocation.
+template <class Container>
+struct ReallocateNested
+{
+  void
+  operator() (Container& c, std::size_t)
+  {
+    Container grown;
+    for (auto& inner : c)
+      grown.push_back (std::move (inner));
+    c.swap (grown);
+  }
+};
+
 template <class Container>
 struct Erase
 {
@@ -0,0 +1,181 @@
+/** aligned_allocator.hpp
+ * An allocator which aligns each allocation to `Alignment`. Paired with
+ * `small_vector_alignment_options`, this lets the elements of a
+ * `small_vector` be loaded with aligned vector instructions whether they
+ * are stored inline or in an allocation.
+ *
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GCH_ALIGNED_ALLOCATOR_HPP
+#define GCH_ALIGNED_ALLOCATOR_HPP
+
+#include "small_vector.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#ifndef GCH_EXCEPTIONS
+#  include <cstdio>
+#endif
+
+#if ! defined (__cpp_aligned_new) && defined (_WIN32)
+#  include <malloc.h>
+#endif
+
+namespace gch
+{
+
+  namespace detail
+  {
+
+    // Allocates `num_bytes` aligned to `alignment` (a power of two, at least `sizeof (void *)`),
+    // or returns a null pointer on failure.
+    inline
+    void *
+    aligned_allocate (std::size_t num_bytes, std::size_t alignment) noexcept
+    {
+#if defined (__cpp_aligned_new)
+      return ::operator new (num_bytes, std::align_val_t (alignment), std::nothrow);
+#elif defined (_WIN32)
+      return ::_aligned_malloc (num_bytes, alignment);
+#else
+      void *p = nullptr;
+      if (::posix_memalign (&p, alignment, num_bytes) != 0)
+        return nullptr;
+      return p;
+#endif
+    }
+
+    inline
+    void
+    aligned_deallocate (void *p, std::size_t alignment) noexcept
+    {
+#if defined (__cpp_aligned_new)
+      ::operator delete (p, std::align_val_t (alignment));
+#elif defined (_WIN32)
+      static_cast<void> (alignment);
+      ::_aligned_free (p);
+#else
+      static_cast<void> (alignment);
+      std::free (p);
+#endif
+    }
+
+  } // namespace gch::detail
+
+  template <typename T, std::size_t Alignment>
+  class aligned_allocator
+  {
+    static_assert (Alignment != 0 && (Alignment & (Alignment - 1)) == 0,
+                   "`Alignment` must be a power of two.");
+
+  public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal                        = std::true_type;
+
+    template <typename U>
+    struct rebind
+    {
+      using other = aligned_allocator<U, Alignment>;
+    };
+
+    // The alignment of every allocation. `small_vector` checks this against the alignment in its
+    // options.
+    static constexpr std::size_t alignment =
+      Alignment < alignof (T)
+        ? alignof (T)
+        : (Alignment < sizeof (void *) ? sizeof (void *) : Alignment);
+
+    aligned_allocator            (void)                         = default;
+    aligned_allocator            (const aligned_allocator&)     = default;
+    aligned_allocator            (aligned_allocator&&) noexcept = default;
+    aligned_allocator& operator= (const aligned_allocator&)     = default;
+    aligned_allocator& operator= (aligned_allocator&&) noexcept = default;
+    ~aligned_allocator           (void)                         = default;
+
+    template <typename U>
+    constexpr
+    aligned_allocator (const aligned_allocator<U, Alignment>&) noexcept
+    { }
+
+    GCH_NODISCARD
+    T *
+    allocate (size_type n)
+    {
+      if (max_size () < n)
+        throw_allocation_error ();
+
+      void *p = detail::aligned_allocate (n * sizeof (T), alignment);
+      if (p == nullptr)
+        throw_allocation_error ();
+
+      return static_cast<T *> (p);
+    }
+
+    void
+    deallocate (T *p, size_type) noexcept
+    {
+      detail::aligned_deallocate (static_cast<void *> (p), alignment);
+    }
+
+    GCH_NODISCARD constexpr
+    size_type
+    max_size (void) const noexcept
+    {
+      return (std::numeric_limits<size_type>::max) () / sizeof (T);
+    }
+
+  private:
+    GCH_NORETURN
+    static
+    void
+    throw_allocation_error (void)
+    {
+#ifdef GCH_EXCEPTIONS
+      throw std::bad_alloc ();
+#else
+      std::fprintf (stderr, "[gch::aligned_allocator] Allocation failed.\n");
+      std::abort ();
+#endif
+    }
+  };
+
+#if ! defined (__cpp_inline_variables) || __cpp_inline_variables < 201606L
+
+  template <typename T, std::size_t Alignment>
+  constexpr std::size_t aligned_allocator<T, Alignment>::alignment;
+
+#endif
+
+  template <typename T, typename U, std::size_t Alignment>
+  constexpr
+  bool
+  operator== (const aligned_allocator<T, Alignment>&,
+              const aligned_allocator<U, Alignment>&) noexcept
+  {
+    return true;
+  }
+
+  template <typename T, typename U, std::size_t Alignment>
+  constexpr
+  bool
+  operator!= (const aligned_allocator<T, Alignment>&,
+              const aligned_allocator<U, Alignment>&) noexcept
+  {
+    return false;
+  }
+
+} // namespace gch
+
+#endif // GCH_ALIGNED_ALLOCATOR_HPP
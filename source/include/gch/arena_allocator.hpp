@@ -0,0 +1,355 @@
+/** arena_allocator.hpp
+ * A monotonic arena and an allocator which allocates from it. Memory is
+ * handed out by bumping a pointer and is only given back all at once,
+ * which suits many short-lived vectors which spill and die together.
+ *
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GCH_ARENA_ALLOCATOR_HPP
+#define GCH_ARENA_ALLOCATOR_HPP
+
+#include "small_vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#ifndef GCH_EXCEPTIONS
+#  include <cstdio>
+#endif
+
+namespace gch
+{
+
+  // Allocates from chunks obtained with `operator new`. Each chunk is twice as large as the last,
+  // so the number of chunks grows logarithmically with the number of bytes allocated. Individual
+  // deallocations are no-ops, except that the most recent allocation may be given back or resized
+  // in place.
+  class arena
+  {
+    struct chunk_header
+    {
+      chunk_header *prev;
+      std::size_t   num_bytes;
+    };
+
+    // The chunk data starts after the header, aligned for any fundamental type.
+    static constexpr std::size_t header_size =
+      (sizeof (chunk_header) + alignof (std::max_align_t) - 1)
+        & ~(alignof (std::max_align_t) - 1);
+
+  public:
+    static constexpr std::size_t default_chunk_size = 4096;
+
+    arena (void) noexcept
+      : arena (default_chunk_size)
+    { }
+
+    // The first chunk is allocated on first use with `initial_chunk_size` bytes.
+    explicit
+    arena (std::size_t initial_chunk_size) noexcept
+      : m_chunk           (nullptr),
+        m_cursor          (nullptr),
+        m_last            (nullptr),
+        m_end             (nullptr),
+        m_next_chunk_size (initial_chunk_size < 64 ? 64 : initial_chunk_size)
+    { }
+
+    arena            (const arena&) = delete;
+    arena& operator= (const arena&) = delete;
+
+    ~arena (void)
+    {
+      free_chunks (m_chunk);
+    }
+
+    // Allocates `num_bytes` aligned to `alignment`, which must be a power of two.
+    GCH_NODISCARD
+    void *
+    allocate (std::size_t num_bytes, std::size_t alignment)
+    {
+      if (! fits (num_bytes, alignment))
+        add_chunk (num_bytes, alignment);
+
+      char *p  = m_cursor + padding (m_cursor, alignment);
+      m_last   = p;
+      m_cursor = p + num_bytes;
+      return static_cast<void *> (p);
+    }
+
+    // Gives back the allocation at `p` if it was the most recent one. Otherwise, its memory is
+    // only reclaimed by `release`.
+    void
+    deallocate (void *p, std::size_t num_bytes) noexcept
+    {
+      if (is_last (p, num_bytes))
+        m_cursor = m_last;
+    }
+
+    // Resizes the most recent allocation at `p` from `num_bytes` to `new_num_bytes` without moving
+    // it. Returns `false` if `p` is not the most recent allocation or there is not enough room left
+    // in its chunk.
+    GCH_NODISCARD
+    bool
+    try_resize (void *p, std::size_t num_bytes, std::size_t new_num_bytes) noexcept
+    {
+      if (! is_last (p, num_bytes) || static_cast<std::size_t> (m_end - m_last) < new_num_bytes)
+        return false;
+
+      m_cursor = m_last + new_num_bytes;
+      return true;
+    }
+
+    // Releases every allocation at once. The most recent chunk is kept for reuse, and the others
+    // are freed. This does not depend on the number of allocations.
+    void
+    release (void) noexcept
+    {
+      if (m_chunk == nullptr)
+        return;
+
+      free_chunks (m_chunk->prev);
+      m_chunk->prev = nullptr;
+
+      m_cursor = chunk_data (m_chunk);
+      m_last   = nullptr;
+    }
+
+    // The number of bytes in the chunks owned by the arena.
+    GCH_NODISCARD
+    std::size_t
+    capacity (void) const noexcept
+    {
+      std::size_t ret = 0;
+      for (const chunk_header *c = m_chunk; c != nullptr; c = c->prev)
+        ret += c->num_bytes;
+      return ret;
+    }
+
+  private:
+    GCH_NODISCARD
+    static
+    char *
+    chunk_data (chunk_header *c) noexcept
+    {
+      return reinterpret_cast<char *> (c) + header_size;
+    }
+
+    // The number of bytes after `p` until an address aligned to `alignment`.
+    GCH_NODISCARD
+    static
+    std::size_t
+    padding (const char *p, std::size_t alignment) noexcept
+    {
+      const std::uintptr_t n = reinterpret_cast<std::uintptr_t> (p);
+      return static_cast<std::size_t> (((n + alignment - 1) & ~(alignment - 1)) - n);
+    }
+
+    // Whether the current chunk has room for `num_bytes` aligned to `alignment`.
+    GCH_NODISCARD
+    bool
+    fits (std::size_t num_bytes, std::size_t alignment) const noexcept
+    {
+      if (m_chunk == nullptr)
+        return false;
+
+      const std::size_t remaining = static_cast<std::size_t> (m_end - m_cursor);
+      const std::size_t pad       = padding (m_cursor, alignment);
+      return pad <= remaining && num_bytes <= remaining - pad;
+    }
+
+    GCH_NODISCARD
+    bool
+    is_last (void *p, std::size_t num_bytes) const noexcept
+    {
+      return p != nullptr && static_cast<char *> (p) == m_last && m_last + num_bytes == m_cursor;
+    }
+
+    void
+    add_chunk (std::size_t num_bytes, std::size_t alignment)
+    {
+      const std::size_t max_bytes = (std::numeric_limits<std::size_t>::max) () / 2 - header_size;
+      if (max_bytes - alignment < num_bytes)
+        throw_allocation_error ();
+
+      std::size_t chunk_size = m_next_chunk_size;
+      while (chunk_size < num_bytes + alignment)
+        chunk_size *= 2;
+
+      void *p = ::operator new (header_size + chunk_size, std::nothrow);
+      if (p == nullptr)
+        throw_allocation_error ();
+
+      chunk_header *c = ::new (p) chunk_header { m_chunk, chunk_size };
+      m_chunk  = c;
+      m_cursor = chunk_data (c);
+      m_last   = nullptr;
+      m_end    = m_cursor + chunk_size;
+
+      if (chunk_size <= max_bytes / 2)
+        m_next_chunk_size = 2 * chunk_size;
+    }
+
+    static
+    void
+    free_chunks (chunk_header *c) noexcept
+    {
+      while (c != nullptr)
+      {
+        chunk_header *prev = c->prev;
+        ::operator delete (static_cast<void *> (c));
+        c = prev;
+      }
+    }
+
+    GCH_NORETURN
+    static
+    void
+    throw_allocation_error (void)
+    {
+#ifdef GCH_EXCEPTIONS
+      throw std::bad_alloc ();
+#else
+      std::fprintf (stderr, "[gch::arena] Allocation failed.\n");
+      std::abort ();
+#endif
+    }
+
+    chunk_header *m_chunk;
+    char         *m_cursor;
+    char         *m_last;
+    char         *m_end;
+    std::size_t   m_next_chunk_size;
+  };
+
+  // Allocates from an `arena`. The allocator propagates with its container, so moving and swapping
+  // `small_vector`s which use different arenas stays O(1). If a vector's allocation is the most
+  // recent one in the arena, it is grown in place through `reallocate`.
+  template <typename T>
+  class arena_allocator
+  {
+  public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::false_type;
+
+    template <typename U>
+    struct rebind
+    {
+      using other = arena_allocator<U>;
+    };
+
+    arena_allocator            (const arena_allocator&)     = default;
+    arena_allocator            (arena_allocator&&) noexcept = default;
+    arena_allocator& operator= (const arena_allocator&)     = default;
+    arena_allocator& operator= (arena_allocator&&) noexcept = default;
+    ~arena_allocator           (void)                       = default;
+
+    constexpr GCH_IMPLICIT_CONVERSION
+    arena_allocator (arena& a) noexcept
+      : m_arena (&a)
+    { }
+
+    template <typename U>
+    constexpr GCH_IMPLICIT_CONVERSION
+    arena_allocator (const arena_allocator<U>& other) noexcept
+      : m_arena (&other.get_arena ())
+    { }
+
+    GCH_NODISCARD
+    T *
+    allocate (size_type n)
+    {
+      if (max_size () < n)
+        throw_allocation_error ();
+      return static_cast<T *> (m_arena->allocate (n * sizeof (T), alignof (T)));
+    }
+
+    void
+    deallocate (T *p, size_type n) noexcept
+    {
+      m_arena->deallocate (static_cast<void *> (p), n * sizeof (T));
+    }
+
+    // Grows the allocation in place if it is the most recent one in the arena. Otherwise, the
+    // bytes are copied to a new allocation.
+    GCH_NODISCARD
+    allocation_result<T *, size_type>
+    reallocate (T *p, size_type n, size_type new_n)
+    {
+      if (max_size () < new_n)
+        throw_allocation_error ();
+
+      if (m_arena->try_resize (static_cast<void *> (p), n * sizeof (T), new_n * sizeof (T)))
+        return { p, new_n };
+
+      T *ret = allocate (new_n);
+      std::memcpy (static_cast<void *> (ret), static_cast<const void *> (p),
+                   (n < new_n ? n : new_n) * sizeof (T));
+      deallocate (p, n);
+      return { ret, new_n };
+    }
+
+    GCH_NODISCARD constexpr
+    size_type
+    max_size (void) const noexcept
+    {
+      return (std::numeric_limits<size_type>::max) () / 2 / sizeof (T);
+    }
+
+    GCH_NODISCARD constexpr
+    arena&
+    get_arena (void) const noexcept
+    {
+      return *m_arena;
+    }
+
+  private:
+    GCH_NORETURN
+    static
+    void
+    throw_allocation_error (void)
+    {
+#ifdef GCH_EXCEPTIONS
+      throw std::bad_alloc ();
+#else
+      std::fprintf (stderr, "[gch::arena_allocator] Allocation failed.\n");
+      std::abort ();
+#endif
+    }
+
+    arena *m_arena;
+  };
+
+  template <typename T, typename U>
+  constexpr
+  bool
+  operator== (const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) noexcept
+  {
+    return &lhs.get_arena () == &rhs.get_arena ();
+  }
+
+  template <typename T, typename U>
+  constexpr
+  bool
+  operator!= (const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) noexcept
+  {
+    return ! (lhs == rhs);
+  }
+
+} // namespace gch
+
+#endif // GCH_ARENA_ALLOCATOR_HPP
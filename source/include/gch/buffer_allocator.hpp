@@ -0,0 +1,289 @@
+/** buffer_allocator.hpp
+ * An allocator adaptor which hands out a buffer provided by the caller
+ * before it allocates. This lets the size of the first-stage storage of
+ * a vector be chosen at runtime, such as with a stack array sized by
+ * the caller or a region of thread-local scratch space.
+ *
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GCH_BUFFER_ALLOCATOR_HPP
+#define GCH_BUFFER_ALLOCATOR_HPP
+
+#include "small_vector.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+
+namespace gch
+{
+
+  // Uninitialized storage for `capacity` objects of type `T`, owned by the caller. It may be used
+  // by one allocation at a time, and must outlive every allocator which refers to it.
+  template <typename T>
+  class external_buffer
+  {
+  public:
+    external_buffer (T *data, std::size_t capacity) noexcept
+      : m_data     (data),
+        m_capacity (capacity),
+        m_in_use   (false)
+    { }
+
+    external_buffer            (const external_buffer&) = delete;
+    external_buffer& operator= (const external_buffer&) = delete;
+
+    ~external_buffer (void)
+    {
+      assert (! m_in_use && "The buffer should not be destroyed while it is in use.");
+    }
+
+    GCH_NODISCARD
+    T *
+    data (void) const noexcept
+    {
+      return m_data;
+    }
+
+    GCH_NODISCARD
+    std::size_t
+    capacity (void) const noexcept
+    {
+      return m_capacity;
+    }
+
+    GCH_NODISCARD
+    bool
+    in_use (void) const noexcept
+    {
+      return m_in_use;
+    }
+
+    // Whether `p` points into the buffer.
+    GCH_NODISCARD
+    bool
+    contains (const T *p) const noexcept
+    {
+      return std::less_equal<const T *> () (m_data, p)
+         &&  std::less<const T *> () (p, m_data + m_capacity);
+    }
+
+    // Returns the buffer if it is not in use and can hold `n` objects, or `nullptr` otherwise.
+    GCH_NODISCARD
+    T *
+    acquire (std::size_t n) noexcept
+    {
+      if (m_in_use || m_capacity < n)
+        return nullptr;
+
+      m_in_use = true;
+      return m_data;
+    }
+
+    // Gives back the buffer if `p` points to it, and returns whether it did.
+    bool
+    release (const T *p) noexcept
+    {
+      if (p != m_data || ! m_in_use)
+        return false;
+
+      m_in_use = false;
+      return true;
+    }
+
+  private:
+    T           *m_data;
+    std::size_t  m_capacity;
+    bool         m_in_use;
+  };
+
+  namespace detail
+  {
+
+    // A distinct address for each `T`, which identifies the element type of an erased buffer.
+    template <typename T>
+    const void *
+    external_buffer_type_id (void) noexcept
+    {
+      static const char id = 0;
+      return &id;
+    }
+
+  } // namespace gch::detail
+
+  // Serves allocations from an `external_buffer` while it is free and large enough, and from
+  // `Allocator` otherwise. The whole buffer is reported as capacity through `allocate_at_least`.
+  //
+  // The allocator propagates on move assignment and swap, so the buffer follows the elements which
+  // are stored in it. It does not propagate on copy assignment, and copies of a vector allocate
+  // from `Allocator`, since the buffer can only be used by one vector at a time.
+  //
+  // Rebinding keeps the buffer, so that rebound copies compare equal to the original. It is only
+  // used by allocators of its own element type.
+  template <typename T, typename Allocator = std::allocator<T>>
+  class buffer_allocator
+  {
+    template <typename, typename>
+    friend class buffer_allocator;
+
+    template <typename U, typename AU, typename V, typename AV>
+    friend
+    bool
+    operator== (const buffer_allocator<U, AU>&, const buffer_allocator<V, AV>&) noexcept;
+
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    static_assert (std::is_same<typename alloc_traits::value_type, T>::value,
+                   "`Allocator` must allocate objects of type `T`.");
+
+    static_assert (std::is_same<typename alloc_traits::pointer, T *>::value,
+                   "`buffer_allocator` requires an allocator which uses raw pointers.");
+
+  public:
+    using value_type             = T;
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using wrapped_allocator_type = Allocator;
+
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::false_type;
+
+    template <typename U>
+    struct rebind
+    {
+      using other = buffer_allocator<U, typename alloc_traits::template rebind_alloc<U>>;
+    };
+
+    buffer_allocator            (void)                        = default;
+    buffer_allocator            (const buffer_allocator&)     = default;
+    buffer_allocator            (buffer_allocator&&) noexcept = default;
+    buffer_allocator& operator= (const buffer_allocator&)     = default;
+    buffer_allocator& operator= (buffer_allocator&&) noexcept = default;
+    ~buffer_allocator           (void)                        = default;
+
+    GCH_IMPLICIT_CONVERSION
+    buffer_allocator (external_buffer<T>& buffer, const Allocator& alloc = Allocator ()) noexcept
+      : m_buffer    (&buffer),
+        m_buffer_id (detail::external_buffer_type_id<T> ()),
+        m_alloc     (alloc)
+    { }
+
+    constexpr explicit
+    buffer_allocator (const Allocator& alloc) noexcept
+      : m_alloc (alloc)
+    { }
+
+    template <typename U, typename OtherAllocator>
+    constexpr
+    buffer_allocator (const buffer_allocator<U, OtherAllocator>& other) noexcept
+      : m_buffer    (other.m_buffer),
+        m_buffer_id (other.m_buffer_id),
+        m_alloc     (other.wrapped_allocator ())
+    { }
+
+    GCH_NODISCARD
+    T *
+    allocate (size_type n)
+    {
+      return allocate_at_least (n).ptr;
+    }
+
+    GCH_NODISCARD
+    allocation_result<T *, size_type>
+    allocate_at_least (size_type n)
+    {
+      if (external_buffer<T> *b = buffer ())
+      {
+        if (T *p = b->acquire (n))
+          return { p, b->capacity () };
+      }
+      return { alloc_traits::allocate (m_alloc, n), n };
+    }
+
+    void
+    deallocate (T *p, size_type n) noexcept
+    {
+      external_buffer<T> *b = buffer ();
+      if (b == nullptr || ! b->release (p))
+        alloc_traits::deallocate (m_alloc, p, n);
+    }
+
+    GCH_NODISCARD
+    size_type
+    max_size (void) const noexcept
+    {
+      return static_cast<size_type> (alloc_traits::max_size (m_alloc));
+    }
+
+    buffer_allocator
+    select_on_container_copy_construction (void) const
+    {
+      return buffer_allocator (alloc_traits::select_on_container_copy_construction (m_alloc));
+    }
+
+    // Whether `p` points into the external buffer. `small_vector` considers elements stored there
+    // to be inlined.
+    GCH_NODISCARD
+    bool
+    is_external_buffer (const T *p) const noexcept
+    {
+      const external_buffer<T> *b = buffer ();
+      return b != nullptr && b->contains (p);
+    }
+
+    // The buffer, or `nullptr` if there is none or it holds objects of another type.
+    GCH_NODISCARD
+    external_buffer<T> *
+    buffer (void) const noexcept
+    {
+      if (m_buffer_id != detail::external_buffer_type_id<T> ())
+        return nullptr;
+      return static_cast<external_buffer<T> *> (m_buffer);
+    }
+
+    GCH_NODISCARD constexpr
+    const Allocator&
+    wrapped_allocator (void) const noexcept
+    {
+      return m_alloc;
+    }
+
+  private:
+    // The buffer is erased so that it can be carried across rebinding. `m_buffer_id` identifies
+    // its element type.
+    void       *m_buffer    = nullptr;
+    const void *m_buffer_id = nullptr;
+    Allocator   m_alloc;
+  };
+
+  template <typename T, typename AT, typename U, typename AU>
+  bool
+  operator== (const buffer_allocator<T, AT>& lhs, const buffer_allocator<U, AU>& rhs) noexcept
+  {
+    return lhs.m_buffer == rhs.m_buffer
+       &&  lhs.wrapped_allocator () == rhs.wrapped_allocator ();
+  }
+
+  template <typename T, typename AT, typename U, typename AU>
+  bool
+  operator!= (const buffer_allocator<T, AT>& lhs, const buffer_allocator<U, AU>& rhs) noexcept
+  {
+    return ! (lhs == rhs);
+  }
+
+  // A `small_vector` which stores up to `InlineCapacity` elements inline, then uses an
+  // `external_buffer` given to its constructor, and then allocates with `Allocator`.
+  template <typename T, unsigned InlineCapacity = 0, typename Allocator = std::allocator<T>>
+  using buffer_vector = small_vector<T, InlineCapacity, buffer_allocator<T, Allocator>>;
+
+} // namespace gch
+
+#endif // GCH_BUFFER_ALLOCATOR_HPP
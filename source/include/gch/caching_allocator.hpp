@@ -0,0 +1,334 @@
+/** caching_allocator.hpp
+ * An allocator which keeps freed blocks in per-thread free lists,
+ * bucketed by power-of-two size classes. Vectors which are created
+ * and destroyed at a high rate can then reuse their buffers without
+ * going through `operator new`, or contending on the heap's locks.
+ *
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GCH_CACHING_ALLOCATOR_HPP
+#define GCH_CACHING_ALLOCATOR_HPP
+
+#include "small_vector.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#ifndef GCH_EXCEPTIONS
+#  include <cstdio>
+#endif
+
+namespace gch
+{
+
+  namespace detail
+  {
+
+    // The free lists of a single thread. There is one list for each size class, which are the
+    // powers of two from `min_block_size` to `max_block_size` bytes. Blocks are obtained from
+    // `operator new`, so a block may be freed into the cache of any thread, not only the thread
+    // which allocated it. Each list holds at most `max_cached_bytes` bytes, and any blocks past
+    // that are freed with `operator delete`.
+    class thread_block_cache
+    {
+      struct free_block
+      {
+        free_block *next;
+      };
+
+      struct free_list
+      {
+        free_block  *head;
+        std::size_t  count;
+      };
+
+    public:
+      static constexpr std::size_t min_block_size   = 16;
+      static constexpr std::size_t max_block_size   = std::size_t { 1 } << 16;
+      static constexpr std::size_t num_size_classes = 13;
+      static constexpr std::size_t max_cached_bytes = std::size_t { 1 } << 18;
+
+      static_assert ((min_block_size << (num_size_classes - 1)) == max_block_size,
+                     "The size classes should span [min_block_size, max_block_size].");
+
+      static_assert (sizeof (free_block) <= min_block_size,
+                     "The smallest blocks should be able to hold a list node.");
+
+      thread_block_cache (void) noexcept
+        : m_lists ()
+      { }
+
+      thread_block_cache            (const thread_block_cache&) = delete;
+      thread_block_cache& operator= (const thread_block_cache&) = delete;
+
+      ~thread_block_cache (void)
+      {
+        trim ();
+        is_destroyed () = true;
+      }
+
+      // Returns the cache of the calling thread, or `nullptr` if the thread is exiting and its
+      // cache has already been destroyed.
+      GCH_NODISCARD
+      static
+      thread_block_cache *
+      local (void) noexcept
+      {
+        if (is_destroyed ())
+          return nullptr;
+
+        static thread_local thread_block_cache cache;
+        return &cache;
+      }
+
+      // The index of the smallest size class which holds `num_bytes`.
+      // Precondition: num_bytes <= max_block_size
+      GCH_NODISCARD
+      static
+      std::size_t
+      size_class (std::size_t num_bytes) noexcept
+      {
+        std::size_t index = 0;
+        while ((min_block_size << index) < num_bytes)
+          ++index;
+        return index;
+      }
+
+      GCH_NODISCARD
+      static constexpr
+      std::size_t
+      block_size (std::size_t index) noexcept
+      {
+        return min_block_size << index;
+      }
+
+      // Allocates a block of the size class at `index`, or returns `nullptr` on failure.
+      GCH_NODISCARD
+      void *
+      allocate (std::size_t index) noexcept
+      {
+        free_list& list = m_lists[index];
+        if (list.head == nullptr)
+          return ::operator new (block_size (index), std::nothrow);
+
+        free_block *block = list.head;
+        list.head = block->next;
+        --list.count;
+        return static_cast<void *> (block);
+      }
+
+      void
+      deallocate (void *p, std::size_t index) noexcept
+      {
+        free_list& list = m_lists[index];
+        if (max_cached_bytes / block_size (index) <= list.count)
+          return ::operator delete (p);
+
+        list.head = ::new (p) free_block { list.head };
+        ++list.count;
+      }
+
+      // Frees every cached block.
+      void
+      trim (void) noexcept
+      {
+        for (free_list& list : m_lists)
+        {
+          while (list.head != nullptr)
+          {
+            free_block *next = list.head->next;
+            ::operator delete (static_cast<void *> (list.head));
+            list.head = next;
+          }
+          list.count = 0;
+        }
+      }
+
+      // The number of bytes held in the free lists.
+      GCH_NODISCARD
+      std::size_t
+      cached_bytes (void) const noexcept
+      {
+        std::size_t ret = 0;
+        for (std::size_t i = 0; i < num_size_classes; ++i)
+          ret += m_lists[i].count * block_size (i);
+        return ret;
+      }
+
+    private:
+      // This is trivially destructible, so it can still be read after the cache is destroyed
+      // during thread exit.
+      GCH_NODISCARD
+      static
+      bool&
+      is_destroyed (void) noexcept
+      {
+        static thread_local bool destroyed = false;
+        return destroyed;
+      }
+
+      free_list m_lists[num_size_classes];
+    };
+
+  } // namespace gch::detail
+
+  // Allocates buffers of up to 64 KiB from per-thread caches of power-of-two blocks. Requests are
+  // rounded up to the next block size, and the extra space is reported through
+  // `allocate_at_least`. With the default doubling growth policy, a vector then only ever asks
+  // for whole blocks, so buffers freed by one vector are a match for the next. Larger buffers are
+  // allocated with `operator new` directly.
+  //
+  // Each thread caches at most 256 KiB per block size. A buffer may be freed on a different thread
+  // than the one which allocated it, in which case it goes to the cache of the freeing thread.
+  template <typename T>
+  class caching_allocator
+  {
+    using cache_type = detail::thread_block_cache;
+
+  public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal                        = std::true_type;
+
+    template <typename U>
+    struct rebind
+    {
+      using other = caching_allocator<U>;
+    };
+
+    static_assert (alignof (T) <= alignof (std::max_align_t),
+                   "`caching_allocator` does not support over-aligned types.");
+
+    caching_allocator            (void)                         = default;
+    caching_allocator            (const caching_allocator&)     = default;
+    caching_allocator            (caching_allocator&&) noexcept = default;
+    caching_allocator& operator= (const caching_allocator&)     = default;
+    caching_allocator& operator= (caching_allocator&&) noexcept = default;
+    ~caching_allocator           (void)                         = default;
+
+    template <typename U>
+    constexpr
+    caching_allocator (const caching_allocator<U>&) noexcept
+    { }
+
+    GCH_NODISCARD
+    T *
+    allocate (size_type n)
+    {
+      return allocate_at_least (n).ptr;
+    }
+
+    GCH_NODISCARD
+    allocation_result<T *, size_type>
+    allocate_at_least (size_type n)
+    {
+      if (max_size () < n)
+        throw_allocation_error ();
+
+      const std::size_t num_bytes = n * sizeof (T);
+      if (cache_type::max_block_size < num_bytes)
+        return { static_cast<T *> (new_block (num_bytes)), n };
+
+      const std::size_t index = cache_type::size_class (num_bytes);
+      cache_type *cache = cache_type::local ();
+      void *p = (cache == nullptr) ? new_block (cache_type::block_size (index))
+                                   : cache->allocate (index);
+      if (p == nullptr)
+        throw_allocation_error ();
+
+      return { static_cast<T *> (p), cache_type::block_size (index) / sizeof (T) };
+    }
+
+    // `n` may be either the number of elements requested or the number returned by
+    // `allocate_at_least`, since both round up to the same block size.
+    void
+    deallocate (T *p, size_type n) noexcept
+    {
+      const std::size_t num_bytes = n * sizeof (T);
+      cache_type *cache = cache_type::local ();
+      if (cache_type::max_block_size < num_bytes || cache == nullptr)
+        return ::operator delete (static_cast<void *> (p));
+
+      cache->deallocate (static_cast<void *> (p), cache_type::size_class (num_bytes));
+    }
+
+    // No object may be larger than the range of `difference_type`.
+    GCH_NODISCARD constexpr
+    size_type
+    max_size (void) const noexcept
+    {
+      return static_cast<size_type> ((std::numeric_limits<difference_type>::max) ()) / sizeof (T);
+    }
+
+    // Frees the blocks cached by the calling thread. The cache is shared by every
+    // `caching_allocator`, regardless of `T`.
+    static
+    void
+    trim (void) noexcept
+    {
+      if (cache_type *cache = cache_type::local ())
+        cache->trim ();
+    }
+
+    // The number of bytes cached by the calling thread.
+    GCH_NODISCARD
+    static
+    std::size_t
+    cached_bytes (void) noexcept
+    {
+      const cache_type *cache = cache_type::local ();
+      return (cache == nullptr) ? 0 : cache->cached_bytes ();
+    }
+
+  private:
+    GCH_NODISCARD
+    static
+    void *
+    new_block (std::size_t num_bytes) noexcept
+    {
+      return ::operator new (num_bytes, std::nothrow);
+    }
+
+    GCH_NORETURN
+    static
+    void
+    throw_allocation_error (void)
+    {
+#ifdef GCH_EXCEPTIONS
+      throw std::bad_alloc ();
+#else
+      std::fprintf (stderr, "[gch::caching_allocator] Allocation failed.\n");
+      std::abort ();
+#endif
+    }
+  };
+
+  template <typename T, typename U>
+  constexpr
+  bool
+  operator== (const caching_allocator<T>&, const caching_allocator<U>&) noexcept
+  {
+    return true;
+  }
+
+  template <typename T, typename U>
+  constexpr
+  bool
+  operator!= (const caching_allocator<T>&, const caching_allocator<U>&) noexcept
+  {
+    return false;
+  }
+
+} // namespace gch
+
+#endif // GCH_CACHING_ALLOCATOR_HPP
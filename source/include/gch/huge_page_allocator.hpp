@@ -0,0 +1,245 @@
+/** huge_page_allocator.hpp
+ * An allocator adaptor which backs large allocations with transparent
+ * huge pages. Allocations of at least `ThresholdBytes` are mapped with
+ * `mmap`, aligned to 2 MiB, and advised with `madvise (MADV_HUGEPAGE)`
+ * where it is available. Smaller allocations are forwarded to the
+ * wrapped allocator.
+ *
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GCH_HUGE_PAGE_ALLOCATOR_HPP
+#define GCH_HUGE_PAGE_ALLOCATOR_HPP
+
+#include "mmap_allocator.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#ifndef GCH_EXCEPTIONS
+#  include <cstdio>
+#endif
+
+namespace gch
+{
+
+  namespace detail
+  {
+
+    // The size of a transparent huge page on x86-64 and most AArch64 configurations.
+    constexpr std::size_t huge_page_size = std::size_t (2) * 1024 * 1024;
+
+    // Rounds `num_bytes` up to a whole number of huge pages.
+    constexpr
+    std::size_t
+    huge_page_ceil (std::size_t num_bytes) noexcept
+    {
+      return ((num_bytes + huge_page_size - 1) / huge_page_size) * huge_page_size;
+    }
+
+    // Maps `num_bytes` (a multiple of `huge_page_size`) aligned to `huge_page_size`, or returns a
+    // null pointer on failure. We map an extra huge page, then unmap the misaligned ends.
+    inline
+    void *
+    map_huge_pages (std::size_t num_bytes) noexcept
+    {
+      void *p = map_pages (num_bytes + huge_page_size);
+      if (p == nullptr)
+        return nullptr;
+
+      const std::uintptr_t first   = reinterpret_cast<std::uintptr_t> (p);
+      const std::uintptr_t aligned = (first + huge_page_size - 1) & ~(huge_page_size - 1);
+      const std::size_t    head    = static_cast<std::size_t> (aligned - first);
+
+      char *result = static_cast<char *> (p) + head;
+      if (head != 0)
+        unmap_pages (p, head);
+      if (head != huge_page_size)
+        unmap_pages (result + num_bytes, huge_page_size - head);
+
+#ifdef MADV_HUGEPAGE
+      // This is only advice, so failure is not an error.
+      static_cast<void> (::madvise (static_cast<void *> (result), num_bytes, MADV_HUGEPAGE));
+#endif
+
+      return static_cast<void *> (result);
+    }
+
+  } // namespace gch::detail
+
+  // Allocations which are rounded up to huge pages are reported through `allocate_at_least`. Since
+  // whether an allocation is huge depends only on its size, `deallocate` can tell which allocator
+  // an allocation came from.
+  template <typename T,
+            typename Allocator = std::allocator<T>,
+            std::size_t ThresholdBytes = detail::huge_page_size>
+  class huge_page_allocator
+  {
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    static_assert (std::is_same<typename alloc_traits::value_type, T>::value,
+                   "`Allocator` must allocate objects of type `T`.");
+
+    static_assert (std::is_same<typename alloc_traits::pointer, T *>::value,
+                   "`huge_page_allocator` requires an allocator which uses raw pointers.");
+
+    static_assert (0 < ThresholdBytes, "`ThresholdBytes` must be non-zero.");
+
+  public:
+    using value_type             = T;
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using wrapped_allocator_type = Allocator;
+
+    using propagate_on_container_copy_assignment =
+      typename alloc_traits::propagate_on_container_copy_assignment;
+
+    using propagate_on_container_move_assignment =
+      typename alloc_traits::propagate_on_container_move_assignment;
+
+    using propagate_on_container_swap = typename alloc_traits::propagate_on_container_swap;
+
+#ifdef GCH_LIB_IS_ALWAYS_EQUAL
+    using is_always_equal = typename alloc_traits::is_always_equal;
+#else
+    using is_always_equal = typename std::is_empty<Allocator>::type;
+#endif
+
+    template <typename U>
+    struct rebind
+    {
+      using other = huge_page_allocator<U, typename alloc_traits::template rebind_alloc<U>,
+                                        ThresholdBytes>;
+    };
+
+    huge_page_allocator            (void)                           = default;
+    huge_page_allocator            (const huge_page_allocator&)     = default;
+    huge_page_allocator            (huge_page_allocator&&) noexcept = default;
+    huge_page_allocator& operator= (const huge_page_allocator&)     = default;
+    huge_page_allocator& operator= (huge_page_allocator&&) noexcept = default;
+    ~huge_page_allocator           (void)                           = default;
+
+    constexpr explicit
+    huge_page_allocator (const Allocator& alloc) noexcept
+      : m_alloc (alloc)
+    { }
+
+    template <typename U, typename OtherAllocator>
+    constexpr
+    huge_page_allocator (
+      const huge_page_allocator<U, OtherAllocator, ThresholdBytes>& other) noexcept
+      : m_alloc (other.wrapped_allocator ())
+    { }
+
+    GCH_NODISCARD
+    T *
+    allocate (size_type n)
+    {
+      return allocate_at_least (n).ptr;
+    }
+
+    GCH_NODISCARD
+    allocation_result<T *, size_type>
+    allocate_at_least (size_type n)
+    {
+      if (! is_huge (n))
+        return { alloc_traits::allocate (m_alloc, n), n };
+
+      if (max_size () < n)
+        throw_allocation_error ();
+
+      const std::size_t num_bytes = detail::huge_page_ceil (n * sizeof (T));
+      void *p = detail::map_huge_pages (num_bytes);
+      if (p == nullptr)
+        throw_allocation_error ();
+
+      return { static_cast<T *> (p), num_bytes / sizeof (T) };
+    }
+
+    void
+    deallocate (T *p, size_type n) noexcept
+    {
+      if (is_huge (n))
+        detail::unmap_pages (static_cast<void *> (p), detail::huge_page_ceil (n * sizeof (T)));
+      else
+        alloc_traits::deallocate (m_alloc, p, n);
+    }
+
+    GCH_NODISCARD
+    size_type
+    max_size (void) const noexcept
+    {
+      const size_type wrapped_max = static_cast<size_type> (alloc_traits::max_size (m_alloc));
+      const size_type mapped_max  =
+        static_cast<size_type> ((std::numeric_limits<std::ptrdiff_t>::max) ()) / sizeof (T);
+      return wrapped_max < mapped_max ? wrapped_max : mapped_max;
+    }
+
+    huge_page_allocator
+    select_on_container_copy_construction (void) const
+    {
+      return huge_page_allocator (alloc_traits::select_on_container_copy_construction (m_alloc));
+    }
+
+    GCH_NODISCARD constexpr
+    const Allocator&
+    wrapped_allocator (void) const noexcept
+    {
+      return m_alloc;
+    }
+
+    // Whether an allocation of `n` elements is backed by huge pages.
+    GCH_NODISCARD
+    static constexpr
+    bool
+    is_huge (size_type n) noexcept
+    {
+      return n != 0 && (ThresholdBytes + sizeof (T) - 1) / sizeof (T) <= n;
+    }
+
+  private:
+    GCH_NORETURN
+    static
+    void
+    throw_allocation_error (void)
+    {
+#ifdef GCH_EXCEPTIONS
+      throw std::bad_alloc ();
+#else
+      std::fprintf (stderr, "[gch::huge_page_allocator] Allocation failed.\n");
+      std::abort ();
+#endif
+    }
+
+    Allocator m_alloc;
+  };
+
+  template <typename T, typename A, typename U, typename B, std::size_t ThresholdBytes>
+  constexpr
+  bool
+  operator== (const huge_page_allocator<T, A, ThresholdBytes>& lhs,
+              const huge_page_allocator<U, B, ThresholdBytes>& rhs) noexcept
+  {
+    return lhs.wrapped_allocator () == rhs.wrapped_allocator ();
+  }
+
+  template <typename T, typename A, typename U, typename B, std::size_t ThresholdBytes>
+  constexpr
+  bool
+  operator!= (const huge_page_allocator<T, A, ThresholdBytes>& lhs,
+              const huge_page_allocator<U, B, ThresholdBytes>& rhs) noexcept
+  {
+    return ! (lhs == rhs);
+  }
+
+} // namespace gch
+
+#endif // GCH_HUGE_PAGE_ALLOCATOR_HPP
@@ -0,0 +1,234 @@
+/** mmap_allocator.hpp
+ * An allocator which maps each allocation directly from the operating
+ * system with `mmap`. It defines `reallocate`, which `small_vector` uses
+ * to grow allocations of trivially relocatable elements. On Linux, this
+ * is `mremap`, which moves the pages of the allocation instead of
+ * copying them.
+ *
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GCH_MMAP_ALLOCATOR_HPP
+#define GCH_MMAP_ALLOCATOR_HPP
+
+#include "small_vector.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#ifndef GCH_EXCEPTIONS
+#  include <cstdio>
+#endif
+
+#if defined (_WIN32)
+#  error "`gch::mmap_allocator` requires `mmap`."
+#endif
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if defined (__linux__) && defined (MREMAP_MAYMOVE)
+#  ifndef GCH_HAS_MREMAP
+#    define GCH_HAS_MREMAP
+#  endif
+#endif
+
+#if ! defined (MAP_ANONYMOUS) && defined (MAP_ANON)
+#  define GCH_MAP_ANONYMOUS MAP_ANON
+#else
+#  define GCH_MAP_ANONYMOUS MAP_ANONYMOUS
+#endif
+
+namespace gch
+{
+
+  namespace detail
+  {
+
+    inline
+    std::size_t
+    page_size (void) noexcept
+    {
+      static const std::size_t size = static_cast<std::size_t> (::sysconf (_SC_PAGESIZE));
+      return size;
+    }
+
+    // Rounds `num_bytes` up to a whole number of pages.
+    inline
+    std::size_t
+    page_ceil (std::size_t num_bytes) noexcept
+    {
+      const std::size_t size = page_size ();
+      return ((num_bytes + size - 1) / size) * size;
+    }
+
+    // Maps `num_bytes` of zero-filled memory, or returns a null pointer on failure.
+    inline
+    void *
+    map_pages (std::size_t num_bytes) noexcept
+    {
+      void *p = ::mmap (nullptr, num_bytes, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | GCH_MAP_ANONYMOUS, -1, 0);
+      return p == MAP_FAILED ? nullptr : p;
+    }
+
+    inline
+    void
+    unmap_pages (void *p, std::size_t num_bytes) noexcept
+    {
+      ::munmap (p, num_bytes);
+    }
+
+  } // namespace gch::detail
+
+  // Every allocation is rounded up to a whole number of pages, so this is only suitable for large
+  // buffers. The extra space is reported through `allocate_at_least`.
+  template <typename T>
+  class mmap_allocator
+  {
+  public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal                        = std::true_type;
+
+    template <typename U>
+    struct rebind
+    {
+      using other = mmap_allocator<U>;
+    };
+
+    mmap_allocator            (void)                      = default;
+    mmap_allocator            (const mmap_allocator&)     = default;
+    mmap_allocator            (mmap_allocator&&) noexcept = default;
+    mmap_allocator& operator= (const mmap_allocator&)     = default;
+    mmap_allocator& operator= (mmap_allocator&&) noexcept = default;
+    ~mmap_allocator           (void)                      = default;
+
+    template <typename U>
+    constexpr
+    mmap_allocator (const mmap_allocator<U>&) noexcept
+    { }
+
+    GCH_NODISCARD
+    T *
+    allocate (size_type n)
+    {
+      return allocate_at_least (n).ptr;
+    }
+
+    GCH_NODISCARD
+    allocation_result<T *, size_type>
+    allocate_at_least (size_type n)
+    {
+      if (max_size () < n)
+        throw_allocation_error ();
+
+      if (n == 0)
+        return { nullptr, 0 };
+
+      const std::size_t num_bytes = detail::page_ceil (n * sizeof (T));
+      void *p = detail::map_pages (num_bytes);
+      if (p == nullptr)
+        throw_allocation_error ();
+
+      return { static_cast<T *> (p), num_bytes / sizeof (T) };
+    }
+
+    // Anonymous mappings are always zero-filled, and their pages are only touched when written.
+    GCH_NODISCARD
+    T *
+    allocate_zeroed (size_type n)
+    {
+      return allocate (n);
+    }
+
+    // Resizes the mapping at `p`, which may be moved to a new address. The contents are kept.
+    GCH_NODISCARD
+    allocation_result<T *, size_type>
+    reallocate (T *p, size_type old_n, size_type new_n)
+    {
+      if (p == nullptr)
+        return allocate_at_least (new_n);
+
+      if (max_size () < new_n)
+        throw_allocation_error ();
+
+      const std::size_t old_num_bytes = detail::page_ceil (old_n * sizeof (T));
+      const std::size_t new_num_bytes = detail::page_ceil (new_n * sizeof (T));
+      if (new_num_bytes == old_num_bytes)
+        return { p, old_num_bytes / sizeof (T) };
+
+#ifdef GCH_HAS_MREMAP
+      void *new_p = ::mremap (p, old_num_bytes, new_num_bytes, MREMAP_MAYMOVE);
+      if (new_p == MAP_FAILED)
+        throw_allocation_error ();
+      return { static_cast<T *> (new_p), new_num_bytes / sizeof (T) };
+#else
+      const allocation_result<T *, size_type> result = allocate_at_least (new_n);
+      std::memcpy (static_cast<void *> (result.ptr), static_cast<const void *> (p),
+                   (old_num_bytes < new_num_bytes) ? old_num_bytes : new_num_bytes);
+      deallocate (p, old_n);
+      return result;
+#endif
+    }
+
+    void
+    deallocate (T *p, size_type n) noexcept
+    {
+      if (p != nullptr)
+        detail::unmap_pages (static_cast<void *> (p), detail::page_ceil (n * sizeof (T)));
+    }
+
+    GCH_NODISCARD constexpr
+    size_type
+    max_size (void) const noexcept
+    {
+      return (std::numeric_limits<std::ptrdiff_t>::max) () / sizeof (T);
+    }
+
+  private:
+    GCH_NORETURN
+    static
+    void
+    throw_allocation_error (void)
+    {
+#ifdef GCH_EXCEPTIONS
+      throw std::bad_alloc ();
+#else
+      std::fprintf (stderr, "[gch::mmap_allocator] Allocation failed.\n");
+      std::abort ();
+#endif
+    }
+  };
+
+  template <typename T, typename U>
+  constexpr
+  bool
+  operator== (const mmap_allocator<T>&, const mmap_allocator<U>&) noexcept
+  {
+    return true;
+  }
+
+  template <typename T, typename U>
+  constexpr
+  bool
+  operator!= (const mmap_allocator<T>&, const mmap_allocator<U>&) noexcept
+  {
+    return false;
+  }
+
+} // namespace gch
+
+#undef GCH_MAP_ANONYMOUS
+
+#endif // GCH_MMAP_ALLOCATOR_HPP
@@ -223,6 +223,12 @@
 #  include <vector>
 #endif
 
+#if defined (__cplusplus) && __cplusplus >= 201703L
+#  if defined (__has_include) && __has_include (<memory_resource>)
+#    include <memory_resource>
+#  endif
+#endif
+
 #ifdef GCH_EXCEPTIONS
 #  include <stdexcept>
 #else
@@ -280,6 +286,24 @@
 #  endif
 #endif
 
+#if defined (__cpp_lib_allocate_at_least) && __cpp_lib_allocate_at_least >= 202302L
+#  ifndef GCH_LIB_ALLOCATE_AT_LEAST
+#    define GCH_LIB_ALLOCATE_AT_LEAST
+#  endif
+#endif
+
+#if defined (__cpp_lib_memory_resource) && __cpp_lib_memory_resource >= 201603L
+#  ifndef GCH_LIB_MEMORY_RESOURCE
+#    define GCH_LIB_MEMORY_RESOURCE
+#  endif
+#endif
+
+#if defined (__has_builtin) && __has_builtin (__is_trivially_relocatable)
+#  ifndef GCH_HAS_BUILTIN_IS_TRIVIALLY_RELOCATABLE
+#    define GCH_HAS_BUILTIN_IS_TRIVIALLY_RELOCATABLE
+#  endif
+#endif
+
 // TODO:
 //   Make sure we don't need any laundering in the internal class functions.
 //   I also need some sort of test case to actually show where UB is occurring,
@@ -307,6 +331,12 @@
 #  define GCH_SMALL_VECTOR_DEFAULT_SIZE 64
 #endif
 
+// The largest inline storage (in bytes) which is copied as a single block when its elements are
+// trivially copyable.
+#ifndef GCH_SMALL_VECTOR_MAX_BLOCK_COPY_SIZE
+#  define GCH_SMALL_VECTOR_MAX_BLOCK_COPY_SIZE 64
+#endif
+
 namespace gch
 {
 
@@ -734,7 +764,359 @@ namespace gch
 
 #endif
 
-  template <typename Allocator>
+  // A customization point for types which may be relocated by copying their bytes. That is, moving
+  // an object to a new address and destroying the original must be equivalent to `std::memcpy`.
+  // `small_vector` uses this to relocate elements in bulk when reallocating, inserting, and
+  // erasing. Specialize this to opt in your own types.
+  template <typename T>
+  struct is_trivially_relocatable
+    : std::integral_constant<bool, std::is_trivially_copyable<T>::value
+#ifdef GCH_HAS_BUILTIN_IS_TRIVIALLY_RELOCATABLE
+                               ||  __is_trivially_relocatable (T)
+#endif
+                             >
+  { };
+
+  // These are trivially relocatable in every major implementation of the standard library.
+  template <typename T>
+  struct is_trivially_relocatable<std::unique_ptr<T, std::default_delete<T>>>
+    : std::true_type
+  { };
+
+  template <typename T>
+  struct is_trivially_relocatable<std::shared_ptr<T>>
+    : std::true_type
+  { };
+
+  template <typename T>
+  struct is_trivially_relocatable<std::weak_ptr<T>>
+    : std::true_type
+  { };
+
+  // A customization point for types whose move constructors may throw, but which `small_vector`
+  // should always move when reallocating. This is the same as using
+  // `small_vector_exception_guarantee::basic` for every vector of `T`. Specialize this to opt in
+  // your own types.
+  template <typename T>
+  struct always_relocate_with_move
+    : std::false_type
+  { };
+
+  // Whether a value-initialized `T` is represented by all zero bytes. If so, value-initialized
+  // elements may be left as memory from an allocator's `allocate_zeroed`. Specialize this for your
+  // own types if they are trivially default constructible and zero-initialized by `T ()`.
+  template <typename T>
+  struct is_zero_initializable
+    : std::integral_constant<bool, std::is_arithmetic<T>::value
+                               ||  std::is_enum<T>::value
+                               ||  std::is_pointer<T>::value>
+  { };
+
+  namespace small_vector_growth
+  {
+
+    // Growth policies are used to choose the new capacity whenever a `small_vector` needs to
+    // reallocate. They are required to provide a function with the signature
+    //
+    //   template <typename T, typename SizeType>
+    //   static SizeType
+    //   calculate_new_capacity (SizeType current, SizeType required, SizeType maximum) noexcept;
+    //
+    // which will only be called when `current < required && required <= maximum`. The result
+    // must be in the range `[required, maximum]`.
+
+    struct doubling
+    {
+      template <typename T, typename SizeType>
+      GCH_NODISCARD
+      static GCH_CPP14_CONSTEXPR
+      SizeType
+      calculate_new_capacity (SizeType current, SizeType required, SizeType maximum) noexcept
+      {
+        if (maximum - current <= current)
+          return maximum;
+
+        const SizeType new_capacity = static_cast<SizeType> (2 * current);
+        if (new_capacity < required)
+          return required;
+        return new_capacity;
+      }
+    };
+
+    struct one_and_a_half
+    {
+      template <typename T, typename SizeType>
+      GCH_NODISCARD
+      static GCH_CPP14_CONSTEXPR
+      SizeType
+      calculate_new_capacity (SizeType current, SizeType required, SizeType maximum) noexcept
+      {
+        if (maximum - current <= current / 2)
+          return maximum;
+
+        const SizeType new_capacity = static_cast<SizeType> (current + (current / 2));
+        if (new_capacity < required)
+          return required;
+        return new_capacity;
+      }
+    };
+
+    struct exact
+    {
+      template <typename T, typename SizeType>
+      GCH_NODISCARD
+      static GCH_CPP14_CONSTEXPR
+      SizeType
+      calculate_new_capacity (SizeType, SizeType required, SizeType) noexcept
+      {
+        return required;
+      }
+    };
+
+    // Doubles until the allocation reaches `ChunkBytes`, then grows by `ChunkBytes` at a time.
+    template <std::size_t ChunkBytes>
+    struct chunked
+    {
+      static_assert (0 < ChunkBytes, "`ChunkBytes` must be non-zero.");
+
+      template <typename T, typename SizeType>
+      GCH_NODISCARD
+      static GCH_CPP14_CONSTEXPR
+      SizeType
+      calculate_new_capacity (SizeType current, SizeType required, SizeType maximum) noexcept
+      {
+        constexpr std::size_t chunk_size = (sizeof (T) < ChunkBytes) ? ChunkBytes / sizeof (T) : 1;
+
+        if (static_cast<std::size_t> (current) < chunk_size)
+          return doubling::calculate_new_capacity<T> (current, required, maximum);
+
+        if (static_cast<std::size_t> (maximum - current) <= chunk_size)
+          return maximum;
+
+        const SizeType new_capacity = static_cast<SizeType> (current + chunk_size);
+        if (new_capacity < required)
+          return required;
+        return new_capacity;
+      }
+    };
+
+  } // namespace gch::small_vector_growth
+
+  namespace small_vector_shrink
+  {
+
+    // Shrink policies decide whether a `small_vector` gives memory back after `erase`,
+    // `pop_back`, or `clear`. They are required to provide a function with the signature
+    //
+    //   template <typename T, typename SizeType>
+    //   static SizeType
+    //   calculate_shrunk_capacity (SizeType size, SizeType capacity) noexcept;
+    //
+    // which returns `capacity` to keep the allocation, or a new capacity in `[size, capacity)`.
+    // If the new capacity fits in the inline storage, the elements are moved back inline.
+
+    // Never shrinks automatically. Memory is only given back by `shrink_to_fit` and `reset`.
+    struct never
+    {
+      template <typename T, typename SizeType>
+      GCH_NODISCARD
+      static constexpr
+      SizeType
+      calculate_shrunk_capacity (SizeType, SizeType capacity) noexcept
+      {
+        return capacity;
+      }
+    };
+
+    // Shrinks to `Multiplier` times the size once the size falls below `1 / Divisor` of the
+    // capacity. Since `Multiplier < Divisor`, the size has to change by a constant fraction of
+    // the capacity between reallocations, so growth and shrinking stay amortized O(1).
+    template <unsigned Divisor = 4, unsigned Multiplier = 2>
+    struct hysteresis
+    {
+      static_assert (0 < Multiplier && Multiplier < Divisor,
+                     "`Multiplier` must be in the range [1, Divisor).");
+
+      template <typename T, typename SizeType>
+      GCH_NODISCARD
+      static constexpr
+      SizeType
+      calculate_shrunk_capacity (SizeType size, SizeType capacity) noexcept
+      {
+        return size < capacity / Divisor ? static_cast<SizeType> (size * Multiplier) : capacity;
+      }
+    };
+
+  } // namespace gch::small_vector_shrink
+
+  namespace small_vector_layout
+  {
+
+    // Layouts decide how the data pointer, capacity, and size are stored next to the inline
+    // storage. They are only tags; the implementations live in `gch::detail`.
+
+    // The data pointer, capacity, and size are always stored separately from the inline storage.
+    struct standard
+    { };
+
+    // The allocation pointer and capacity share space with the inline storage, and the highest bit
+    // of the size records whether the elements are stored inline. This makes the vector smaller,
+    // at the cost of a branch in `data ()`. The allocator must use raw pointers.
+    //
+    // Note: This has no effect when the inline capacity is 0.
+    struct compact
+    { };
+
+    // The capacity and size are stored in a header in front of the elements of the allocation,
+    // so a vector without an allocation is just a null pointer. This makes empty vectors much
+    // smaller, at the cost of an extra indirection in `size ()` and `capacity ()`. The allocator
+    // must use raw pointers, and the inline capacity must be 0.
+    //
+    // Note: This cannot be used in constant expressions.
+    struct heap_header
+    { };
+
+  } // namespace gch::small_vector_layout
+
+  namespace small_vector_exception_guarantee
+  {
+
+    // Exception guarantees decide how elements are relocated to a new allocation when their move
+    // constructor may throw.
+
+    // Elements are copied instead of moved if their move constructor may throw, so a reallocating
+    // operation which throws leaves the vector unchanged (the same as `std::vector`).
+    struct strong
+    { };
+
+    // Elements are always moved. If a move constructor throws while reallocating, the vector is
+    // left valid but with unspecified elements.
+    struct basic
+    { };
+
+  } // namespace gch::small_vector_exception_guarantee
+
+#ifdef GCH_LIB_ALLOCATE_AT_LEAST
+
+  using std::allocation_result;
+
+#else
+
+  // The result of `allocate_at_least`. Allocators may return this (or anything with the members
+  // `ptr` and `count`) to report that they allocated more elements than were requested.
+  template <typename Pointer, typename SizeType = std::size_t>
+  struct allocation_result
+  {
+    Pointer  ptr;
+    SizeType count;
+  };
+
+#endif
+
+  // Selects the constructor which default-initializes its elements. Like `resize_for_overwrite`,
+  // this leaves elements of trivial types with indeterminate values.
+  struct for_overwrite_t
+  {
+    explicit for_overwrite_t (void) = default;
+  };
+
+  GCH_INLINE_VARIABLE constexpr
+  for_overwrite_t
+  for_overwrite { };
+
+  // Selects the constructor which takes ownership of an existing allocation.
+  struct adopt_allocation_t
+  {
+    explicit adopt_allocation_t (void) = default;
+  };
+
+  GCH_INLINE_VARIABLE constexpr
+  adopt_allocation_t
+  adopt_allocation { };
+
+  // An allocation given up by `small_vector::release`. The first `size` elements at `ptr` are
+  // constructed, and the allocation holds `capacity` elements. The new owner must destroy the
+  // elements and deallocate it with `allocator`.
+  template <typename Pointer, typename SizeType, typename Allocator>
+  struct small_vector_allocation
+  {
+    Pointer   ptr;
+    SizeType  size;
+    SizeType  capacity;
+    Allocator allocator;
+  };
+
+  // Options may be customized by deriving from this class and shadowing its members.
+  struct small_vector_default_options
+  {
+    // Note: `one_and_a_half` might be theoretically superior, but in testing it falls flat.
+    using growth_policy = small_vector_growth::doubling;
+
+    // The type used to store the size and capacity. If `void`, the `size_type` of the allocator is
+    // used. Otherwise, this must be an unsigned integral type no larger than that `size_type`.
+    using size_type = void;
+
+    using layout = small_vector_layout::standard;
+
+    // Note: `basic` may be much faster for types with throwing move constructors. See
+    //       `always_relocate_with_move` to choose this for each type instead.
+    using exception_guarantee = small_vector_exception_guarantee::strong;
+
+    // The alignment of the elements, which may be larger than their natural alignment to allow for
+    // aligned vector instructions. If `0`, the natural alignment of the elements is used.
+    using alignment = std::integral_constant<std::size_t, 0>;
+
+    // Note: Shrinking reallocates inside `erase`, `pop_back`, and `clear`, which then invalidate
+    //       iterators to the remaining elements.
+    using shrink_policy = small_vector_shrink::never;
+  };
+
+  // Stores the size and capacity as `SizeType` instead of the `size_type` of the allocator.
+  template <typename SizeType, typename BaseOptions = small_vector_default_options>
+  struct small_vector_size_options
+    : BaseOptions
+  {
+    using size_type = SizeType;
+  };
+
+  // Stores the data pointer, capacity, and size according to `Layout`.
+  template <typename Layout, typename BaseOptions = small_vector_default_options>
+  struct small_vector_layout_options
+    : BaseOptions
+  {
+    using layout = Layout;
+  };
+
+  // Relocates elements with the exception guarantee `Guarantee` when reallocating.
+  template <typename Guarantee, typename BaseOptions = small_vector_default_options>
+  struct small_vector_exception_guarantee_options
+    : BaseOptions
+  {
+    using exception_guarantee = Guarantee;
+  };
+
+  // Gives memory back after elements are removed according to `ShrinkPolicy`.
+  template <typename ShrinkPolicy, typename BaseOptions = small_vector_default_options>
+  struct small_vector_shrink_options
+    : BaseOptions
+  {
+    using shrink_policy = ShrinkPolicy;
+  };
+
+  // Aligns the inline storage to `Alignment` and lets the compiler assume that the data pointer is
+  // aligned to `Alignment`. The allocator must report an `alignment` of at least `Alignment` (see
+  // `aligned_allocator`).
+  template <std::size_t Alignment, typename BaseOptions = small_vector_default_options>
+  struct small_vector_alignment_options
+    : BaseOptions
+  {
+    static_assert (Alignment != 0 && (Alignment & (Alignment - 1)) == 0,
+                   "`Alignment` must be a power of two.");
+
+    using alignment = std::integral_constant<std::size_t, Alignment>;
+  };
+
+  template <typename Allocator, typename Options = small_vector_default_options>
 #ifdef GCH_LIB_CONCEPTS
   requires concepts::small_vector::Allocator<Allocator>
 #endif
@@ -742,13 +1124,22 @@ namespace gch
 
   template <typename T,
             unsigned InlineCapacity = default_buffer_size<std::allocator<T>>::value,
-            typename Allocator      = std::allocator<T>>
+            typename Allocator      = std::allocator<T>,
+            typename Options        = small_vector_default_options>
 #ifdef GCH_LIB_CONCEPTS
   requires concepts::small_vector::AllocatorFor<Allocator, T>
 #endif
   class small_vector;
 
-  template <typename Allocator>
+  namespace detail
+  {
+
+    // Reads the data of a `small_vector` for `small_vector_ref`.
+    struct small_vector_access;
+
+  } // namespace gch::detail
+
+  template <typename Allocator, typename Options>
 #ifdef GCH_LIB_CONCEPTS
   requires concepts::small_vector::Allocator<Allocator>
 #endif
@@ -768,7 +1159,7 @@ namespace gch
   public:
     using allocator_type     = Allocator;
     using value_type         = typename std::allocator_traits<allocator_type>::value_type;
-    using empty_small_vector = small_vector<value_type, 0, allocator_type>;
+    using empty_small_vector = small_vector<value_type, 0, allocator_type, Options>;
 
     static_assert (is_complete<value_type>::value,
                    "Calculation of a default number of elements requires that `T` be complete.");
@@ -790,9 +1181,18 @@ namespace gch
 
 #endif
 
+    // The compact layout stores the allocation pointer and capacity in the inline storage.
+    static constexpr
+    unsigned
+    overlapped_size =
+      std::is_same<typename Options::layout, small_vector_layout::compact>::value
+        ? sizeof (typename empty_small_vector::pointer)
+            + sizeof (typename empty_small_vector::size_type)
+        : 0;
+
     static constexpr
     unsigned
-    ideal_buffer = ideal_total - sizeof (empty_small_vector);
+    ideal_buffer = ideal_total - (sizeof (empty_small_vector) - overlapped_size);
 
     static_assert (sizeof (empty_small_vector) != 0,
                    "Empty `small_vector` should not have size 0.");
@@ -802,15 +1202,45 @@ namespace gch
 
     static constexpr
     unsigned
-    value = (sizeof (value_type) <= ideal_buffer) ? (ideal_buffer / sizeof (value_type)) : 1;
+    value = std::is_same<typename Options::layout, small_vector_layout::heap_header>::value
+              ? 0
+              : (sizeof (value_type) <= ideal_buffer) ? (ideal_buffer / sizeof (value_type)) : 1;
   };
 
 #ifdef GCH_VARIABLE_TEMPLATES
 
-  template <typename Allocator>
+  template <typename Allocator, typename Options = small_vector_default_options>
   GCH_INLINE_VARIABLE constexpr
   unsigned
-  default_buffer_size_v = default_buffer_size<Allocator>::value;
+  default_buffer_size_v = default_buffer_size<Allocator, Options>::value;
+
+#endif
+
+  // A `small_vector` which stores its size and capacity as `SizeType`. For example,
+  // `small_vector_with_size_type<T, std::uint32_t>` has a 16 byte header on 64-bit platforms.
+  template <typename T,
+            typename SizeType,
+            unsigned InlineCapacity =
+              default_buffer_size<std::allocator<T>, small_vector_size_options<SizeType>>::value,
+            typename Allocator = std::allocator<T>>
+  using small_vector_with_size_type =
+    small_vector<T, InlineCapacity, Allocator, small_vector_size_options<SizeType>>;
+
+#ifdef GCH_LIB_MEMORY_RESOURCE
+
+  namespace pmr
+  {
+
+    // A `small_vector` which allocates from a `std::pmr::memory_resource`. Like the containers in
+    // `std::pmr`, the resource does not propagate on copy, move assignment, or swap, and nested
+    // vectors are constructed with the resource of the outer vector.
+    template <typename T,
+              unsigned InlineCapacity =
+                default_buffer_size<std::pmr::polymorphic_allocator<T>>::value>
+    using small_vector =
+      gch::small_vector<T, InlineCapacity, std::pmr::polymorphic_allocator<T>>;
+
+  } // namespace gch::pmr
 
 #endif
 
@@ -1246,7 +1676,38 @@ namespace gch
 
 #endif
 
-    template <typename T, unsigned InlineCapacity>
+    // Tells the compiler that `p` is aligned to `Alignment`. This is skipped during constant
+    // evaluation, where allocations only have the natural alignment of `T`.
+    template <std::size_t Alignment, typename Pointer,
+              typename std::enable_if<(Alignment <= 1)
+                                    ||! std::is_pointer<Pointer>::value>::type * = nullptr>
+    GCH_NODISCARD constexpr
+    Pointer
+    assume_aligned (Pointer p) noexcept
+    {
+      return p;
+    }
+
+    template <std::size_t Alignment, typename T,
+              typename std::enable_if<(1 < Alignment)>::type * = nullptr>
+    GCH_NODISCARD GCH_CPP14_CONSTEXPR
+    T *
+    assume_aligned (T *p) noexcept
+    {
+#ifdef GCH_LIB_IS_CONSTANT_EVALUATED
+      if (std::is_constant_evaluated ())
+        return p;
+#endif
+#if defined (__cpp_lib_assume_aligned) && __cpp_lib_assume_aligned >= 201811L
+      return std::assume_aligned<Alignment> (p);
+#elif defined (__GNUC__)
+      return static_cast<T *> (__builtin_assume_aligned (p, Alignment));
+#else
+      return p;
+#endif
+    }
+
+    template <typename T, unsigned InlineCapacity, std::size_t Alignment = 0>
     class inline_storage
     {
     public:
@@ -1267,9 +1728,13 @@ namespace gch
       }
 
     private:
-      union alignas (alignof (value_ty)) {
+      union alignas (alignof (value_ty)) element
+      {
         unsigned char _[sizeof (value_ty)];
-      } m_data[InlineCapacity];
+      };
+
+      alignas (alignof (value_ty) < Alignment ? Alignment : alignof (value_ty))
+      element m_data[InlineCapacity];
     };
 
     template <typename Allocator, bool AvailableForEBO = std::is_empty<Allocator>::value
@@ -1347,7 +1812,7 @@ namespace gch
       Allocator m_alloc;
     };
 
-    template <typename Allocator>
+    template <typename Allocator, typename SizeType = void>
     class GCH_EMPTY_BASE allocator_interface
       : public allocator_inliner<Allocator>
     {
@@ -1362,7 +1827,21 @@ namespace gch
         : std::true_type
       { };
 
-      using size_type = typename std::allocator_traits<Allocator>::size_type;
+    protected:
+      using alloc_size_type = typename std::allocator_traits<Allocator>::size_type;
+
+    public:
+      // The size type may be chosen independently of the allocator.
+      using size_type = typename std::conditional<std::is_void<SizeType>::value,
+                                                  alloc_size_type,
+                                                  SizeType>::type;
+
+      static_assert (std::is_integral<size_type>::value && std::is_unsigned<size_type>::value,
+                     "`size_type` must be an unsigned integral type.");
+
+      static_assert ((std::numeric_limits<size_type>::max) ()
+                  <= (std::numeric_limits<alloc_size_type>::max) (),
+                     "`size_type` must not be larger than the `size_type` of the allocator.");
 
       // If difference_type is larger than size_type then we need
       // to rectify that problem.
@@ -1518,10 +1997,124 @@ namespace gch
         : has_alloc_construct_impl<void, A, V, Args...>
       { };
 
+      template <typename A, typename Enable = void>
+      struct has_alloc_allocate_at_least
+        : std::false_type
+      { };
+
+      template <typename A>
+      struct has_alloc_allocate_at_least<A,
+            void_t<decltype (std::declval<A&> ().allocate_at_least (
+              std::declval<alloc_size_type> ()))>>
+        : std::true_type
+      { };
+
+      template <typename A, typename Enable = void>
+      struct has_alloc_allocate_at_least_with_hint
+        : std::false_type
+      { };
+
+      template <typename A>
+      struct has_alloc_allocate_at_least_with_hint<A,
+            void_t<decltype (std::declval<A&> ().allocate_at_least (
+              std::declval<alloc_size_type> (),
+              std::declval<typename std::allocator_traits<A>::const_pointer> ()))>>
+        : std::true_type
+      { };
+
+      template <typename A, typename Enable = void>
+      struct has_alloc_try_allocate_at_least
+        : std::false_type
+      { };
+
+      template <typename A>
+      struct has_alloc_try_allocate_at_least<A,
+            void_t<decltype (std::declval<A&> ().try_allocate_at_least (
+              std::declval<alloc_size_type> ()))>>
+        : std::true_type
+      { };
+
+      template <typename A, typename Enable = void>
+      struct has_alloc_reallocate
+        : std::false_type
+      { };
+
+      template <typename A>
+      struct has_alloc_reallocate<A,
+            void_t<decltype (std::declval<A&> ().reallocate (
+              std::declval<ptr> (),
+              std::declval<alloc_size_type> (),
+              std::declval<alloc_size_type> ()))>>
+        : std::true_type
+      { };
+
+      template <typename A, typename Enable = void>
+      struct has_alloc_allocate_zeroed
+        : std::false_type
+      { };
+
+      template <typename A>
+      struct has_alloc_allocate_zeroed<A,
+            void_t<decltype (std::declval<A&> ().allocate_zeroed (
+              std::declval<alloc_size_type> ()))>>
+        : std::true_type
+      { };
+
+      template <typename A, typename Enable = void>
+      struct has_alloc_is_external_buffer
+        : std::false_type
+      { };
+
+      template <typename A>
+      struct has_alloc_is_external_buffer<A,
+            void_t<decltype (std::declval<const A&> ().is_external_buffer (
+              std::declval<cptr> ()))>>
+        : std::true_type
+      { };
+
+      template <typename A>
+      struct is_polymorphic_allocator
+        : std::false_type
+      { };
+
+#ifdef GCH_LIB_MEMORY_RESOURCE
+      template <typename U>
+      struct is_polymorphic_allocator<std::pmr::polymorphic_allocator<U>>
+        : std::true_type
+      { };
+#endif
+
+      template <typename V>
+      struct is_pair
+        : std::false_type
+      { };
+
+      template <typename T1, typename T2>
+      struct is_pair<std::pair<T1, T2>>
+        : std::true_type
+      { };
+
+      // `std::pmr::polymorphic_allocator::construct` is not noexcept, but for types which do not
+      // take the allocator it only uses placement new. We construct those directly so that the
+      // exception specifications of their constructors are used. Pairs are left to the allocator,
+      // since it passes itself to their members.
+      template <typename A, typename V, typename Enable = void>
+      struct is_polymorphic_placement
+        : std::false_type
+      { };
+
+      template <typename A, typename V>
+      struct is_polymorphic_placement<A, V,
+            typename std::enable_if<is_polymorphic_allocator<A>::value
+                                    &&  is_complete<V>::value>::type>
+        : bool_constant<! std::uses_allocator<V, A>::value &&! is_pair<V>::value>
+      { };
+
       template <typename A, typename V, typename ...Args>
       struct must_use_alloc_construct
         : bool_constant<! std::is_same<A, std::allocator<V>>::value
-                      &&  has_alloc_construct<A, V, Args...>::value>
+                      &&  has_alloc_construct<A, V, Args...>::value
+                      &&! is_polymorphic_placement<A, V>::value>
       { };
 
       template <typename Void, typename A, typename V>
@@ -1536,13 +2129,17 @@ namespace gch
         : std::true_type
       { };
 
+      // `std::pmr::polymorphic_allocator::destroy` only calls the destructor, and is deprecated,
+      // so we don't check for it.
       template <typename A, typename V, typename Enable = void>
       struct has_alloc_destroy
         : std::false_type
       { };
 
       template <typename A, typename V>
-      struct has_alloc_destroy<A, V, typename std::enable_if<is_complete<V>::value>::type>
+      struct has_alloc_destroy<A, V,
+            typename std::enable_if<is_complete<V>::value
+                                  &&! is_polymorphic_allocator<A>::value>::type>
         : has_alloc_destroy_impl<void, A, V>
       { };
 
@@ -1696,14 +2293,48 @@ namespace gch
                &&! must_use_alloc_destroy<alloc_ty, value_ty>::value);
       };
 
-      template <typename To, typename ...Args>
-      struct is_uninitialized_memcpyable
-        : std::false_type
+      // Relocation by `std::memcpy`. Construction and destruction must not be customized.
+      template <typename V = value_ty>
+      struct is_uninitialized_relocatable
+        : bool_constant<is_trivially_relocatable<V>::value
+                    &&! must_use_alloc_construct<alloc_ty, V, V&&>::value
+                    &&! must_use_alloc_destroy<alloc_ty, V>::value>
       { };
 
-      template <typename To, typename From>
-      struct is_uninitialized_memcpyable<To, From>
-        : is_uninitialized_memcpyable_impl<From, To>
+      // Whether the allocator can resize an allocation and carry its bytes over to the result.
+      template <typename A = alloc_ty>
+      struct is_reallocatable
+        : has_alloc_reallocate<A>
+      { };
+
+      // Whether allocations are aligned to at least `Alignment`. Allocators may report a larger
+      // alignment than that of `value_type` with a static member `alignment`.
+      template <std::size_t Alignment, typename A = alloc_ty, typename Enable = void>
+      struct is_alignment_supported
+        : bool_constant<Alignment <= alignof (value_ty)>
+      { };
+
+      template <std::size_t Alignment, typename A>
+      struct is_alignment_supported<Alignment, A, void_t<decltype (A::alignment)>>
+        : bool_constant<Alignment <= alignof (value_ty) || Alignment <= A::alignment>
+      { };
+
+      // Whether value-initialized elements may be left as memory from `allocate_zeroed`.
+      template <typename A = alloc_ty, typename V = value_ty>
+      struct is_zero_allocatable
+        : bool_constant<has_alloc_allocate_zeroed<A>::value
+                    &&  is_zero_initializable<V>::value
+                    &&! must_use_alloc_construct<A, V>::value>
+      { };
+
+      template <typename To, typename ...Args>
+      struct is_uninitialized_memcpyable
+        : std::false_type
+      { };
+
+      template <typename To, typename From>
+      struct is_uninitialized_memcpyable<To, From>
+        : is_uninitialized_memcpyable_impl<From, To>
       { };
 
       template <typename Iterator>
@@ -1958,23 +2589,161 @@ namespace gch
       size_ty
       get_max_size (void) const noexcept
       {
-        // This is protected from max/min macros.
-        return (std::min) (static_cast<size_ty> (alloc_traits::max_size (allocator_ref ())),
-                           static_cast<size_ty> (numeric_max<difference_type> ()));
+        // This is always representable by `size_type` since `difference_type` is no larger.
+        const size_ty diff_max = static_cast<size_ty> (numeric_max<difference_type> ());
+        const alloc_size_type alloc_max = alloc_traits::max_size (allocator_ref ());
+        return alloc_max < diff_max ? static_cast<size_ty> (alloc_max) : diff_max;
       }
 
       GCH_NODISCARD GCH_CPP20_CONSTEXPR
       ptr
       allocate (size_ty n)
       {
-        return alloc_traits::allocate (allocator_ref (), static_cast<size_type> (n));
+        return alloc_traits::allocate (allocator_ref (), static_cast<alloc_size_type> (n));
       }
 
       GCH_NODISCARD GCH_CPP20_CONSTEXPR
       ptr
       allocate_with_hint (size_ty n, cptr hint)
       {
-        return alloc_traits::allocate (allocator_ref (), static_cast<size_type> (n), hint);
+        return alloc_traits::allocate (allocator_ref (), static_cast<alloc_size_type> (n), hint);
+      }
+
+      // We detect `allocate_at_least` directly rather than going through `alloc_traits` so that
+      // the hint is still used for allocators which don't support it.
+      template <typename A = alloc_ty,
+                typename std::enable_if<has_alloc_allocate_at_least<A>::value>::type * = nullptr>
+      GCH_NODISCARD GCH_CPP20_CONSTEXPR
+      allocation_result<ptr, alloc_size_type>
+      allocate_at_least (size_ty n)
+      {
+        const auto result =
+          allocator_ref ().allocate_at_least (static_cast<alloc_size_type> (n));
+        return { result.ptr, static_cast<alloc_size_type> (result.count) };
+      }
+
+      template <typename A = alloc_ty,
+                typename std::enable_if<! has_alloc_allocate_at_least<A>::value>::type * = nullptr>
+      GCH_NODISCARD GCH_CPP20_CONSTEXPR
+      allocation_result<ptr, alloc_size_type>
+      allocate_at_least (size_ty n)
+      {
+        return { allocate (n), static_cast<alloc_size_type> (n) };
+      }
+
+      template <typename A = alloc_ty,
+                typename std::enable_if<
+                  has_alloc_allocate_at_least_with_hint<A>::value
+                >::type * = nullptr>
+      GCH_NODISCARD GCH_CPP20_CONSTEXPR
+      allocation_result<ptr, alloc_size_type>
+      allocate_at_least (size_ty n, cptr hint)
+      {
+        const auto result =
+          allocator_ref ().allocate_at_least (static_cast<alloc_size_type> (n), hint);
+        return { result.ptr, static_cast<alloc_size_type> (result.count) };
+      }
+
+      // Like `std::allocator_traits::allocate`, the hint is dropped if the allocator does not take
+      // one. We prefer the larger allocation over the hint here.
+      template <typename A = alloc_ty,
+                typename std::enable_if<
+                      has_alloc_allocate_at_least<A>::value
+                  &&! has_alloc_allocate_at_least_with_hint<A>::value
+                >::type * = nullptr>
+      GCH_NODISCARD GCH_CPP20_CONSTEXPR
+      allocation_result<ptr, alloc_size_type>
+      allocate_at_least (size_ty n, cptr)
+      {
+        return allocate_at_least (n);
+      }
+
+      template <typename A = alloc_ty,
+                typename std::enable_if<! has_alloc_allocate_at_least<A>::value>::type * = nullptr>
+      GCH_NODISCARD GCH_CPP20_CONSTEXPR
+      allocation_result<ptr, alloc_size_type>
+      allocate_at_least (size_ty n, cptr hint)
+      {
+        return { allocate_with_hint (n, hint), static_cast<alloc_size_type> (n) };
+      }
+
+      // Like `allocate_at_least`, but a null pointer is returned if the allocation fails.
+      // Allocators may report failure without exceptions by defining `try_allocate_at_least`.
+      template <typename A = alloc_ty,
+                typename std::enable_if<
+                  has_alloc_try_allocate_at_least<A>::value
+                >::type * = nullptr>
+      GCH_NODISCARD GCH_CPP20_CONSTEXPR
+      allocation_result<ptr, alloc_size_type>
+      try_allocate_at_least (size_ty n, cptr)
+      {
+        const auto result =
+          allocator_ref ().try_allocate_at_least (static_cast<alloc_size_type> (n));
+        return { result.ptr, static_cast<alloc_size_type> (result.count) };
+      }
+
+      // Otherwise, we can only detect failure if the allocator throws `std::bad_alloc`.
+      template <typename A = alloc_ty,
+                typename std::enable_if<
+                  ! has_alloc_try_allocate_at_least<A>::value
+                >::type * = nullptr>
+      GCH_NODISCARD GCH_CPP20_CONSTEXPR
+      allocation_result<ptr, alloc_size_type>
+      try_allocate_at_least (size_ty n, cptr hint)
+      {
+        GCH_TRY
+        {
+          return allocate_at_least (n, hint);
+        }
+        GCH_CATCH (const std::bad_alloc&)
+        {
+          return { nullptr, 0 };
+        }
+      }
+
+      // Resizes the allocation at `p` from `old_n` to at least `new_n` elements. The bytes of the
+      // old allocation are carried over, possibly to a new address. The old allocation is left
+      // unchanged if this throws.
+      template <typename A = alloc_ty,
+                typename std::enable_if<has_alloc_reallocate<A>::value>::type * = nullptr>
+      GCH_NODISCARD
+      allocation_result<ptr, alloc_size_type>
+      reallocate (ptr p, size_ty old_n, size_ty new_n)
+      {
+        const auto result = allocator_ref ().reallocate (p,
+                                                         static_cast<alloc_size_type> (old_n),
+                                                         static_cast<alloc_size_type> (new_n));
+        return { result.ptr, static_cast<alloc_size_type> (result.count) };
+      }
+
+      // Allocates `n` elements, all of whose bytes are zero.
+      template <typename A = alloc_ty,
+                typename std::enable_if<has_alloc_allocate_zeroed<A>::value>::type * = nullptr>
+      GCH_NODISCARD
+      ptr
+      allocate_zeroed (size_ty n)
+      {
+        return allocator_ref ().allocate_zeroed (static_cast<alloc_size_type> (n));
+      }
+
+      // Whether `p` points into a buffer which the caller gave to the allocator to use before it
+      // allocates. Elements in such a buffer are considered inlined.
+      template <typename A = alloc_ty,
+                typename std::enable_if<has_alloc_is_external_buffer<A>::value>::type * = nullptr>
+      GCH_NODISCARD constexpr
+      bool
+      is_external_buffer (cptr p) const noexcept
+      {
+        return allocator_ref ().is_external_buffer (p);
+      }
+
+      template <typename A = alloc_ty,
+                typename std::enable_if<! has_alloc_is_external_buffer<A>::value>::type * = nullptr>
+      GCH_NODISCARD constexpr
+      bool
+      is_external_buffer (cptr) const noexcept
+      {
+        return false;
       }
 
       GCH_CPP20_CONSTEXPR
@@ -1982,7 +2751,7 @@ namespace gch
       deallocate (ptr p, size_ty n)
       {
         alloc_traits::deallocate (allocator_ref (), to_address (p),
-                                  static_cast<size_type> (n));
+                                  static_cast<alloc_size_type> (n));
       }
 
       // This is basically alloc_traits::construct, and is defined so that we
@@ -2027,6 +2796,35 @@ namespace gch
         construct_at (to_address (p), std::forward<Args> (args)...);
       }
 
+      // The allocator may only value-initialize, so we use it if we must.
+      template <typename A = alloc_ty, typename V = value_ty,
+                typename std::enable_if<must_use_alloc_construct<A, V>::value>::type * = nullptr>
+      GCH_CPP20_CONSTEXPR
+      void
+      default_construct (ptr p)
+        noexcept (noexcept (std::declval<alloc_ty&> ().construct (std::declval<value_ty *> ())))
+      {
+        allocator_ref ().construct (to_address (p));
+      }
+
+      template <typename A = alloc_ty, typename V = value_ty,
+                typename std::enable_if<! must_use_alloc_construct<A, V>::value>::type * = nullptr>
+      GCH_CPP20_CONSTEXPR
+      void
+      default_construct (ptr p)
+        noexcept (std::is_nothrow_default_constructible<value_ty>::value)
+      {
+#if defined (GCH_LIB_IS_CONSTANT_EVALUATED) && defined (GCH_LIB_CONSTEXPR_MEMORY)
+        if (std::is_constant_evaluated ())
+        {
+          std::construct_at (to_address (p));
+          return;
+        }
+#endif
+        void *vp = const_cast<void *> (static_cast<const volatile void *> (to_address (p)));
+        ::new (vp) value_ty;
+      }
+
       template <typename A = alloc_ty, typename V = value_ty,
                 typename std::enable_if<must_use_alloc_destroy<A, V>::value>::type * = nullptr>
       GCH_CPP20_CONSTEXPR
@@ -2182,6 +2980,43 @@ namespace gch
         }
       }
 
+      template <typename A = alloc_ty, typename V = value_ty,
+        typename std::enable_if<is_trivially_constructible<V>::value
+                            &&! must_use_alloc_construct<A, V>::value>::type * = nullptr>
+      GCH_CPP20_CONSTEXPR
+      ptr
+      uninitialized_default_construct (ptr first, ptr last) noexcept
+      {
+#ifdef GCH_LIB_IS_CONSTANT_EVALUATED
+        // Indeterminate values may not be read in constant expressions.
+        if (std::is_constant_evaluated ())
+          return default_uninitialized_value_construct (first, last);
+#endif
+        static_cast<void> (first);
+        return last;
+      }
+
+      template <typename A = alloc_ty, typename V = value_ty,
+        typename std::enable_if<! is_trivially_constructible<V>::value
+                              ||  must_use_alloc_construct<A, V>::value>::type * = nullptr>
+      GCH_CPP20_CONSTEXPR
+      ptr
+      uninitialized_default_construct (ptr first, ptr last)
+      {
+        ptr curr = first;
+        GCH_TRY
+        {
+          for (; ! (curr == last); ++curr)
+            default_construct (curr);
+          return curr;
+        }
+        GCH_CATCH (...)
+        {
+          destroy_range (first, curr);
+          GCH_THROW;
+        }
+      }
+
       GCH_CPP20_CONSTEXPR
       ptr
       uninitialized_fill (ptr first, ptr last)
@@ -2189,6 +3024,13 @@ namespace gch
         return uninitialized_value_construct (first, last);
       }
 
+      GCH_CPP20_CONSTEXPR
+      ptr
+      uninitialized_fill (ptr first, ptr last, for_overwrite_t)
+      {
+        return uninitialized_default_construct (first, last);
+      }
+
       GCH_CPP20_CONSTEXPR
       ptr
       uninitialized_fill (ptr first, ptr last, const value_ty& val)
@@ -2311,13 +3153,21 @@ namespace gch
         swap (m_size,     other.m_size);
       }
 
+      static constexpr
+      std::size_t
+      allocation_offset (void) noexcept
+      {
+        return 0;
+      }
+
     private:
       ptr     m_data_ptr;
       size_ty m_capacity;
       size_ty m_size;
     };
 
-    template <typename Pointer, typename SizeT, typename T, unsigned InlineCapacity>
+    template <typename Pointer, typename SizeT, typename T, unsigned InlineCapacity,
+              std::size_t Alignment = 0>
     class small_vector_data
       : public small_vector_data_base<Pointer, SizeT>
     {
@@ -2329,6 +3179,16 @@ namespace gch
       small_vector_data& operator= (small_vector_data&&) noexcept = delete;
       ~small_vector_data           (void)                         = default;
 
+      // This is a comparison of the capacity with a constant, so it never loads the address of the
+      // inline storage. Tagging a bit of the capacity instead would mask every read of it, which
+      // is the tradeoff made by `small_vector_layout::compact`.
+      constexpr
+      bool
+      is_allocated (void) const noexcept
+      {
+        return InlineCapacity < this->capacity ();
+      }
+
       GCH_CPP14_CONSTEXPR
       T *
       storage (void) noexcept
@@ -2337,11 +3197,11 @@ namespace gch
       }
 
     private:
-      inline_storage<T, InlineCapacity> m_storage;
+      inline_storage<T, InlineCapacity, Alignment> m_storage;
     };
 
-    template <typename Pointer, typename SizeT, typename T>
-    class GCH_EMPTY_BASE small_vector_data<Pointer, SizeT, T, 0>
+    template <typename Pointer, typename SizeT, typename T, std::size_t Alignment>
+    class GCH_EMPTY_BASE small_vector_data<Pointer, SizeT, T, 0, Alignment>
       : public small_vector_data_base<Pointer, SizeT>
     {
     public:
@@ -2352,6 +3212,13 @@ namespace gch
       small_vector_data& operator= (small_vector_data&&) noexcept = delete;
       ~small_vector_data           (void)                         = default;
 
+      constexpr
+      bool
+      is_allocated (void) const noexcept
+      {
+        return 0 < this->capacity ();
+      }
+
       GCH_CPP14_CONSTEXPR
       T *
       storage (void) noexcept
@@ -2360,105 +3227,488 @@ namespace gch
       }
     };
 
-    template <typename Allocator, unsigned InlineCapacity>
-    class small_vector_base
-      : public allocator_interface<Allocator>
+    // The data for `small_vector_layout::compact`. The allocation pointer and capacity are only
+    // valid while the highest bit of `m_size` is set. Otherwise, the elements are in `m_storage`
+    // and the capacity is `InlineCapacity`.
+    template <typename Pointer, typename SizeT, typename T, unsigned InlineCapacity,
+              std::size_t Alignment = 0>
+    class small_vector_compact_data
     {
     public:
-      using size_type       = typename allocator_interface<Allocator>::size_type;
-      using difference_type = typename allocator_interface<Allocator>::difference_type;
-
-      template <typename SameAllocator, unsigned DifferentInlineCapacity>
-      friend class small_vector_base;
-
-    protected:
-      using alloc_interface = allocator_interface<Allocator>;
-      using alloc_traits    = typename alloc_interface::alloc_traits;
-      using alloc_ty        = Allocator;
+      using ptr     = Pointer;
+      using size_ty = SizeT;
 
-      using value_ty        = typename alloc_interface::value_ty;
-      using ptr             = typename alloc_interface::ptr;
-      using cptr            = typename alloc_interface::cptr;
-      using size_ty         = typename alloc_interface::size_ty;
-      using diff_ty         = typename alloc_interface::diff_ty;
+      static_assert (std::is_pointer<ptr>::value,
+                     "The compact layout requires an allocator which uses raw pointers.");
 
-      static_assert (alloc_interface::template is_complete<value_ty>::value || InlineCapacity == 0,
-                     "`value_type` must be complete for instantiation of a non-zero number "
-                     "of inline elements.");
+      static_assert (0 < InlineCapacity, "The compact layout requires inline storage.");
 
-      template <typename T>
-      using is_complete = typename alloc_interface::template is_complete<T>;
+      GCH_CPP20_CONSTEXPR
+      small_vector_compact_data (void) noexcept
+        : m_size (0)
+      { }
 
-      using alloc_interface::allocator_ref;
-      using alloc_interface::construct;
-      using alloc_interface::deallocate;
-      using alloc_interface::destroy;
-      using alloc_interface::destroy_range;
-      using alloc_interface::external_range_length;
-      using alloc_interface::get_max_size;
-      using alloc_interface::internal_range_length;
-      using alloc_interface::to_address;
-      using alloc_interface::unchecked_advance;
-      using alloc_interface::unchecked_next;
-      using alloc_interface::unchecked_prev;
-      using alloc_interface::uninitialized_copy;
-      using alloc_interface::uninitialized_fill;
-      using alloc_interface::uninitialized_value_construct;
+      small_vector_compact_data            (const small_vector_compact_data&)     = delete;
+      small_vector_compact_data            (small_vector_compact_data&&) noexcept = delete;
+      small_vector_compact_data& operator= (const small_vector_compact_data&)     = delete;
+      small_vector_compact_data& operator= (small_vector_compact_data&&) noexcept = delete;
+      ~small_vector_compact_data           (void)                                 = default;
 
-      template <typename Integer>
-      GCH_NODISCARD
-      static GCH_CONSTEVAL
-      std::size_t
-      numeric_max (void) noexcept
+      constexpr
+      ptr
+      data_ptr (void) const noexcept
       {
-        return alloc_interface::template numeric_max<Integer> ();
+        return is_allocated () ? m_allocation.data_ptr : inline_ptr ();
       }
 
-      GCH_NODISCARD
-      static GCH_CONSTEVAL
+      constexpr
       size_ty
-      get_inline_capacity (void) noexcept
+      capacity (void) const noexcept
       {
-        return static_cast<size_ty> (InlineCapacity);
+        return is_allocated () ? m_allocation.capacity : static_cast<size_ty> (InlineCapacity);
       }
 
-      template <typename ...>
-      using void_t = void;
+      constexpr
+      size_ty
+      size (void) const noexcept
+      {
+        return static_cast<size_ty> (m_size & size_mask ());
+      }
 
-      template <bool B>
-      using bool_constant = std::integral_constant<bool, B>;
+      constexpr
+      bool
+      is_allocated (void) const noexcept
+      {
+        return (m_size & allocated_bit ()) != 0;
+      }
 
-      template <typename Void, typename AI, typename V, typename ...Args>
-      struct is_emplace_constructible_impl
-        : std::false_type
+      GCH_CPP20_CONSTEXPR
+      void
+      set_data_ptr (ptr data_ptr) noexcept
       {
-        using nothrow = std::false_type;
-      };
+#ifdef GCH_LIB_IS_CONSTANT_EVALUATED
+        // The inline storage is never used during constant evaluation.
+        if (! std::is_constant_evaluated () && data_ptr == storage ())
+#else
+        if (data_ptr == storage ())
+#endif
+          m_size = size ();
+        else
+        {
+          m_allocation.data_ptr = data_ptr;
+          m_size = static_cast<size_ty> (size () | allocated_bit ());
+        }
+      }
 
-      template <typename AI, typename V, typename ...Args>
-      struct is_emplace_constructible_impl<
-            void_t<typename std::enable_if<is_complete<V>::value>::type,
-                   decltype (std::declval<AI&> ().construct (std::declval<V *> (),
-                                                             std::declval<Args> ()...))>,
-            AI, V, Args...>
-        : std::true_type
+      GCH_CPP20_CONSTEXPR
+      void
+      set_capacity (size_ty capacity) noexcept
       {
-        using nothrow =
-          bool_constant<noexcept (std::declval<AI&> ().construct (std::declval<V *> (),
-                                                                  std::declval<Args> ()...))>;
-      };
+        assert ((is_allocated () || capacity == InlineCapacity) && "Invalid inline capacity.");
+        if (is_allocated ())
+          m_allocation.capacity = capacity;
+      }
 
-      template <typename ...Args>
-      struct is_emplace_insertable
-        : is_emplace_constructible_impl<void, alloc_interface, value_ty, Args...>
-      { };
+      GCH_CPP20_CONSTEXPR
+      void
+      set_size (size_ty size) noexcept
+      {
+        assert (size <= size_mask () && "`size` overlaps the allocation bit.");
+        m_size = static_cast<size_ty> ((m_size & allocated_bit ()) | size);
+      }
 
-      template <typename ...Args>
-      struct is_nothrow_emplace_insertable
-        : is_emplace_insertable<Args...>::nothrow
-      { };
+      GCH_CPP20_CONSTEXPR
+      void
+      set (ptr data_ptr, size_ty capacity, size_ty size)
+      {
+        set_data_ptr (data_ptr);
+        set_capacity (capacity);
+        set_size (size);
+      }
 
-      template <typename V = value_ty>
+      // `other` may be the data of a vector with a different inline capacity (including 0), so we
+      // only use its public interface.
+      template <typename Data>
+      GCH_CPP20_CONSTEXPR
+      void
+      swap_data_ptr (Data& other) noexcept
+      {
+        assert (is_allocated () && "Only allocations are swapped.");
+        const ptr other_data_ptr = other.data_ptr ();
+        other.set_data_ptr (m_allocation.data_ptr);
+        m_allocation.data_ptr = other_data_ptr;
+      }
+
+      template <typename Data>
+      GCH_CPP20_CONSTEXPR
+      void
+      swap_capacity (Data& other) noexcept
+      {
+        assert (is_allocated () && "Only allocations are swapped.");
+        const size_ty other_capacity = other.capacity ();
+        other.set_capacity (m_allocation.capacity);
+        m_allocation.capacity = other_capacity;
+      }
+
+      template <typename Data>
+      GCH_CPP20_CONSTEXPR
+      void
+      swap_size (Data& other) noexcept
+      {
+        const size_ty other_size = other.size ();
+        other.set_size (size ());
+        set_size (other_size);
+      }
+
+      GCH_CPP14_CONSTEXPR
+      T *
+      storage (void) noexcept
+      {
+        return m_storage.get_inline_ptr ();
+      }
+
+      static constexpr
+      std::size_t
+      allocation_offset (void) noexcept
+      {
+        return 0;
+      }
+
+    private:
+      struct allocation
+      {
+        ptr     data_ptr;
+        size_ty capacity;
+      };
+
+      static constexpr
+      size_ty
+      allocated_bit (void) noexcept
+      {
+        return static_cast<size_ty> (
+          static_cast<size_ty> (1) << (std::numeric_limits<size_ty>::digits - 1));
+      }
+
+      static constexpr
+      size_ty
+      size_mask (void) noexcept
+      {
+        return static_cast<size_ty> (allocated_bit () - 1);
+      }
+
+      GCH_CPP14_CONSTEXPR
+      ptr
+      inline_ptr (void) const noexcept
+      {
+        return const_cast<small_vector_compact_data *> (this)->storage ();
+      }
+
+      union
+      {
+        allocation                                   m_allocation;
+        inline_storage<T, InlineCapacity, Alignment> m_storage;
+      };
+      size_ty m_size;
+    };
+
+    // The data for `small_vector_layout::heap_header`. The capacity and size are stored at the
+    // front of the allocation, `allocation_offset ()` elements before the data pointer. The
+    // allocation is only aligned for `T`, so the header is accessed with `std::memcpy`.
+    template <typename Pointer, typename SizeT, typename T>
+    class small_vector_header_data
+    {
+    public:
+      using ptr     = Pointer;
+      using size_ty = SizeT;
+
+      static_assert (std::is_pointer<ptr>::value,
+                     "The heap header layout requires an allocator which uses raw pointers.");
+
+      small_vector_header_data            (void)                                = default;
+      small_vector_header_data            (const small_vector_header_data&)     = delete;
+      small_vector_header_data            (small_vector_header_data&&) noexcept = delete;
+      small_vector_header_data& operator= (const small_vector_header_data&)     = delete;
+      small_vector_header_data& operator= (small_vector_header_data&&) noexcept = delete;
+      ~small_vector_header_data           (void)                                = default;
+
+      constexpr
+      ptr
+      data_ptr (void) const noexcept
+      {
+        return m_data_ptr;
+      }
+
+      size_ty
+      capacity (void) const noexcept
+      {
+        return is_allocated () ? read_header (offsetof (header, capacity)) : 0;
+      }
+
+      size_ty
+      size (void) const noexcept
+      {
+        return is_allocated () ? read_header (offsetof (header, size)) : 0;
+      }
+
+      constexpr
+      bool
+      is_allocated (void) const noexcept
+      {
+        return m_data_ptr != nullptr;
+      }
+
+      void
+      set_data_ptr (ptr data_ptr) noexcept
+      {
+        m_data_ptr = data_ptr;
+      }
+
+      void
+      set_capacity (size_ty capacity) noexcept
+      {
+        assert ((is_allocated () || capacity == 0) && "There is nowhere to store the capacity.");
+        if (is_allocated ())
+          write_header (offsetof (header, capacity), capacity);
+      }
+
+      void
+      set_size (size_ty size) noexcept
+      {
+        assert ((is_allocated () || size == 0) && "There is nowhere to store the size.");
+        if (is_allocated ())
+          write_header (offsetof (header, size), size);
+      }
+
+      void
+      set (ptr data_ptr, size_ty capacity, size_ty size)
+      {
+        set_data_ptr (data_ptr);
+        set_capacity (capacity);
+        set_size (size);
+      }
+
+      void
+      swap_size (small_vector_header_data& other) noexcept
+      {
+        const size_ty other_size = other.size ();
+        other.set_size (size ());
+        set_size (other_size);
+      }
+
+      // The header moves with the allocation.
+      void
+      swap (small_vector_header_data& other) noexcept
+      {
+        using std::swap;
+        swap (m_data_ptr, other.m_data_ptr);
+      }
+
+      GCH_CPP14_CONSTEXPR
+      T *
+      storage (void) noexcept
+      {
+        return nullptr;
+      }
+
+      static constexpr
+      std::size_t
+      allocation_offset (void) noexcept
+      {
+        return (sizeof (header) + sizeof (T) - 1) / sizeof (T);
+      }
+
+    private:
+      struct header
+      {
+        size_ty capacity;
+        size_ty size;
+      };
+
+      unsigned char *
+      header_ptr (void) const noexcept
+      {
+        void *vp = static_cast<void *> (m_data_ptr - allocation_offset ());
+        return static_cast<unsigned char *> (vp);
+      }
+
+      size_ty
+      read_header (std::size_t offset) const noexcept
+      {
+        size_ty value;
+        std::memcpy (&value, header_ptr () + offset, sizeof (value));
+        return value;
+      }
+
+      void
+      write_header (std::size_t offset, size_ty value) noexcept
+      {
+        std::memcpy (header_ptr () + offset, &value, sizeof (value));
+      }
+
+      ptr m_data_ptr;
+    };
+
+    template <typename Layout, typename Pointer, typename SizeT, typename T,
+              unsigned InlineCapacity, std::size_t Alignment = 0>
+    struct small_vector_layout_data;
+
+    // Whether the inline storage of `Data` can hold elements during constant evaluation. If not,
+    // an allocation is used in its place.
+    template <typename Data>
+    struct has_constexpr_inline_storage
+      : std::false_type
+    { };
+
+    template <typename Pointer, typename SizeT, typename T, unsigned InlineCapacity,
+              std::size_t Alignment>
+    struct small_vector_layout_data<small_vector_layout::standard, Pointer, SizeT, T,
+                                    InlineCapacity, Alignment>
+    {
+      using type = small_vector_data<Pointer, SizeT, T, InlineCapacity, Alignment>;
+    };
+
+    template <typename Pointer, typename SizeT, typename T, unsigned InlineCapacity,
+              std::size_t Alignment>
+    struct small_vector_layout_data<small_vector_layout::compact, Pointer, SizeT, T,
+                                    InlineCapacity, Alignment>
+    {
+      using type = typename std::conditional<
+        InlineCapacity == 0,
+        small_vector_data<Pointer, SizeT, T, InlineCapacity, Alignment>,
+        small_vector_compact_data<Pointer, SizeT, T, InlineCapacity, Alignment>>::type;
+    };
+
+    template <typename Pointer, typename SizeT, typename T, unsigned InlineCapacity,
+              std::size_t Alignment>
+    struct small_vector_layout_data<small_vector_layout::heap_header, Pointer, SizeT, T,
+                                    InlineCapacity, Alignment>
+    {
+      static_assert (InlineCapacity == 0,
+                     "The heap header layout cannot be used with inline storage.");
+
+      static_assert (Alignment == 0,
+                     "The heap header layout cannot be used with over-aligned elements.");
+
+      using type = small_vector_header_data<Pointer, SizeT, T>;
+    };
+
+    template <typename Allocator, unsigned InlineCapacity, typename Options>
+    class small_vector_base
+      : public allocator_interface<Allocator, typename Options::size_type>
+    {
+      using alloc_interface = allocator_interface<Allocator, typename Options::size_type>;
+
+    public:
+      using size_type       = typename alloc_interface::size_type;
+      using difference_type = typename alloc_interface::difference_type;
+
+      template <typename SameAllocator, unsigned DifferentInlineCapacity, typename SameOptions>
+      friend class small_vector_base;
+
+    protected:
+      using alloc_traits    = typename alloc_interface::alloc_traits;
+      using alloc_ty        = Allocator;
+
+      using value_ty        = typename alloc_interface::value_ty;
+      using ptr             = typename alloc_interface::ptr;
+      using cptr            = typename alloc_interface::cptr;
+      using size_ty         = typename alloc_interface::size_ty;
+      using diff_ty         = typename alloc_interface::diff_ty;
+
+      using alloc_size_type = typename alloc_interface::alloc_size_type;
+
+      using growth_policy   = typename Options::growth_policy;
+      using shrink_policy   = typename Options::shrink_policy;
+
+      using data_ty         = typename small_vector_layout_data<typename Options::layout, ptr,
+                                                                size_type, value_ty,
+                                                                InlineCapacity,
+                                                                Options::alignment::value>::type;
+
+      static_assert (alloc_interface::template is_complete<value_ty>::value || InlineCapacity == 0,
+                     "`value_type` must be complete for instantiation of a non-zero number "
+                     "of inline elements.");
+
+      static_assert (std::conditional<Options::alignment::value == 0,
+                                      std::true_type,
+                                      typename alloc_interface::template
+                                        is_alignment_supported<Options::alignment::value>>::type
+                       ::value,
+                     "The allocator must report an `alignment` of at least the alignment in "
+                     "`Options` (see `gch::aligned_allocator`).");
+
+      template <typename T>
+      using is_complete = typename alloc_interface::template is_complete<T>;
+
+      using alloc_interface::allocator_ref;
+      using alloc_interface::construct;
+      using alloc_interface::destroy;
+      using alloc_interface::destroy_range;
+      using alloc_interface::external_range_length;
+      using alloc_interface::internal_range_length;
+      using alloc_interface::to_address;
+      using alloc_interface::unchecked_advance;
+      using alloc_interface::unchecked_next;
+      using alloc_interface::unchecked_prev;
+      using alloc_interface::uninitialized_copy;
+      using alloc_interface::uninitialized_fill;
+      using alloc_interface::uninitialized_value_construct;
+      using alloc_interface::uninitialized_default_construct;
+
+      template <typename Integer>
+      GCH_NODISCARD
+      static GCH_CONSTEVAL
+      std::size_t
+      numeric_max (void) noexcept
+      {
+        return alloc_interface::template numeric_max<Integer> ();
+      }
+
+      GCH_NODISCARD
+      static GCH_CONSTEVAL
+      size_ty
+      get_inline_capacity (void) noexcept
+      {
+        return static_cast<size_ty> (InlineCapacity);
+      }
+
+      template <typename ...>
+      using void_t = void;
+
+      template <bool B>
+      using bool_constant = std::integral_constant<bool, B>;
+
+      template <typename Void, typename AI, typename V, typename ...Args>
+      struct is_emplace_constructible_impl
+        : std::false_type
+      {
+        using nothrow = std::false_type;
+      };
+
+      template <typename AI, typename V, typename ...Args>
+      struct is_emplace_constructible_impl<
+            void_t<typename std::enable_if<is_complete<V>::value>::type,
+                   decltype (std::declval<AI&> ().construct (std::declval<V *> (),
+                                                             std::declval<Args> ()...))>,
+            AI, V, Args...>
+        : std::true_type
+      {
+        using nothrow =
+          bool_constant<noexcept (std::declval<AI&> ().construct (std::declval<V *> (),
+                                                                  std::declval<Args> ()...))>;
+      };
+
+      template <typename ...Args>
+      struct is_emplace_insertable
+        : is_emplace_constructible_impl<void, alloc_interface, value_ty, Args...>
+      { };
+
+      template <typename ...Args>
+      struct is_nothrow_emplace_insertable
+        : is_emplace_insertable<Args...>::nothrow
+      { };
+
+      template <typename V = value_ty>
       struct is_explicitly_move_insertable
         : is_emplace_insertable<V&&>
       { };
@@ -2497,7 +3747,10 @@ namespace gch
         : std::true_type
 #else
         : bool_constant<std::is_nothrow_move_constructible<V>::value
-                    ||! is_explicitly_copy_insertable<V>::value>
+                    ||! is_explicitly_copy_insertable<V>::value
+                    ||  always_relocate_with_move<V>::value
+                    ||  std::is_same<typename Options::exception_guarantee,
+                                     small_vector_exception_guarantee::basic>::value>
 #endif
       { };
 
@@ -2528,6 +3781,16 @@ namespace gch
       using is_memcpyable_iterator =
         typename alloc_interface::template is_memcpyable_iterator<Args...>;
 
+      // Whether the inline storage shared with a vector of inline capacity `I` is small enough to
+      // be copied as a single block of a fixed size.
+      template <unsigned I, std::size_t Count = (I < InlineCapacity ? I : InlineCapacity)>
+      struct is_block_copyable
+        : bool_constant<alloc_interface::template is_uninitialized_memcpyable<
+                          value_ty, const value_ty&>::value
+                    &&  0 < Count
+                    &&  Count * sizeof (value_ty) <= GCH_SMALL_VECTOR_MAX_BLOCK_COPY_SIZE>
+      { };
+
       GCH_NORETURN
       static GCH_CPP20_CONSTEXPR
       void
@@ -2556,6 +3819,41 @@ namespace gch
 #endif
       }
 
+      // Counts are given as the `size_type` of the allocator, which may be wider than `size_type`.
+      // A count which `size_type` cannot represent exceeds the maximum size.
+      GCH_NODISCARD
+      static constexpr
+      bool
+      is_representable_count (alloc_size_type count) noexcept
+      {
+        return count <= (std::numeric_limits<size_type>::max) ();
+      }
+
+      GCH_NODISCARD
+      static GCH_CPP20_CONSTEXPR
+      size_ty
+      checked_count (alloc_size_type count)
+      {
+        if (! is_representable_count (count))
+          throw_allocation_size_error ();
+        return static_cast<size_ty> (count);
+      }
+
+      GCH_NORETURN
+      static GCH_CPP20_CONSTEXPR
+      void
+      throw_overwrite_count_error (void)
+      {
+#ifdef GCH_EXCEPTIONS
+        throw std::length_error ("The operation kept more elements than it was given.");
+#else
+        std::fprintf (
+          stderr,
+          "[gch::small_vector] The operation kept more elements than it was given.\n");
+        std::abort ();
+#endif
+      }
+
       GCH_NODISCARD GCH_CPP14_CONSTEXPR
       ptr
       ptr_cast (const small_vector_iterator<cptr, diff_ty>& it) noexcept
@@ -2603,18 +3901,21 @@ namespace gch
         }
 
       private:
+        // The pointers may be fancy pointers, so we convert through `std::pointer_traits`.
         GCH_NODISCARD GCH_CPP20_CONSTEXPR
         cptr
         get_pointer (void) const noexcept
         {
-          return static_cast<cptr> (static_cast<const void *> (std::addressof (m_data)));
+          return std::pointer_traits<cptr>::pointer_to (
+            *static_cast<const value_ty *> (static_cast<const void *> (std::addressof (m_data))));
         }
 
         GCH_NODISCARD GCH_CPP20_CONSTEXPR
         ptr
         get_pointer (void) noexcept
         {
-          return static_cast<ptr> (static_cast<void *> (std::addressof (m_data)));
+          return std::pointer_traits<ptr>::pointer_to (
+            *static_cast<value_ty *> (static_cast<void *> (std::addressof (m_data))));
         }
 
         alloc_interface& m_interface;
@@ -2724,18 +4025,109 @@ namespace gch
         m_data.set (data_ptr, static_cast<size_type> (capacity), static_cast<size_type> (size));
       }
 
+      // Same as `reset_data`, but for when the elements were moved out with
+      // `uninitialized_relocate`.
+      GCH_CPP20_CONSTEXPR
+      void
+      reset_relocated_data (ptr new_data_ptr, size_ty new_capacity, size_ty new_size)
+      {
+        destroy_relocated (begin_ptr (), end_ptr ());
+        if (has_allocation ())
+          deallocate (data_ptr (), get_capacity ());
+
+        m_data.set (new_data_ptr,
+                    static_cast<size_type> (new_capacity),
+                    static_cast<size_type> (new_size));
+      }
+
       GCH_CPP20_CONSTEXPR
       void
       increase_size (size_ty n) noexcept
       {
-        m_data.set_size (get_size () + n);
+        m_data.set_size (static_cast<size_type> (get_size () + n));
       }
 
       GCH_CPP20_CONSTEXPR
       void
       decrease_size (size_ty n) noexcept
       {
-        m_data.set_size (get_size () - n);
+        m_data.set_size (static_cast<size_type> (get_size () - n));
+      }
+
+      // The number of elements in front of each allocation which are reserved by the layout.
+      GCH_NODISCARD
+      static constexpr
+      size_ty
+      get_allocation_offset (void) noexcept
+      {
+        return static_cast<size_ty> (data_ty::allocation_offset ());
+      }
+
+      // All allocations of elements go through these so that the layout can reserve space in front
+      // of the elements. `alloc` may be the allocator of another vector.
+      GCH_NODISCARD
+      static GCH_CPP20_CONSTEXPR
+      ptr
+      allocate_with (alloc_interface& alloc, size_ty n)
+      {
+        return unchecked_next (alloc.allocate (n + get_allocation_offset ()),
+                               get_allocation_offset ());
+      }
+
+      static GCH_CPP20_CONSTEXPR
+      void
+      deallocate_with (alloc_interface& alloc, ptr p, size_ty n)
+      {
+        alloc.deallocate (unchecked_prev (p, get_allocation_offset ()),
+                          n + get_allocation_offset ());
+      }
+
+      GCH_NODISCARD GCH_CPP20_CONSTEXPR
+      ptr
+      allocate (size_ty n)
+      {
+        return allocate_with (*this, n);
+      }
+
+      GCH_NODISCARD GCH_CPP20_CONSTEXPR
+      ptr
+      allocate_with_hint (size_ty n, cptr hint)
+      {
+        return unchecked_next (
+          alloc_interface::allocate_with_hint (n + get_allocation_offset (), hint),
+          get_allocation_offset ());
+      }
+
+      GCH_NODISCARD GCH_CPP20_CONSTEXPR
+      allocation_result<ptr, alloc_size_type>
+      allocate_at_least (size_ty n)
+      {
+        return offset_allocation (
+          alloc_interface::allocate_at_least (n + get_allocation_offset ()));
+      }
+
+      GCH_NODISCARD GCH_CPP20_CONSTEXPR
+      allocation_result<ptr, alloc_size_type>
+      allocate_at_least (size_ty n, cptr hint)
+      {
+        return offset_allocation (
+          alloc_interface::allocate_at_least (n + get_allocation_offset (), hint));
+      }
+
+      GCH_NODISCARD
+      static GCH_CPP20_CONSTEXPR
+      allocation_result<ptr, alloc_size_type>
+      offset_allocation (allocation_result<ptr, alloc_size_type> result) noexcept
+      {
+        return { unchecked_next (result.ptr, get_allocation_offset ()),
+                 static_cast<alloc_size_type> (result.count - get_allocation_offset ()) };
+      }
+
+      GCH_CPP20_CONSTEXPR
+      void
+      deallocate (ptr p, size_ty n)
+      {
+        deallocate_with (*this, p, n);
       }
 
       GCH_CPP20_CONSTEXPR
@@ -2743,7 +4135,7 @@ namespace gch
       unchecked_allocate (size_ty n)
       {
         assert (InlineCapacity < n && "Allocated capacity should be greater than InlineCapacity.");
-        return alloc_interface::allocate (n);
+        return allocate (n);
       }
 
       GCH_CPP20_CONSTEXPR
@@ -2751,7 +4143,7 @@ namespace gch
       unchecked_allocate (size_ty n, cptr hint)
       {
         assert (InlineCapacity < n && "Allocated capacity should be greater than InlineCapacity.");
-        return alloc_interface::allocate_with_hint (n, hint);
+        return allocate_with_hint (n, hint);
       }
 
       GCH_CPP20_CONSTEXPR
@@ -2763,22 +4155,159 @@ namespace gch
         return unchecked_allocate (n);
       }
 
+      // Allocates space for at least `n` elements and updates `n` with the usable capacity.
+      GCH_CPP20_CONSTEXPR
+      ptr
+      unchecked_allocate_at_least (size_ty& n)
+      {
+        assert (InlineCapacity < n && "Allocated capacity should be greater than InlineCapacity.");
+        const auto result = allocate_at_least (n);
+        n = get_usable_capacity (n, result.count);
+        return result.ptr;
+      }
+
+      GCH_CPP20_CONSTEXPR
+      ptr
+      unchecked_allocate_at_least (size_ty& n, cptr hint)
+      {
+        assert (InlineCapacity < n && "Allocated capacity should be greater than InlineCapacity.");
+        const auto result = allocate_at_least (n, hint);
+        n = get_usable_capacity (n, result.count);
+        return result.ptr;
+      }
+
+      // Like `unchecked_allocate_at_least`, but a null pointer is returned if the allocation fails.
+      GCH_CPP20_CONSTEXPR
+      ptr
+      try_allocate_at_least (size_ty& n, cptr hint)
+      {
+        assert (InlineCapacity < n && "Allocated capacity should be greater than InlineCapacity.");
+        const auto result =
+          alloc_interface::try_allocate_at_least (n + get_allocation_offset (), hint);
+        if (result.ptr == nullptr)
+          return nullptr;
+
+        const auto offset_result = offset_allocation (result);
+        n = get_usable_capacity (n, offset_result.count);
+        return offset_result.ptr;
+      }
+
+      // Whether the allocation may be grown with the allocator's `reallocate`. This carries the
+      // elements over with their bytes, so it requires that they may be relocated with `memcpy`.
+      GCH_NODISCARD GCH_CPP20_CONSTEXPR
+      bool
+      can_reallocate (void) const noexcept
+      {
+        return alloc_interface::template is_reallocatable<>::value
+           &&  can_relocate_bytes ()
+           &&  has_allocation ();
+      }
+
+      // Grows the allocation to at least `n` elements with `reallocate`, and updates `n` with the
+      // usable capacity.
+      // Precondition: can_reallocate ()
+      template <typename A = alloc_ty,
+                typename std::enable_if<
+                  alloc_interface::template is_reallocatable<A>::value
+                >::type * = nullptr>
+      GCH_CPP20_CONSTEXPR
+      void
+      reallocate_allocation (size_ty& n)
+      {
+        assert (get_capacity () < n && "The allocation should only be grown.");
+
+        // The size may be stored in the allocation, so we read it first.
+        const size_ty size = get_size ();
+        const auto    result = offset_allocation (alloc_interface::reallocate (
+          unchecked_prev (data_ptr (), get_allocation_offset ()),
+          get_capacity () + get_allocation_offset (),
+          n + get_allocation_offset ()));
+
+        n = get_usable_capacity (n, result.count);
+        set_data (result.ptr, n, size);
+      }
+
+      // Never called, since `can_reallocate` is false.
+      template <typename A = alloc_ty,
+                typename std::enable_if<
+                  ! alloc_interface::template is_reallocatable<A>::value
+                >::type * = nullptr>
+      GCH_CPP20_CONSTEXPR
+      void
+      reallocate_allocation (size_ty&) noexcept
+      { }
+
+      // Whether elements initialized with `ValueT...` may be left as memory from
+      // `allocate_zeroed`. This is only the case for value-initialization.
+      template <typename ...ValueT>
+      GCH_NODISCARD
+      static constexpr
+      bool
+      can_allocate_zeroed (void) noexcept
+      {
+        return sizeof... (ValueT) == 0
+           &&  alloc_interface::template is_zero_allocatable<>::value;
+      }
+
+      // Allocates space for `n` value-initialized elements with `allocate_zeroed`.
+      // Precondition: can_allocate_zeroed ()
+      template <typename A = alloc_ty,
+                typename std::enable_if<
+                  alloc_interface::template is_zero_allocatable<A>::value
+                >::type * = nullptr>
+      GCH_CPP20_CONSTEXPR
+      ptr
+      unchecked_allocate_zeroed (size_ty n)
+      {
+        assert (InlineCapacity < n && "Allocated capacity should be greater than InlineCapacity.");
+        return unchecked_next (alloc_interface::allocate_zeroed (n + get_allocation_offset ()),
+                               get_allocation_offset ());
+      }
+
+      // Never called, since `can_allocate_zeroed` is false.
+      template <typename A = alloc_ty,
+                typename std::enable_if<
+                  ! alloc_interface::template is_zero_allocatable<A>::value
+                >::type * = nullptr>
+      GCH_CPP20_CONSTEXPR
+      ptr
+      unchecked_allocate_zeroed (size_ty n)
+      {
+        return unchecked_allocate (n);
+      }
+
+      GCH_NODISCARD GCH_CPP20_CONSTEXPR
+      size_ty
+      get_usable_capacity (size_ty requested, alloc_size_type allocated) const noexcept
+      {
+        assert (requested <= allocated && "The allocator returned less than was requested.");
+        static_cast<void> (requested);
+
+        // Cap the recorded capacity so that it is always representable.
+        const size_ty max_size = get_max_size ();
+        return allocated < max_size ? static_cast<size_ty> (allocated) : max_size;
+      }
+
     protected:
+      GCH_NODISCARD GCH_CPP20_CONSTEXPR
+      size_ty
+      get_max_size (void) const noexcept
+      {
+        return alloc_interface::get_max_size () - get_allocation_offset ();
+      }
+
       GCH_NODISCARD GCH_CPP14_CONSTEXPR
       size_ty
       calculate_new_capacity (const size_ty current, const size_ty required) const noexcept
       {
         assert (current < required);
+        assert (required <= get_max_size ());
 
-        if (get_max_size () - current <= current)
-          return get_max_size ();
-
-        // Note: This growth factor might be theoretically superior, but in testing it falls flat:
-        // size_ty new_capacity = current + (current / 2);
+        const size_ty new_capacity =
+          growth_policy::template calculate_new_capacity<value_ty> (current, required,
+                                                                     get_max_size ());
 
-        const size_ty new_capacity = 2 * current;
-        if (new_capacity < required)
-          return required;
+        assert (required <= new_capacity && new_capacity <= get_max_size ());
         return new_capacity;
       }
 
@@ -2890,16 +4419,19 @@ namespace gch
         }
       }
 
+      // Moves the elements in [first, last), which belong to `other`. These are passed separately
+      // for when the allocation of `other` has been overwritten by its inline storage.
       template <unsigned N, typename A = alloc_ty,
         typename std::enable_if<allocators_always_equal<A>::value>::type * = nullptr>
       GCH_CPP20_CONSTEXPR
       void
-      overwrite_existing_elements (small_vector_base<Allocator, N>&& other)
+      overwrite_existing_elements (small_vector_base<Allocator, N, Options>&&,
+                                   ptr first, ptr last)
       {
         return overwrite_existing_elements (
-          std::make_move_iterator (other.begin_ptr ()),
-          std::make_move_iterator (other.end_ptr ()),
-          other.get_size ()
+          std::make_move_iterator (first),
+          std::make_move_iterator (last),
+          internal_range_length (first, last)
         );
       }
 
@@ -2907,25 +4439,34 @@ namespace gch
         typename std::enable_if<! allocators_always_equal<A>::value>::type * = nullptr>
       GCH_CPP20_CONSTEXPR
       void
-      overwrite_existing_elements (small_vector_base<Allocator, N>&& other)
+      overwrite_existing_elements (small_vector_base<Allocator, N, Options>&& other,
+                                   ptr first, ptr last)
       {
         if (allocator_ref () == other.allocator_ref ())
         {
           overwrite_existing_elements (
-            std::make_move_iterator (other.begin_ptr ()),
-            std::make_move_iterator (other.end_ptr ()),
-            other.get_size ()
+            std::make_move_iterator (first),
+            std::make_move_iterator (last),
+            internal_range_length (first, last)
           );
           return;
         }
 
         overwrite_existing_elements_with_allocator (
-          std::make_move_iterator (other.begin_ptr ()),
-          std::make_move_iterator (other.end_ptr ()),
+          std::make_move_iterator (first),
+          std::make_move_iterator (last),
           other
         );
       }
 
+      template <unsigned N>
+      GCH_CPP20_CONSTEXPR
+      void
+      overwrite_existing_elements (small_vector_base<Allocator, N, Options>&& other)
+      {
+        overwrite_existing_elements (std::move (other), other.begin_ptr (), other.end_ptr ());
+      }
+
       template <typename ForwardIt>
       GCH_CPP20_CONSTEXPR
       small_vector_base&
@@ -2935,7 +4476,7 @@ namespace gch
         if (InlineCapacity < count)
         {
           const size_ty new_capacity = calculate_new_capacity (InlineCapacity, count);
-          const ptr     new_data_ptr = alloc.allocate (new_capacity);
+          const ptr     new_data_ptr = allocate_with (alloc, new_capacity);
 
           GCH_TRY
           {
@@ -2943,7 +4484,7 @@ namespace gch
           }
           GCH_CATCH (...)
           {
-            alloc.deallocate (new_data_ptr, new_capacity);
+            deallocate_with (alloc, new_data_ptr, new_capacity);
             GCH_THROW;
           }
 
@@ -2956,12 +4497,27 @@ namespace gch
           ptr new_data_ptr = storage_ptr ();
 #ifdef GCH_LIB_IS_CONSTANT_EVALUATED
           if (std::is_constant_evaluated ())
-            new_data_ptr = alloc.allocate (InlineCapacity);
+            new_data_ptr = allocate_with (alloc, InlineCapacity);
 #endif
 
-          alloc.uninitialized_copy (first, last, new_data_ptr);
-          destroy_range (begin_ptr (), end_ptr ());
-          deallocate (begin_ptr (), get_capacity ());
+          // The allocation may share space with the inline storage, so hold onto it.
+          const ptr     old_data_ptr = data_ptr ();
+          const ptr     old_end_ptr  = end_ptr ();
+          const size_ty old_capacity = get_capacity ();
+
+          GCH_TRY
+          {
+            alloc.uninitialized_copy (first, last, new_data_ptr);
+          }
+          GCH_CATCH (...)
+          {
+            set_data_ptr (old_data_ptr);
+            set_capacity (old_capacity);
+            GCH_THROW;
+          }
+
+          destroy_range (old_data_ptr, old_end_ptr);
+          deallocate (old_data_ptr, old_capacity);
           set_data_ptr (new_data_ptr);
           set_capacity (InlineCapacity);
         }
@@ -2976,13 +4532,23 @@ namespace gch
       template <unsigned N>
       GCH_CPP20_CONSTEXPR
       small_vector_base&
-      copy_assign_equal_or_non_propagated_allocators (const small_vector_base<Allocator, N>& other)
+      copy_assign_equal_or_non_propagated_allocators (
+        const small_vector_base<Allocator, N, Options>& other)
       {
-        assign_with_range (
-          other.begin_ptr (),
-          other.end_ptr (),
-          std::random_access_iterator_tag {}
-        );
+        if (! has_allocation () && can_copy_block (other))
+        {
+          // The elements are trivially copyable, so we may overwrite them without destroying them.
+          copy_block (other);
+          set_size (other.get_size ());
+        }
+        else
+        {
+          assign_with_range (
+            other.begin_ptr (),
+            other.end_ptr (),
+            std::random_access_iterator_tag {}
+          );
+        }
         alloc_interface::maybe_copy (other);
         return *this;
       }
@@ -2990,7 +4556,8 @@ namespace gch
       template <unsigned N>
       GCH_CPP20_CONSTEXPR
       small_vector_base&
-      copy_assign_unequal_and_propagated_allocators (const small_vector_base<Allocator, N>& other)
+      copy_assign_unequal_and_propagated_allocators (
+        const small_vector_base<Allocator, N, Options>& other)
       {
         // Note: We have to create a new alloc_interface here because `other` is const.
         alloc_interface alloc { other.allocator_ref () };
@@ -3005,7 +4572,7 @@ namespace gch
           >::type * = nullptr>
       GCH_CPP20_CONSTEXPR
       small_vector_base&
-      copy_assign (const small_vector_base<Allocator, N>& other)
+      copy_assign (const small_vector_base<Allocator, N, Options>& other)
       {
         return copy_assign_equal_or_non_propagated_allocators (other);
       }
@@ -3017,7 +4584,7 @@ namespace gch
           >::type * = nullptr>
       GCH_CPP20_CONSTEXPR
       small_vector_base&
-      copy_assign (const small_vector_base<Allocator, N>& other)
+      copy_assign (const small_vector_base<Allocator, N, Options>& other)
       {
         if (allocator_ref () == other.allocator_ref ())
           return copy_assign_equal_or_non_propagated_allocators (other);
@@ -3027,7 +4594,7 @@ namespace gch
       template <unsigned N>
       GCH_CPP20_CONSTEXPR
       small_vector_base&
-      move_assign_pointer (small_vector_base<Allocator, N>& other) noexcept
+      move_assign_pointer (small_vector_base<Allocator, N, Options>& other) noexcept
       {
         reset_data (other.begin_ptr (), other.get_capacity (), other.get_size ());
         other.set_default ();
@@ -3038,7 +4605,8 @@ namespace gch
       template <unsigned N>
       GCH_CPP20_CONSTEXPR
       small_vector_base&
-      move_assign_equal_or_non_propagated_allocators (small_vector_base<Allocator, N>& other)
+      move_assign_equal_or_non_propagated_allocators (
+        small_vector_base<Allocator, N, Options>& other)
       {
         assign_with_range (
           std::make_move_iterator (other.begin_ptr ()),
@@ -3052,7 +4620,8 @@ namespace gch
       template <unsigned N>
       GCH_CPP20_CONSTEXPR
       small_vector_base&
-      move_assign_unequal_and_propagated_allocators (small_vector_base<Allocator, N>& other)
+      move_assign_unequal_and_propagated_allocators (
+        small_vector_base<Allocator, N, Options>& other)
       {
         assign_with_range_with_allocator (
           std::make_move_iterator (other.begin_ptr ()),
@@ -3073,9 +4642,9 @@ namespace gch
       template <unsigned N>
       GCH_CPP20_CONSTEXPR
       small_vector_base&
-      move_assign_equal_allocators (small_vector_base<Allocator, N>& other)
+      move_assign_equal_allocators (small_vector_base<Allocator, N, Options>& other)
       {
-        if (other.has_allocation () && InlineCapacity < other.get_capacity ())
+        if (can_take_allocation (other))
           return move_assign_pointer (other);
         else
           return move_assign_equal_or_non_propagated_allocators (other);
@@ -3099,9 +4668,9 @@ namespace gch
         >::type * = nullptr>
       GCH_CPP20_CONSTEXPR
       small_vector_base&
-      move_assign_unequal_allocators (small_vector_base<Allocator, N>& other)
+      move_assign_unequal_allocators (small_vector_base<Allocator, N, Options>& other)
       {
-        if (other.has_allocation () && InlineCapacity < other.get_capacity ())
+        if (can_take_allocation (other))
           return move_assign_pointer (other);
         else
           return move_assign_unequal_and_propagated_allocators (other);
@@ -3113,7 +4682,7 @@ namespace gch
         >::type * = nullptr>
       GCH_CPP20_CONSTEXPR
       small_vector_base&
-      move_assign_unequal_allocators (small_vector_base<Allocator, N>& other)
+      move_assign_unequal_allocators (small_vector_base<Allocator, N, Options>& other)
       {
         // We cannot move an allocation pointer in this case, so go directly to the inner function.
         return move_assign_equal_or_non_propagated_allocators (other);
@@ -3123,7 +4692,7 @@ namespace gch
         typename std::enable_if<allocators_always_equal<A>::value>::type * = nullptr>
       GCH_CPP20_CONSTEXPR
       small_vector_base&
-      move_assign (small_vector_base<Allocator, N>& other)
+      move_assign (small_vector_base<Allocator, N, Options>& other)
       {
         return move_assign_equal_allocators (other);
       }
@@ -3132,7 +4701,7 @@ namespace gch
         typename std::enable_if<! allocators_always_equal<A>::value>::type * = nullptr>
       GCH_CPP20_CONSTEXPR
       small_vector_base&
-      move_assign (small_vector_base<Allocator, N>& other)
+      move_assign (small_vector_base<Allocator, N, Options>& other)
       {
         if (allocator_ref () == other.allocator_ref ())
           return move_assign_equal_allocators (other);
@@ -3153,10 +4722,10 @@ namespace gch
                 typename std::enable_if<(LessEqualI <= InlineCapacity)>::type * = nullptr>
       GCH_CPP20_CONSTEXPR
       void
-      move_initialize (small_vector_base<Allocator, LessEqualI>&& other)
+      move_initialize (small_vector_base<Allocator, LessEqualI, Options>&& other)
         noexcept (std::is_nothrow_move_constructible<value_ty>::value)
       {
-        if (InlineCapacity < other.get_capacity ())
+        if (can_take_allocation (other))
         {
           set_data (other.data_ptr (), other.get_capacity (), other.get_size ());
           other.set_default ();
@@ -3164,7 +4733,10 @@ namespace gch
         else
         {
           set_to_inline_storage ();
-          uninitialized_move (other.begin_ptr (), other.end_ptr (), data_ptr ());
+          if (can_copy_block (other))
+            copy_block (other);
+          else
+            uninitialized_move (other.begin_ptr (), other.end_ptr (), data_ptr ());
           set_size (other.get_size ());
         }
       }
@@ -3173,7 +4745,7 @@ namespace gch
                 typename std::enable_if<(InlineCapacity < GreaterI)>::type * = nullptr>
       GCH_CPP20_CONSTEXPR
       void
-      move_initialize (small_vector_base<Allocator, GreaterI>&& other)
+      move_initialize (small_vector_base<Allocator, GreaterI, Options>&& other)
       {
         if (other.has_allocation ())
         {
@@ -3182,7 +4754,12 @@ namespace gch
         }
         else
         {
-          if (InlineCapacity < other.get_size ())
+          if (can_copy_block (other))
+          {
+            set_to_inline_storage ();
+            copy_block (other);
+          }
+          else if (InlineCapacity < other.get_size ())
           {
             // We may throw in this case.
             set_data_ptr (unchecked_allocate (other.get_size (), other.allocation_end_ptr ()));
@@ -3226,10 +4803,16 @@ namespace gch
 
       template <unsigned I, typename A>
       GCH_CPP20_CONSTEXPR
-      small_vector_base (bypass_tag, const small_vector_base<Allocator, I>& other, const A& alloc)
+      small_vector_base (bypass_tag, const small_vector_base<Allocator, I, Options>& other,
+                         const A& alloc)
         : alloc_interface (alloc)
       {
-        if (InlineCapacity < other.get_size ())
+        if (can_copy_block (other))
+        {
+          set_to_inline_storage ();
+          copy_block (other);
+        }
+        else if (InlineCapacity < other.get_size ())
         {
           set_data_ptr (unchecked_allocate (other.get_size (), other.allocation_end_ptr ()));
           set_capacity (other.get_size ());
@@ -3255,13 +4838,13 @@ namespace gch
 
       template <unsigned I>
       GCH_CPP20_CONSTEXPR
-      small_vector_base (bypass_tag, const small_vector_base<Allocator, I>& other)
+      small_vector_base (bypass_tag, const small_vector_base<Allocator, I, Options>& other)
         : small_vector_base (bypass, other, static_cast<const alloc_interface &> (other))
       {}
 
       template <unsigned I>
       GCH_CPP20_CONSTEXPR
-      small_vector_base (bypass_tag, small_vector_base<Allocator, I>&& other)
+      small_vector_base (bypass_tag, small_vector_base<Allocator, I, Options>&& other)
         noexcept (std::is_nothrow_move_constructible<value_ty>::value
               ||  (I == 0 && I == InlineCapacity))
         : alloc_interface (std::move (other))
@@ -3272,7 +4855,8 @@ namespace gch
       template <unsigned I, typename A = alloc_ty,
                 typename std::enable_if<allocators_always_equal<A>::value>::type * = nullptr>
       GCH_CPP20_CONSTEXPR
-      small_vector_base (bypass_tag, small_vector_base<Allocator, I>&& other, const alloc_ty&)
+      small_vector_base (bypass_tag, small_vector_base<Allocator, I, Options>&& other,
+                         const alloc_ty&)
         noexcept (noexcept (small_vector_base (bypass, std::move (other))))
         : small_vector_base (bypass, std::move (other))
       { }
@@ -3280,7 +4864,8 @@ namespace gch
       template <unsigned I, typename A = alloc_ty,
                 typename std::enable_if<! allocators_always_equal<A>::value>::type * = nullptr>
       GCH_CPP20_CONSTEXPR
-      small_vector_base (bypass_tag, small_vector_base<Allocator, I>&& other, const alloc_ty& alloc)
+      small_vector_base (bypass_tag, small_vector_base<Allocator, I, Options>&& other,
+                         const alloc_ty& alloc)
         : alloc_interface (alloc)
       {
         if (other.allocator_ref () == alloc)
@@ -3321,10 +4906,48 @@ namespace gch
         set_default ();
       }
 
+      GCH_CPP20_CONSTEXPR
+      small_vector_base (adopt_allocation_t, ptr p, size_ty size, size_ty capacity,
+                         const alloc_ty& alloc)
+        : alloc_interface (alloc)
+      {
+        static_assert (! std::is_same<typename Options::layout,
+                                      small_vector_layout::heap_header>::value,
+                       "Allocations cannot be adopted with the `heap_header` layout.");
+
+        assert (size <= capacity && "The size should not exceed the capacity.");
+
+        if (InlineCapacity < capacity)
+        {
+          set_data (p, capacity, size);
+          return;
+        }
+
+        // The allocation would not be recognized as one, so the elements are moved into the inline
+        // storage instead. If this throws, the caller keeps ownership of `p`.
+        set_to_inline_storage ();
+        uninitialized_relocate (p, unchecked_next (p, size), data_ptr ());
+        destroy_relocated (p, unchecked_next (p, size));
+        if (p != nullptr)
+          deallocate (p, capacity);
+        set_size (size);
+      }
+
       GCH_CPP20_CONSTEXPR
       small_vector_base (size_ty count, const alloc_ty& alloc)
         : alloc_interface (alloc)
       {
+        if (InlineCapacity < count && can_allocate_zeroed ())
+        {
+          // The elements are already value-initialized.
+          if (get_max_size () < count)
+            throw_allocation_size_error ();
+          set_data_ptr (unchecked_allocate_zeroed (count));
+          set_capacity (count);
+          set_size (count);
+          return;
+        }
+
         if (InlineCapacity < count)
         {
           set_data_ptr (checked_allocate (count));
@@ -3371,6 +4994,31 @@ namespace gch
         set_size (count);
       }
 
+      GCH_CPP20_CONSTEXPR
+      small_vector_base (size_ty count, for_overwrite_t, const alloc_ty& alloc)
+        : alloc_interface (alloc)
+      {
+        if (InlineCapacity < count)
+        {
+          set_data_ptr (checked_allocate (count));
+          set_capacity (count);
+        }
+        else
+          set_to_inline_storage ();
+
+        GCH_TRY
+        {
+          uninitialized_default_construct (begin_ptr (), unchecked_next (begin_ptr (), count));
+        }
+        GCH_CATCH (...)
+        {
+          if (has_allocation ())
+            deallocate (data_ptr (), get_capacity ());
+          GCH_THROW;
+        }
+        set_size (count);
+      }
+
       template <typename Generator>
       GCH_CPP20_CONSTEXPR
       small_vector_base (size_ty count, Generator& g, const alloc_ty& alloc)
@@ -3462,12 +5110,14 @@ namespace gch
       void
       set_to_inline_storage (void)
       {
-        set_capacity (InlineCapacity);
+        ptr new_data_ptr = storage_ptr ();
 #ifdef GCH_LIB_IS_CONSTANT_EVALUATED
-        if (std::is_constant_evaluated ())
-          return set_data_ptr (alloc_interface::allocate (InlineCapacity));
+        if (std::is_constant_evaluated () &&! has_constexpr_inline_storage<data_ty>::value)
+          new_data_ptr = allocate (InlineCapacity);
 #endif
-        set_data_ptr (storage_ptr ());
+        // The data pointer is set first since it decides where the capacity is stored.
+        set_data_ptr (new_data_ptr);
+        set_capacity (InlineCapacity);
       }
 
       GCH_CPP20_CONSTEXPR
@@ -3477,7 +5127,7 @@ namespace gch
         if (get_capacity () < count)
         {
           size_ty new_capacity = checked_calculate_new_capacity (count);
-          ptr     new_begin    = unchecked_allocate (new_capacity);
+          ptr     new_begin    = unchecked_allocate_at_least (new_capacity);
 
           GCH_TRY
           {
@@ -3533,7 +5183,7 @@ namespace gch
         if (get_capacity () < count)
         {
           size_ty new_capacity = checked_calculate_new_capacity (count);
-          ptr     new_begin    = unchecked_allocate (new_capacity);
+          ptr     new_begin    = unchecked_allocate_at_least (new_capacity);
 
           GCH_TRY
           {
@@ -3559,9 +5209,24 @@ namespace gch
             new_begin = this->allocate (InlineCapacity);
 #endif
 
-          uninitialized_copy (first, last, new_begin);
-          destroy_range (begin_ptr (), end_ptr ());
-          deallocate (begin_ptr (), get_capacity ());
+          // The allocation may share space with the inline storage, so hold onto it.
+          const ptr     old_data_ptr = data_ptr ();
+          const ptr     old_end_ptr  = end_ptr ();
+          const size_ty old_capacity = get_capacity ();
+
+          GCH_TRY
+          {
+            uninitialized_copy (first, last, new_begin);
+          }
+          GCH_CATCH (...)
+          {
+            set_data_ptr (old_data_ptr);
+            set_capacity (old_capacity);
+            GCH_THROW;
+          }
+
+          destroy_range (old_data_ptr, old_end_ptr);
+          deallocate (old_data_ptr, old_capacity);
           set_data_ptr (new_begin);
           set_capacity (InlineCapacity);
         }
@@ -3618,6 +5283,55 @@ namespace gch
         return uninitialized_copy (first, last, d_first);
       }
 
+      // Whether elements may be relocated by copying their bytes.
+      GCH_NODISCARD
+      static GCH_CPP20_CONSTEXPR
+      bool
+      can_relocate_bytes (void) noexcept
+      {
+#ifdef GCH_LIB_IS_CONSTANT_EVALUATED
+        if (std::is_constant_evaluated ())
+          return false;
+#endif
+        return alloc_interface::template is_uninitialized_relocatable<>::value;
+      }
+
+      // Relocates [first, last) to `d_first` by copying bytes. The ranges may overlap.
+      // Precondition: can_relocate_bytes ()
+      static
+      ptr
+      relocate_bytes (ptr first, ptr last, ptr d_first) noexcept
+      {
+        const size_ty num_relocate = internal_range_length (first, last);
+        if (num_relocate != 0)
+        {
+          std::memmove (static_cast<void *> (to_address (d_first)),
+                        static_cast<const void *> (to_address (first)),
+                        num_relocate * sizeof (value_ty));
+        }
+        return unchecked_next (d_first, num_relocate);
+      }
+
+      // Moves [first, last) into uninitialized memory. Afterwards, the source range must be
+      // cleaned up with `destroy_relocated`.
+      template <typename Policy = void>
+      GCH_CPP20_CONSTEXPR
+      ptr
+      uninitialized_relocate (ptr first, ptr last, ptr d_first)
+      {
+        if (can_relocate_bytes ())
+          return relocate_bytes (first, last, d_first);
+        return uninitialized_move<Policy> (first, last, d_first);
+      }
+
+      GCH_CPP20_CONSTEXPR
+      void
+      destroy_relocated (ptr first, ptr last) noexcept
+      {
+        if (! can_relocate_bytes ())
+          destroy_range (first, last);
+      }
+
       GCH_CPP20_CONSTEXPR
       ptr
       shift_into_uninitialized (ptr pos, size_ty n_shift)
@@ -3660,13 +5374,13 @@ namespace gch
 
           // The check is handled by the if-guard.
           size_ty new_capacity = unchecked_calculate_new_capacity (new_size);
-          ptr     new_data_ptr = unchecked_allocate (new_capacity, allocation_end_ptr ());
+          ptr     new_data_ptr = unchecked_allocate_at_least (new_capacity, allocation_end_ptr ());
           ptr     new_last     = unchecked_next (new_data_ptr, original_size);
 
           GCH_TRY
           {
             new_last = uninitialized_fill (new_last, unchecked_next (new_last, count), val);
-            uninitialized_move (begin_ptr (), end_ptr (), new_data_ptr);
+            uninitialized_relocate (begin_ptr (), end_ptr (), new_data_ptr);
           }
           GCH_CATCH (...)
           {
@@ -3675,7 +5389,7 @@ namespace gch
             GCH_THROW;
           }
 
-          reset_data (new_data_ptr, new_capacity, new_size);
+          reset_relocated_data (new_data_ptr, new_capacity, new_size);
           return unchecked_next (new_data_ptr, original_size);
         }
         else
@@ -3742,13 +5456,13 @@ namespace gch
 
           // The check is handled by the if-guard.
           size_ty new_capacity = unchecked_calculate_new_capacity (new_size);
-          ptr     new_data_ptr = unchecked_allocate (new_capacity, allocation_end_ptr ());
+          ptr     new_data_ptr = unchecked_allocate_at_least (new_capacity, allocation_end_ptr ());
           ptr     new_last     = unchecked_next (new_data_ptr, original_size);
 
           GCH_TRY
           {
             new_last = uninitialized_copy (first, last, new_last);
-            uninitialized_move<MovePolicy> (begin_ptr (), end_ptr (), new_data_ptr);
+            uninitialized_relocate<MovePolicy> (begin_ptr (), end_ptr (), new_data_ptr);
           }
           GCH_CATCH (...)
           {
@@ -3757,16 +5471,266 @@ namespace gch
             GCH_THROW;
           }
 
-          reset_data (new_data_ptr, new_capacity, new_size);
+          reset_relocated_data (new_data_ptr, new_capacity, new_size);
           return unchecked_next (new_data_ptr, original_size);
         }
-        else
+        else
+        {
+          ptr ret = end_ptr ();
+          uninitialized_copy (first, last, ret);
+          increase_size (num_insert);
+          return ret;
+        }
+      }
+
+      template <typename InputIt>
+      GCH_CPP20_CONSTEXPR
+      ptr
+      append_range_unchecked (InputIt first, InputIt last, std::input_iterator_tag)
+      {
+        size_ty original_size = get_size ();
+        GCH_TRY
+        {
+          for (; ! (first == last); ++first)
+          {
+            assert (get_size () < get_capacity () && "Appended past the end of the capacity.");
+            emplace_into_current_end (*first);
+          }
+        }
+        GCH_CATCH (...)
+        {
+          erase_range (unchecked_next (begin_ptr (), original_size), end_ptr ());
+          GCH_THROW;
+        }
+        return unchecked_next (begin_ptr (), original_size);
+      }
+
+      template <typename ForwardIt>
+      GCH_CPP20_CONSTEXPR
+      ptr
+      append_range_unchecked (ForwardIt first, ForwardIt last, std::forward_iterator_tag)
+      {
+        const size_ty num_insert = external_range_length (first, last);
+        assert (num_insert <= num_uninitialized () && "Appended past the end of the capacity.");
+
+        ptr ret = end_ptr ();
+        uninitialized_copy (first, last, ret);
+        increase_size (num_insert);
+        return ret;
+      }
+
+      // The `try_` functions return a null pointer (or false) if the vector would need to grow but
+      // the capacity can't be allocated. The vector is unchanged in that case. Since an argument
+      // may refer to an element, it is copied to a temporary before we reallocate.
+
+      template <typename ...Args>
+      GCH_CPP20_CONSTEXPR
+      ptr
+      try_append_element (Args&&... args)
+      {
+        if (get_size () < get_capacity ())
+          return emplace_into_current_end (std::forward<Args> (args)...);
+
+        if (get_max_size () == get_size ())
+          return nullptr;
+
+#ifdef GCH_LIB_IS_CONSTANT_EVALUATED
+        if (std::is_constant_evaluated ())
+        {
+          heap_temporary tmp (*this, std::forward<Args> (args)...);
+          if (! try_request_capacity (get_size () + 1))
+            return nullptr;
+          return emplace_into_current_end (tmp.release ());
+        }
+#endif
+
+        stack_temporary tmp (*this, std::forward<Args> (args)...);
+        if (! try_request_capacity (get_size () + 1))
+          return nullptr;
+        return emplace_into_current_end (tmp.release ());
+      }
+
+      template <typename ...Args>
+      GCH_CPP20_CONSTEXPR
+      ptr
+      try_emplace_at (ptr pos, Args&&... args)
+      {
+        if (get_size () < get_capacity ())
+          return emplace_into_current (pos, std::forward<Args> (args)...);
+
+        if (get_max_size () == get_size ())
+          return nullptr;
+
+        const size_ty offset = internal_range_length (begin_ptr (), pos);
+
+#ifdef GCH_LIB_IS_CONSTANT_EVALUATED
+        if (std::is_constant_evaluated ())
+        {
+          heap_temporary tmp (*this, std::forward<Args> (args)...);
+          if (! try_request_capacity (get_size () + 1))
+            return nullptr;
+          return emplace_into_current (unchecked_next (begin_ptr (), offset), tmp.release ());
+        }
+#endif
+
+        stack_temporary tmp (*this, std::forward<Args> (args)...);
+        if (! try_request_capacity (get_size () + 1))
+          return nullptr;
+        return emplace_into_current (unchecked_next (begin_ptr (), offset), tmp.release ());
+      }
+
+      GCH_CPP20_CONSTEXPR
+      bool
+      try_insert_copies (ptr pos, size_ty count, const value_ty& val)
+      {
+        if (count <= num_uninitialized ())
+        {
+          insert_copies (pos, count, val);
+          return true;
+        }
+
+        if (get_max_size () - get_size () < count)
+          return false;
+
+        const size_ty offset = internal_range_length (begin_ptr (), pos);
+
+#ifdef GCH_LIB_IS_CONSTANT_EVALUATED
+        if (std::is_constant_evaluated ())
+        {
+          const heap_temporary tmp (*this, val);
+          if (! try_request_capacity (get_size () + count))
+            return false;
+          insert_copies (unchecked_next (begin_ptr (), offset), count, tmp.get ());
+          return true;
+        }
+#endif
+
+        const stack_temporary tmp (*this, val);
+        if (! try_request_capacity (get_size () + count))
+          return false;
+        insert_copies (unchecked_next (begin_ptr (), offset), count, tmp.get ());
+        return true;
+      }
+
+      template <typename InputIt>
+      GCH_CPP20_CONSTEXPR
+      bool
+      try_append_range (InputIt first, InputIt last, std::input_iterator_tag)
+      {
+        // Remove the new elements if we fail to allocate or if one of them throws.
+        const size_ty original_size = get_size ();
+        GCH_TRY
+        {
+          for (; ! (first == last); ++first)
+          {
+            if (try_append_element (*first) == nullptr)
+            {
+              erase_range (unchecked_next (begin_ptr (), original_size), end_ptr ());
+              return false;
+            }
+          }
+        }
+        GCH_CATCH (...)
+        {
+          erase_range (unchecked_next (begin_ptr (), original_size), end_ptr ());
+          GCH_THROW;
+        }
+        return true;
+      }
+
+      template <typename ForwardIt>
+      GCH_CPP20_CONSTEXPR
+      bool
+      try_append_range (ForwardIt first, ForwardIt last, std::forward_iterator_tag)
+      {
+        const size_ty num_insert = external_range_length (first, last);
+        if (get_max_size () - get_size () < num_insert
+            ||! try_request_capacity (get_size () + num_insert))
+        {
+          return false;
+        }
+
+        append_range_unchecked (first, last, std::forward_iterator_tag { });
+        return true;
+      }
+
+      template <typename InputIt>
+      GCH_CPP20_CONSTEXPR
+      bool
+      try_insert_range (ptr pos, InputIt first, InputIt last, std::input_iterator_tag)
+      {
+        // We don't know the length of the range, so append it and rotate it into place.
+        const size_ty offset        = internal_range_length (begin_ptr (), pos);
+        const size_ty original_size = get_size ();
+        if (! try_append_range (first, last, std::input_iterator_tag { }))
+          return false;
+
+        std::rotate (unchecked_next (begin_ptr (), offset),
+                     unchecked_next (begin_ptr (), original_size),
+                     end_ptr ());
+        return true;
+      }
+
+      template <typename ForwardIt>
+      GCH_CPP20_CONSTEXPR
+      bool
+      try_insert_range (ptr pos, ForwardIt first, ForwardIt last, std::forward_iterator_tag)
+      {
+        if (first == last)
+          return true;
+
+        const size_ty num_insert = external_range_length (first, last);
+        const size_ty offset     = internal_range_length (begin_ptr (), pos);
+        if (get_max_size () - get_size () < num_insert
+            ||! try_request_capacity (get_size () + num_insert))
+        {
+          return false;
+        }
+
+        insert_range (unchecked_next (begin_ptr (), offset), first, last,
+                      std::forward_iterator_tag { });
+        return true;
+      }
+
+      GCH_CPP20_CONSTEXPR
+      bool
+      try_resize_with (size_ty new_size)
+      {
+        if (! try_request_capacity (new_size))
+          return false;
+        resize_with (new_size);
+        return true;
+      }
+
+      GCH_CPP20_CONSTEXPR
+      bool
+      try_resize_with (size_ty new_size, const value_ty& val)
+      {
+        if (new_size <= get_capacity ())
+        {
+          resize_with (new_size, val);
+          return true;
+        }
+
+        if (get_max_size () < new_size)
+          return false;
+
+#ifdef GCH_LIB_IS_CONSTANT_EVALUATED
+        if (std::is_constant_evaluated ())
         {
-          ptr ret = end_ptr ();
-          uninitialized_copy (first, last, ret);
-          increase_size (num_insert);
-          return ret;
+          const heap_temporary tmp (*this, val);
+          if (! try_request_capacity (new_size))
+            return false;
+          resize_with (new_size, tmp.get ());
+          return true;
         }
+#endif
+
+        const stack_temporary tmp (*this, val);
+        if (! try_request_capacity (new_size))
+          return false;
+        resize_with (new_size, tmp.get ());
+        return true;
       }
 
       template <typename ...Args>
@@ -3806,19 +5770,20 @@ namespace gch
           const size_ty new_size = get_size () + count;
 
           // The check is handled by the if-guard.
-          const size_ty new_capacity = unchecked_calculate_new_capacity (new_size);
-          ptr new_data_ptr           = unchecked_allocate (new_capacity, allocation_end_ptr ());
-          ptr new_first              = unchecked_next (new_data_ptr, offset);
-          ptr new_last               = new_first;
+          size_ty new_capacity = unchecked_calculate_new_capacity (new_size);
+          ptr     new_data_ptr =
+            unchecked_allocate_at_least (new_capacity, allocation_end_ptr ());
+          ptr     new_first    = unchecked_next (new_data_ptr, offset);
+          ptr     new_last     = new_first;
 
           GCH_TRY
           {
             uninitialized_fill (new_first, unchecked_next (new_first, count), val);
             unchecked_advance  (new_last, count);
 
-            uninitialized_move (begin_ptr (), pos, new_data_ptr);
+            uninitialized_relocate (begin_ptr (), pos, new_data_ptr);
             new_first = new_data_ptr;
-            uninitialized_move (pos, end_ptr (), new_last);
+            uninitialized_relocate (pos, end_ptr (), new_last);
           }
           GCH_CATCH (...)
           {
@@ -3827,11 +5792,32 @@ namespace gch
             GCH_THROW;
           }
 
-          reset_data (new_data_ptr, new_capacity, new_size);
+          reset_relocated_data (new_data_ptr, new_capacity, new_size);
           return unchecked_next (begin_ptr (), offset);
         }
         else
         {
+          if (can_relocate_bytes ())
+          {
+            // We need to handle possible aliasing here.
+            const stack_temporary tmp (*this, val);
+
+            // Open a gap at `pos` and construct the new elements in it.
+            const ptr gap_end = unchecked_next (pos, count);
+            relocate_bytes (pos, end_ptr (), gap_end);
+            GCH_TRY
+            {
+              uninitialized_fill (pos, gap_end, tmp.get ());
+            }
+            GCH_CATCH (...)
+            {
+              relocate_bytes (gap_end, unchecked_next (end_ptr (), count), pos);
+              GCH_THROW;
+            }
+            increase_size (count);
+            return pos;
+          }
+
           // If we have fewer to insert than tailing elements after `pos`, we shift into
           // uninitialized and then copy over.
 
@@ -3957,8 +5943,9 @@ namespace gch
           const size_ty new_size = get_size () + num_insert;
 
           // The check is handled by the if-guard.
-          const size_ty new_capacity = unchecked_calculate_new_capacity (new_size);
-          const ptr     new_data_ptr = unchecked_allocate (new_capacity, allocation_end_ptr ());
+          size_ty       new_capacity = unchecked_calculate_new_capacity (new_size);
+          const ptr     new_data_ptr =
+            unchecked_allocate_at_least (new_capacity, allocation_end_ptr ());
           ptr           new_first    = unchecked_next (new_data_ptr, offset);
           ptr           new_last     = new_first;
 
@@ -3967,9 +5954,9 @@ namespace gch
             uninitialized_copy (first, last, new_first);
             unchecked_advance  (new_last, num_insert);
 
-            uninitialized_move (begin_ptr (), pos, new_data_ptr);
+            uninitialized_relocate (begin_ptr (), pos, new_data_ptr);
             new_first = new_data_ptr;
-            uninitialized_move (pos, end_ptr (), new_last);
+            uninitialized_relocate (pos, end_ptr (), new_last);
           }
           GCH_CATCH (...)
           {
@@ -3978,11 +5965,29 @@ namespace gch
             GCH_THROW;
           }
 
-          reset_data (new_data_ptr, new_capacity, new_size);
+          reset_relocated_data (new_data_ptr, new_capacity, new_size);
           return unchecked_next (begin_ptr (), offset);
         }
         else
         {
+          if (can_relocate_bytes ())
+          {
+            // Open a gap at `pos` and construct the new elements in it.
+            const ptr gap_end = unchecked_next (pos, num_insert);
+            relocate_bytes (pos, end_ptr (), gap_end);
+            GCH_TRY
+            {
+              uninitialized_copy (first, last, pos);
+            }
+            GCH_CATCH (...)
+            {
+              relocate_bytes (gap_end, unchecked_next (end_ptr (), num_insert), pos);
+              GCH_THROW;
+            }
+            increase_size (num_insert);
+            return pos;
+          }
+
           // if we have fewer to insert than tailing elements after
           // `pos` we shift into uninitialized and then copy over
           const size_ty tail_size = internal_range_length (pos, end_ptr ());
@@ -4106,6 +6111,14 @@ namespace gch
         // In the special case of value_ty&& we don't make a copy because behavior is unspecified
         // when it is an internal element. Hence, we'll take the opportunity to optimize and assume
         // that it isn't an internal element.
+        if (can_relocate_bytes ())
+        {
+          relocate_bytes (pos, end_ptr (), unchecked_next (pos));
+          construct (pos, std::move (val));
+          increase_size (1);
+          return pos;
+        }
+
         shift_into_uninitialized (pos, 1);
         destroy (pos);
         construct (pos, std::move (val));
@@ -4132,6 +6145,23 @@ namespace gch
 
         // This is necessary because of possible aliasing.
         stack_temporary tmp (*this, std::forward<Args> (args)...);
+
+        if (can_relocate_bytes ())
+        {
+          relocate_bytes (pos, end_ptr (), unchecked_next (pos));
+          GCH_TRY
+          {
+            construct (pos, tmp.release ());
+          }
+          GCH_CATCH (...)
+          {
+            relocate_bytes (unchecked_next (pos), unchecked_next (end_ptr ()), pos);
+            GCH_THROW;
+          }
+          increase_size (1);
+          return pos;
+        }
+
         shift_into_uninitialized (pos, 1);
         *pos = tmp.release ();
         return pos;
@@ -4149,8 +6179,17 @@ namespace gch
         const size_ty new_size = get_size () + 1;
 
         // The check is handled by the if-guard.
-        const size_ty new_capacity = unchecked_calculate_new_capacity (new_size);
-        const ptr     new_data_ptr = unchecked_allocate (new_capacity, allocation_end_ptr ());
+        size_ty       new_capacity = unchecked_calculate_new_capacity (new_size);
+        if (can_reallocate ())
+        {
+          // The arguments may refer to an element, so we construct the new element first.
+          stack_temporary tmp (*this, std::forward<Args> (args)...);
+          reallocate_allocation (new_capacity);
+          return emplace_into_current_end (tmp.release ());
+        }
+
+        const ptr     new_data_ptr =
+          unchecked_allocate_at_least (new_capacity, allocation_end_ptr ());
         const ptr     emplace_pos  = unchecked_next (new_data_ptr, get_size ());
 
         GCH_TRY
@@ -4158,7 +6197,8 @@ namespace gch
           construct (emplace_pos, std::forward<Args> (args)...);
           GCH_TRY
           {
-            uninitialized_move<strong_exception_policy> (begin_ptr (), end_ptr (), new_data_ptr);
+            uninitialized_relocate<strong_exception_policy> (begin_ptr (), end_ptr (),
+                                                             new_data_ptr);
           }
           GCH_CATCH (...)
           {
@@ -4172,7 +6212,7 @@ namespace gch
           GCH_THROW;
         }
 
-        reset_data (new_data_ptr, new_capacity, new_size);
+        reset_relocated_data (new_data_ptr, new_capacity, new_size);
         return emplace_pos;
       }
 
@@ -4191,8 +6231,9 @@ namespace gch
         const size_ty new_size = get_size () + 1;
 
         // The check is handled by the if-guard.
-        const size_ty new_capacity = unchecked_calculate_new_capacity (new_size);
-        const ptr     new_data_ptr = unchecked_allocate (new_capacity, allocation_end_ptr ());
+        size_ty       new_capacity = unchecked_calculate_new_capacity (new_size);
+        const ptr     new_data_ptr =
+          unchecked_allocate_at_least (new_capacity, allocation_end_ptr ());
         ptr           new_first    = unchecked_next (new_data_ptr, offset);
         ptr           new_last     = new_first;
 
@@ -4201,9 +6242,9 @@ namespace gch
           construct (new_first, std::forward<Args> (args)...);
           unchecked_advance (new_last, 1);
 
-          uninitialized_move (begin_ptr (), pos, new_data_ptr);
+          uninitialized_relocate (begin_ptr (), pos, new_data_ptr);
           new_first = new_data_ptr;
-          uninitialized_move (pos, end_ptr (), new_last);
+          uninitialized_relocate (pos, end_ptr (), new_last);
         }
         GCH_CATCH (...)
         {
@@ -4212,7 +6253,7 @@ namespace gch
           GCH_THROW;
         }
 
-        reset_data (new_data_ptr, new_capacity, new_size);
+        reset_relocated_data (new_data_ptr, new_capacity, new_size);
         return unchecked_next (begin_ptr (), offset);
       }
 
@@ -4220,26 +6261,124 @@ namespace gch
       ptr
       shrink_to_size (void)
       {
-        if (! has_allocation () || get_size () == get_capacity ())
+        return shrink_to (get_size ());
+      }
+
+      // Gives back memory according to `shrink_policy` after elements are removed. Shrinking is
+      // only an optimization, so if it fails the vector is left as it was.
+      template <typename S = shrink_policy,
+                typename std::enable_if<
+                  std::is_same<S, small_vector_shrink::never>::value>::type * = nullptr>
+      GCH_CPP20_CONSTEXPR
+      void
+      apply_shrink_policy (void) noexcept
+      { }
+
+      template <typename S = shrink_policy,
+                typename std::enable_if<
+                  ! std::is_same<S, small_vector_shrink::never>::value>::type * = nullptr>
+      GCH_CPP20_CONSTEXPR
+      void
+      apply_shrink_policy (void) noexcept
+      {
+        if (! has_allocation ())
+          return;
+
+        const size_ty new_capacity =
+          shrink_policy::template calculate_shrunk_capacity<value_ty> (get_size (),
+                                                                      get_capacity ());
+        if (new_capacity < get_capacity ())
+        {
+          GCH_TRY
+          {
+            shrink_to (new_capacity);
+          }
+          GCH_CATCH (...)
+          { }
+        }
+      }
+
+      // Same as above, but returns `pos` adjusted to the new location of the elements.
+      GCH_CPP20_CONSTEXPR
+      ptr
+      apply_shrink_policy (ptr pos) noexcept
+      {
+        const size_ty offset = internal_range_length (begin_ptr (), pos);
+        apply_shrink_policy ();
+        return unchecked_next (begin_ptr (), offset);
+      }
+
+      GCH_CPP20_CONSTEXPR
+      void
+      reset_to_inline_storage (void) noexcept
+      {
+        wipe ();
+        set_default ();
+      }
+
+      // Gives up the allocation, and leaves the vector empty. Elements in the inline storage are
+      // first moved to a new allocation with exactly enough room for them. If the vector is empty
+      // and has no allocation, the result holds a null pointer.
+      GCH_CPP20_CONSTEXPR
+      small_vector_allocation<ptr, size_ty, alloc_ty>
+      release_allocation (void)
+      {
+        static_assert (! std::is_same<typename Options::layout,
+                                      small_vector_layout::heap_header>::value,
+                       "Allocations cannot be released with the `heap_header` layout.");
+
+        const size_ty size = get_size ();
+        if (has_allocation ())
+        {
+          const ptr     old_data_ptr = data_ptr ();
+          const size_ty old_capacity = get_capacity ();
+          set_default ();
+          return { old_data_ptr, size, old_capacity, allocator_ref () };
+        }
+
+        if (size == 0)
+          return { nullptr, 0, 0, allocator_ref () };
+
+        const ptr new_data_ptr = allocate (size);
+        GCH_TRY
+        {
+          uninitialized_relocate (begin_ptr (), end_ptr (), new_data_ptr);
+        }
+        GCH_CATCH (...)
+        {
+          deallocate (new_data_ptr, size);
+          GCH_THROW;
+        }
+
+        destroy_relocated (begin_ptr (), end_ptr ());
+        set_size (0);
+        return { new_data_ptr, size, size, allocator_ref () };
+      }
+
+      // Moves the elements to an allocation with capacity `new_capacity`, or to the inline storage
+      // if they fit. `new_capacity` must not be less than the size.
+      GCH_CPP20_CONSTEXPR
+      ptr
+      shrink_to (size_ty new_capacity)
+      {
+        assert (get_size () <= new_capacity && "The new capacity is less than the size.");
+
+        if (! has_allocation () || new_capacity == get_capacity ())
           return begin_ptr ();
 
         // The rest runs only if allocated.
 
-        size_ty new_capacity;
-        ptr     new_data_ptr;
+        ptr new_data_ptr;
 
-        if (InlineCapacity < get_size ())
-        {
-          new_capacity = get_size ();
+        if (InlineCapacity < new_capacity)
           new_data_ptr = unchecked_allocate (new_capacity, allocation_end_ptr ());
-        }
         else
         {
           // We move to inline storage.
           new_capacity = InlineCapacity;
 #ifdef GCH_LIB_IS_CONSTANT_EVALUATED
           if (std::is_constant_evaluated ())
-            new_data_ptr = alloc_interface::allocate (InlineCapacity);
+            new_data_ptr = allocate (InlineCapacity);
           else
             new_data_ptr = storage_ptr ();
 #else
@@ -4247,13 +6386,30 @@ namespace gch
 #endif
         }
 
-        uninitialized_move (begin_ptr (), end_ptr (), new_data_ptr);
+        // The allocation may share space with the inline storage, so hold onto it.
+        const ptr     old_data_ptr = data_ptr ();
+        const ptr     old_end_ptr  = end_ptr ();
+        const size_ty old_capacity = get_capacity ();
+        const size_ty old_size     = get_size ();
 
-        destroy_range (begin_ptr (), end_ptr ());
-        deallocate (data_ptr (), get_capacity ());
+        GCH_TRY
+        {
+          uninitialized_relocate (old_data_ptr, old_end_ptr, new_data_ptr);
+        }
+        GCH_CATCH (...)
+        {
+          if (new_data_ptr != storage_ptr ())
+            deallocate (new_data_ptr, new_capacity);
+          set_data_ptr (old_data_ptr);
+          set_capacity (old_capacity);
+          GCH_THROW;
+        }
 
-        set_data_ptr (new_data_ptr);
-        set_capacity (new_capacity);
+        destroy_relocated (old_data_ptr, old_end_ptr);
+        deallocate (old_data_ptr, old_capacity);
+
+        // The size is set again since it may be stored in the allocation.
+        set_data (new_data_ptr, new_capacity, old_size);
 
         return begin_ptr ();
       }
@@ -4263,7 +6419,7 @@ namespace gch
       void
       resize_with (size_ty new_size, const ValueT&... val)
       {
-        // ValueT... should either be value_ty or empty.
+        // ValueT... should either be value_ty, for_overwrite_t, or empty.
 
         if (new_size == 0)
           erase_all ();
@@ -4278,8 +6434,21 @@ namespace gch
           const size_ty original_size = get_size ();
 
           // The check is handled by the if-guard.
-          const size_ty new_capacity = unchecked_calculate_new_capacity (new_size);
-          ptr           new_data_ptr = unchecked_allocate (new_capacity, allocation_end_ptr ());
+          size_ty       new_capacity = unchecked_calculate_new_capacity (new_size);
+          if (can_reallocate ())
+            return reallocate_and_fill (new_capacity, new_size, val...);
+
+          if (can_allocate_zeroed<ValueT...> ())
+          {
+            // The new elements are already value-initialized. Relocating the old elements cannot
+            // throw since they are zero-initializable.
+            const ptr new_data_ptr = unchecked_allocate_zeroed (new_capacity);
+            uninitialized_relocate (begin_ptr (), end_ptr (), new_data_ptr);
+            return reset_relocated_data (new_data_ptr, new_capacity, new_size);
+          }
+
+          ptr           new_data_ptr =
+            unchecked_allocate_at_least (new_capacity, allocation_end_ptr ());
           ptr           new_last     = unchecked_next (new_data_ptr, original_size);
 
           GCH_TRY
@@ -4290,7 +6459,8 @@ namespace gch
               val...);
 
             // Strong exception guarantee.
-            uninitialized_move<strong_exception_policy> (begin_ptr (), end_ptr (), new_data_ptr);
+            uninitialized_relocate<strong_exception_policy> (begin_ptr (), end_ptr (),
+                                                             new_data_ptr);
           }
           GCH_CATCH (...)
           {
@@ -4299,7 +6469,7 @@ namespace gch
             GCH_THROW;
           }
 
-          reset_data (new_data_ptr, new_capacity, new_size);
+          reset_relocated_data (new_data_ptr, new_capacity, new_size);
         }
         else if (get_size () < new_size)
         {
@@ -4313,6 +6483,93 @@ namespace gch
         // Do nothing if the count is the same as the current size.
       }
 
+      // Grows the allocation with `reallocate` and fills it up to `new_size`.
+      // Precondition: can_reallocate ()
+      template <typename ...ValueT>
+      GCH_CPP20_CONSTEXPR
+      void
+      reallocate_and_fill (size_ty new_capacity, size_ty new_size, const ValueT&... val)
+      {
+        reallocate_allocation (new_capacity);
+        uninitialized_fill (end_ptr (), unchecked_next (begin_ptr (), new_size), val...);
+        set_size (new_size);
+      }
+
+      // The value may refer to an element, so we copy it before reallocating.
+      GCH_CPP20_CONSTEXPR
+      void
+      reallocate_and_fill (size_ty new_capacity, size_ty new_size, const value_ty& val)
+      {
+        const stack_temporary tmp (*this, val);
+        reallocate_allocation (new_capacity);
+        uninitialized_fill (end_ptr (), unchecked_next (begin_ptr (), new_size), tmp.get ());
+        set_size (new_size);
+      }
+
+      // Resizes to `new_size` with default-initialized new elements, then calls `op (p, n)`, where
+      // `p` points to the element at `offset` and `n` is `new_size - offset`. The result of `op` is
+      // the number of elements starting at `p` to keep, and the rest are erased.
+      template <typename Operation>
+      GCH_CPP20_CONSTEXPR
+      void
+      overwrite_with (size_ty offset, size_ty new_size, Operation& op)
+      {
+        assert (offset <= new_size);
+
+        assert (new_size <= get_capacity () && "The capacity should be requested beforehand.");
+
+        const size_ty old_size = get_size ();
+        if (old_size < new_size)
+        {
+          uninitialized_default_construct (end_ptr (), unchecked_next (begin_ptr (), new_size));
+          set_size (new_size);
+        }
+
+        const size_ty count = new_size - offset;
+        size_ty       num_kept;
+        GCH_TRY
+        {
+          num_kept = static_cast<size_ty> (op (unchecked_next (begin_ptr (), offset), count));
+        }
+        GCH_CATCH (...)
+        {
+          if (old_size < new_size)
+            erase_to_end (unchecked_next (begin_ptr (), old_size));
+          GCH_THROW;
+        }
+
+        if (count < num_kept)
+        {
+          if (old_size < new_size)
+            erase_to_end (unchecked_next (begin_ptr (), old_size));
+          throw_overwrite_count_error ();
+        }
+
+        erase_to_end (unchecked_next (begin_ptr (), offset + num_kept));
+      }
+
+      // The final size is known, so this allocates exactly `new_size` elements if it needs to grow.
+      template <typename Operation>
+      GCH_CPP20_CONSTEXPR
+      void
+      resize_and_overwrite (size_ty new_size, Operation& op)
+      {
+        request_exact_capacity (new_size);
+        overwrite_with (0, new_size, op);
+      }
+
+      // Grows with the growth policy, since this may be called repeatedly to fill a buffer.
+      template <typename Operation>
+      GCH_CPP20_CONSTEXPR
+      void
+      append_and_overwrite (size_ty max_count, Operation& op)
+      {
+        if (get_max_size () - get_size () < max_count)
+          throw_allocation_size_error ();
+        request_capacity (get_size () + max_count);
+        overwrite_with (get_size (), get_size () + max_count, op);
+      }
+
       GCH_CPP20_CONSTEXPR
       void
       request_capacity (size_ty request)
@@ -4320,12 +6577,37 @@ namespace gch
         if (request <= get_capacity ())
           return;
 
-        size_ty new_capacity = checked_calculate_new_capacity (request);
-        ptr     new_begin    = unchecked_allocate (new_capacity);
+        grow_allocation (checked_calculate_new_capacity (request));
+      }
+
+      // Like `request_capacity`, but does not apply the growth policy.
+      GCH_CPP20_CONSTEXPR
+      void
+      request_exact_capacity (size_ty request)
+      {
+        if (request <= get_capacity ())
+          return;
+
+        if (get_max_size () < request)
+          throw_allocation_size_error ();
+
+        grow_allocation (request);
+      }
+
+      // Moves the elements to an allocation of at least `new_capacity` elements.
+      // Precondition: get_capacity () < new_capacity <= get_max_size ()
+      GCH_CPP20_CONSTEXPR
+      void
+      grow_allocation (size_ty new_capacity)
+      {
+        if (can_reallocate ())
+          return reallocate_allocation (new_capacity);
+
+        ptr     new_begin    = unchecked_allocate_at_least (new_capacity);
 
         GCH_TRY
         {
-          uninitialized_move<strong_exception_policy> (begin_ptr (), end_ptr (), new_begin);
+          uninitialized_relocate<strong_exception_policy> (begin_ptr (), end_ptr (), new_begin);
         }
         GCH_CATCH (...)
         {
@@ -4333,16 +6615,52 @@ namespace gch
           GCH_THROW;
         }
 
-        wipe ();
+        reset_relocated_data (new_begin, new_capacity, get_size ());
+      }
+
+      // Like `request_capacity`, but returns false instead of throwing if the capacity can't be
+      // allocated. The vector is unchanged in that case.
+      GCH_CPP20_CONSTEXPR
+      bool
+      try_request_capacity (size_ty request)
+      {
+        if (request <= get_capacity ())
+          return true;
+
+        if (get_max_size () < request)
+          return false;
+
+        size_ty   new_capacity = unchecked_calculate_new_capacity (request);
+        const ptr new_begin    = try_allocate_at_least (new_capacity, allocation_end_ptr ());
+        if (new_begin == nullptr)
+          return false;
+
+        GCH_TRY
+        {
+          uninitialized_relocate<strong_exception_policy> (begin_ptr (), end_ptr (), new_begin);
+        }
+        GCH_CATCH (...)
+        {
+          deallocate (new_begin, new_capacity);
+          GCH_THROW;
+        }
 
-        set_data_ptr (new_begin);
-        set_capacity (new_capacity);
+        reset_relocated_data (new_begin, new_capacity, get_size ());
+        return true;
       }
 
       GCH_CPP20_CONSTEXPR
       ptr
       erase_at (ptr pos)
       {
+        if (can_relocate_bytes ())
+        {
+          destroy (pos);
+          relocate_bytes (unchecked_next (pos), end_ptr (), pos);
+          decrease_size (1);
+          return pos;
+        }
+
         move_left (unchecked_next (pos), end_ptr (), pos);
         erase_last ();
         return pos;
@@ -4362,8 +6680,18 @@ namespace gch
       ptr
       erase_range (ptr first, ptr last)
       {
-        if (! (first == last))
-          erase_to_end (move_left (last, end_ptr (), first));
+        if (first == last)
+          return first;
+
+        if (can_relocate_bytes ())
+        {
+          destroy_range (first, last);
+          relocate_bytes (last, end_ptr (), first);
+          decrease_size (internal_range_length (first, last));
+          return first;
+        }
+
+        erase_to_end (move_left (last, end_ptr (), first));
         return first;
       }
 
@@ -4391,7 +6719,8 @@ namespace gch
       template <unsigned N>
       GCH_CPP20_CONSTEXPR
       void
-      swap_elements_equal_or_non_propagated_allocators (small_vector_base<Allocator, N>& other)
+      swap_elements_equal_or_non_propagated_allocators (
+        small_vector_base<Allocator, N, Options>& other)
       {
         if (other.get_size () < get_size ())
           return other.swap_elements_equal_or_non_propagated_allocators (*this);
@@ -4408,7 +6737,8 @@ namespace gch
         >::type * = nullptr>
       GCH_CPP20_CONSTEXPR
       void
-      swap_elements_unequal_and_propagated_allocators (small_vector_base<Allocator, N>& r) noexcept
+      swap_elements_unequal_and_propagated_allocators (
+        small_vector_base<Allocator, N, Options>& r) noexcept
       {
         if (r.get_size () < get_size ())
           return r.swap_elements_unequal_and_propagated_allocators (*this);
@@ -4435,7 +6765,7 @@ namespace gch
         >::type * = nullptr>
       GCH_CPP20_CONSTEXPR
       void
-      swap_elements_unequal_and_propagated_allocators (small_vector_base<Allocator, N>& r)
+      swap_elements_unequal_and_propagated_allocators (small_vector_base<Allocator, N, Options>& r)
       {
         if (r.get_size () < get_size ())
           return r.swap_elements_unequal_and_propagated_allocators (*this);
@@ -4499,8 +6829,9 @@ namespace gch
 
       template <unsigned N, typename A = alloc_ty,
                 typename std::enable_if<allocators_always_equal<A>::value>::type * = nullptr>
+      GCH_CPP20_CONSTEXPR
       void
-      swap_elements (small_vector_base<Allocator, N>& other)
+      swap_elements (small_vector_base<Allocator, N, Options>& other)
       {
         swap_elements_equal_or_non_propagated_allocators (other);
       }
@@ -4510,8 +6841,9 @@ namespace gch
             ! allocators_always_equal<A>::value
           &&! std::allocator_traits<Allocator>::propagate_on_container_swap::value
         >::type * = nullptr>
+      GCH_CPP20_CONSTEXPR
       void
-      swap_elements (small_vector_base<Allocator, N>& other)
+      swap_elements (small_vector_base<Allocator, N, Options>& other)
       {
         return swap_elements_equal_or_non_propagated_allocators (other);
       }
@@ -4521,8 +6853,9 @@ namespace gch
             ! allocators_always_equal<A>::value
           &&  std::allocator_traits<Allocator>::propagate_on_container_swap::value
         >::type * = nullptr>
+      GCH_CPP20_CONSTEXPR
       void
-      swap_elements (small_vector_base<Allocator, N>& other)
+      swap_elements (small_vector_base<Allocator, N, Options>& other)
       {
         if (allocator_ref () == other.allocator_ref ())
           return swap_elements_equal_or_non_propagated_allocators (other);
@@ -4532,7 +6865,7 @@ namespace gch
       template <unsigned N>
       GCH_CPP20_CONSTEXPR
       void
-      swap_unequal_and_non_propagated_allocators (small_vector_base<Allocator, N>& other)
+      swap_unequal_and_non_propagated_allocators (small_vector_base<Allocator, N, Options>& other)
       {
         assert (
               allocator_ref () != other.allocator_ref ()
@@ -4569,9 +6902,10 @@ namespace gch
             GCH_THROW;
           }
 
+          // The size is set again since it may be stored in the allocation.
+          const size_ty old_size = get_size ();
           wipe ();
-          set_data_ptr (new_data_ptr);
-          set_capacity (new_capacity);
+          set_data (new_data_ptr, new_capacity, old_size);
         }
         else
           swap_elements_equal_or_non_propagated_allocators (other);
@@ -4591,7 +6925,7 @@ namespace gch
       template <unsigned LessEqualI>
       GCH_CPP20_CONSTEXPR
       void
-      swap_equal_or_propagated_allocators (small_vector_base<Allocator, LessEqualI>& other)
+      swap_equal_or_propagated_allocators (small_vector_base<Allocator, LessEqualI, Options>& other)
       {
         static_assert (LessEqualI <= InlineCapacity, "should not be instantiated");
         assert (
@@ -4602,7 +6936,7 @@ namespace gch
 
         if (has_allocation ())
         {
-          if (InlineCapacity < other.get_capacity ())
+          if (can_take_allocation (other))
           {
             // Note: This is always the branch that will run when constant-evaluated.
             m_data.swap_data_ptr (other.m_data);
@@ -4618,19 +6952,35 @@ namespace gch
                 new_data_ptr = other.allocate (InlineCapacity);
 #endif
 
-            other.uninitialized_move (other.begin_ptr (), other.end_ptr (), new_data_ptr);
+            // Our allocation may share space with our inline storage, so hold onto it.
+            const ptr     old_data_ptr = data_ptr ();
+            const size_ty old_capacity = get_capacity ();
+
+            GCH_TRY
+            {
+              other.uninitialized_move (other.begin_ptr (), other.end_ptr (), new_data_ptr);
+            }
+            GCH_CATCH (...)
+            {
+              set_data_ptr (old_data_ptr);
+              set_capacity (old_capacity);
+              GCH_THROW;
+            }
 
             other.wipe ();
-            other.set_data_ptr (data_ptr ());
-            other.set_capacity (get_capacity ());
+            other.set_data_ptr (old_data_ptr);
+            other.set_capacity (old_capacity);
 
             set_data_ptr (new_data_ptr);
             set_capacity (InlineCapacity);
           }
         }
-        else if (InlineCapacity < other.get_capacity ())
+        else if (can_take_allocation (other))
         {
           // This implies that `other` is allocated, and that we can use its pointer.
+          // It may share space with the inline storage of `other`, so hold onto it.
+          const ptr     other_data_ptr = other.data_ptr ();
+          const size_ty other_capacity = other.get_capacity ();
 
           size_ty new_capacity = LessEqualI;
           ptr     new_data_ptr = other.storage_ptr ();
@@ -4639,7 +6989,7 @@ namespace gch
           if (LessEqualI < get_size ())
           {
             new_capacity = other.calculate_new_capacity (LessEqualI, get_size ());
-            new_data_ptr = alloc_interface::allocate_with_hint (
+            new_data_ptr = allocate_with_hint (
               new_capacity,
               allocation_end_ptr ()
             );
@@ -4654,12 +7004,23 @@ namespace gch
             }
           }
           else
-            uninitialized_move (begin_ptr (), end_ptr (), new_data_ptr);
+          {
+            GCH_TRY
+            {
+              uninitialized_move (begin_ptr (), end_ptr (), new_data_ptr);
+            }
+            GCH_CATCH (...)
+            {
+              other.set_data_ptr (other_data_ptr);
+              other.set_capacity (other_capacity);
+              GCH_THROW;
+            }
+          }
 
           destroy_range (begin_ptr (), end_ptr ());
 
-          set_data_ptr (other.data_ptr ());
-          set_capacity (other.get_capacity ());
+          set_data_ptr (other_data_ptr);
+          set_capacity (other_capacity);
 
           other.set_data_ptr (new_data_ptr);
           other.set_capacity (new_capacity);
@@ -4668,7 +7029,7 @@ namespace gch
         {
           // We have too many elements to store in `other`. Allocate a new buffer.
           size_ty new_capacity = other.calculate_new_capacity (LessEqualI, get_size ());
-          ptr     new_data_ptr = alloc_interface::allocate_with_hint (
+          ptr     new_data_ptr = allocate_with_hint (
             new_capacity,
             other.allocation_end_ptr ()
           );
@@ -4701,24 +7062,48 @@ namespace gch
           // Move our elements into the inline storage of `other` (which is empty).
           // Move the elements of `other` into our inline storage.
           // Delete the allocation.
-          const ptr new_end = uninitialized_move (begin_ptr (), end_ptr (), other.storage_ptr ());
+          // The allocation may share space with the inline storage of `other`, so hold onto it.
+          const ptr     other_data_ptr = other.data_ptr ();
+          const ptr     other_end_ptr  = other.end_ptr ();
+          const size_ty other_capacity = other.get_capacity ();
+
+          const ptr new_end = unchecked_next (other.storage_ptr (), get_size ());
           GCH_TRY
           {
-            overwrite_existing_elements (std::move (other));
+            uninitialized_move (begin_ptr (), end_ptr (), other.storage_ptr ());
+            GCH_TRY
+            {
+              overwrite_existing_elements (std::move (other), other_data_ptr, other_end_ptr);
+            }
+            GCH_CATCH (...)
+            {
+              destroy_range (other.storage_ptr (), new_end);
+              GCH_THROW;
+            }
           }
           GCH_CATCH (...)
           {
-            destroy_range (other.storage_ptr (), new_end);
+            other.set_data_ptr (other_data_ptr);
+            other.set_capacity (other_capacity);
             GCH_THROW;
           }
 
-          other.destroy_range (other.begin_ptr (), other.end_ptr ());
-          other.deallocate (other.data_ptr (), other.get_capacity ());
+          other.destroy_range (other_data_ptr, other_end_ptr);
+          other.deallocate (other_data_ptr, other_capacity);
           other.set_data_ptr (other.storage_ptr ());
           other.set_capacity (LessEqualI);
         }
-        else
-          swap_elements (other);
+        else
+        {
+#ifdef GCH_LIB_IS_CONSTANT_EVALUATED
+          if (std::is_constant_evaluated ())
+            swap_elements (other);
+          else
+            swap_inline_elements (other);
+#else
+          swap_inline_elements (other);
+#endif
+        }
 
         m_data.swap_size (other.m_data);
         alloc_interface::maybe_swap (other);
@@ -4728,7 +7113,7 @@ namespace gch
         typename std::enable_if<(InlineCapacity < GreaterI)>::type * = nullptr>
       GCH_CPP20_CONSTEXPR
       void
-      swap (small_vector_base<Allocator, GreaterI>& other)
+      swap (small_vector_base<Allocator, GreaterI, Options>& other)
       {
         return other.swap (*this);
       }
@@ -4742,7 +7127,7 @@ namespace gch
         >::type * = nullptr>
       GCH_CPP20_CONSTEXPR
       void
-      swap (small_vector_base<Allocator, LessEqualI>& other)
+      swap (small_vector_base<Allocator, LessEqualI, Options>& other)
       {
         return swap_equal_or_propagated_allocators (other);
       }
@@ -4756,7 +7141,7 @@ namespace gch
         >::type * = nullptr>
       GCH_CPP20_CONSTEXPR
       void
-      swap (small_vector_base<Allocator, LessEqualI>& other)
+      swap (small_vector_base<Allocator, LessEqualI, Options>& other)
       {
         if (allocator_ref () == other.allocator_ref ())
           return swap_equal_or_propagated_allocators (other);
@@ -4978,6 +7363,13 @@ namespace gch
         return m_data.capacity ();
       }
 
+      GCH_NODISCARD constexpr
+      const data_ty&
+      get_data (void) const noexcept
+      {
+        return m_data;
+      }
+
       GCH_NODISCARD constexpr
       size_ty
       get_size (void) const noexcept
@@ -4996,7 +7388,7 @@ namespace gch
       ptr
       begin_ptr (void) noexcept
       {
-        return data_ptr ();
+        return detail::assume_aligned<Options::alignment::value> (data_ptr ());
       }
 
       GCH_NODISCARD
@@ -5004,7 +7396,7 @@ namespace gch
       cptr
       begin_ptr (void) const noexcept
       {
-        return data_ptr ();
+        return detail::assume_aligned<Options::alignment::value> (data_ptr ());
       }
 
       GCH_NODISCARD GCH_CPP14_CONSTEXPR
@@ -5047,7 +7439,7 @@ namespace gch
       storage_ptr (void) noexcept
       {
 #ifdef GCH_LIB_IS_CONSTANT_EVALUATED
-        if (std::is_constant_evaluated ())
+        if (std::is_constant_evaluated () &&! has_constexpr_inline_storage<data_ty>::value)
           return nullptr;
 #endif
         return m_data.storage ();
@@ -5058,10 +7450,74 @@ namespace gch
       has_allocation (void) const noexcept
       {
 #ifdef GCH_LIB_IS_CONSTANT_EVALUATED
-        if (std::is_constant_evaluated ())
+        if (std::is_constant_evaluated () &&! has_constexpr_inline_storage<data_ty>::value)
           return true;
 #endif
-        return InlineCapacity < get_capacity ();
+        return m_data.is_allocated ();
+      }
+
+      // Whether we can take the allocation of `other` instead of moving its elements. If the inline
+      // capacities are the same, this is just `other.has_allocation ()`.
+      template <unsigned I>
+      GCH_NODISCARD constexpr
+      bool
+      can_take_allocation (const small_vector_base<Allocator, I, Options>& other) const noexcept
+      {
+        return InlineCapacity <= I ? other.has_allocation ()
+                                   : (other.has_allocation ()
+                                      &&  InlineCapacity < other.get_capacity ());
+      }
+
+      // Whether the elements of `other` may be copied into our inline storage as a single block,
+      // which is the case if they are in the inline storage of `other` and they fit in ours.
+      template <unsigned I>
+      GCH_NODISCARD GCH_CPP20_CONSTEXPR
+      bool
+      can_copy_block (const small_vector_base<Allocator, I, Options>& other) const noexcept
+      {
+#ifdef GCH_LIB_IS_CONSTANT_EVALUATED
+        if (std::is_constant_evaluated ())
+          return false;
+#endif
+        return is_block_copyable<I>::value
+           &&! other.has_allocation ()
+           &&  (I <= InlineCapacity || other.get_size () <= InlineCapacity);
+      }
+
+      // Copies the inline storage of `other` into our inline storage. The bytes past the end of the
+      // elements are copied as well so that the size of the copy is a constant.
+      // Precondition: can_copy_block (other)
+      template <unsigned I>
+      void
+      copy_block (const small_vector_base<Allocator, I, Options>& other) noexcept
+      {
+        std::memcpy (static_cast<void *> (to_address (storage_ptr ())),
+                     static_cast<const void *> (to_address (other.begin_ptr ())),
+                     (I < InlineCapacity ? I : InlineCapacity) * sizeof (value_ty));
+      }
+
+      // Swaps the elements of two inlined vectors whose sizes are both at most `I`.
+      template <unsigned I,
+                typename std::enable_if<is_block_copyable<I>::value>::type * = nullptr>
+      void
+      swap_inline_elements (small_vector_base<Allocator, I, Options>& other) noexcept
+      {
+        constexpr std::size_t block_size = I * sizeof (value_ty);
+        unsigned char l_block[block_size];
+        unsigned char r_block[block_size];
+
+        std::memcpy (l_block, static_cast<void *> (to_address (storage_ptr ())), block_size);
+        std::memcpy (r_block, static_cast<void *> (to_address (other.storage_ptr ())), block_size);
+        std::memcpy (static_cast<void *> (to_address (storage_ptr ())), r_block, block_size);
+        std::memcpy (static_cast<void *> (to_address (other.storage_ptr ())), l_block, block_size);
+      }
+
+      template <unsigned I,
+                typename std::enable_if<! is_block_copyable<I>::value>::type * = nullptr>
+      void
+      swap_inline_elements (small_vector_base<Allocator, I, Options>& other)
+      {
+        swap_elements (other);
       }
 
       GCH_NODISCARD constexpr
@@ -5072,30 +7528,33 @@ namespace gch
       }
 
     private:
-      small_vector_data<ptr, size_type, value_ty, InlineCapacity> m_data;
+      data_ty m_data;
     };
 
   } // namespace gch::detail
 
-  template <typename T, unsigned InlineCapacity, typename Allocator>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options>
 #ifdef GCH_LIB_CONCEPTS
   requires concepts::small_vector::AllocatorFor<Allocator, T>
 #endif
   class small_vector
-    : private detail::small_vector_base<Allocator, InlineCapacity>
+    : private detail::small_vector_base<Allocator, InlineCapacity, Options>
   {
-    using base = detail::small_vector_base<Allocator, InlineCapacity>;
+    using base = detail::small_vector_base<Allocator, InlineCapacity, Options>;
 
   public:
     static_assert (std::is_same<T, typename Allocator::value_type>::value,
                    "`Allocator::value_type` must be the same as `T`.");
 
-    template <typename SameT, unsigned DifferentInlineCapacity, typename SameAllocator>
+    template <typename SameT, unsigned DifferentInlineCapacity, typename SameAllocator,
+              typename SameOptions>
 #ifdef GCH_LIB_CONCEPTS
     requires concepts::small_vector::AllocatorFor<SameAllocator, SameT>
 #endif
     friend class small_vector;
 
+    friend struct detail::small_vector_access;
+
     using value_type             = T;
     using allocator_type         = Allocator;
     using size_type              = typename base::size_type;
@@ -5110,6 +7569,11 @@ namespace gch
     using reverse_iterator       = std::reverse_iterator<iterator>;
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
+    // The type of the counts given to the constructors, `assign`, `insert`, `reserve`, and
+    // `resize`. This is the `size_type` of the allocator, which may be wider than `size_type`, so
+    // that counts larger than `max_size ()` throw `std::length_error` instead of being truncated.
+    using count_type             = typename std::allocator_traits<allocator_type>::size_type;
+
     static_assert (InlineCapacity <= (std::numeric_limits<size_type>::max) (),
                    "InlineCapacity must be less than or equal to the maximum value of size_type.");
 
@@ -5223,7 +7687,7 @@ namespace gch
     { }
 
     GCH_CPP20_CONSTEXPR explicit
-    small_vector (size_type count)
+    small_vector (count_type count)
 #ifdef GCH_LIB_CONCEPTS
       requires DefaultInsertable && concepts::DefaultConstructible<allocator_type>
 #endif
@@ -5231,15 +7695,15 @@ namespace gch
     { }
 
     GCH_CPP20_CONSTEXPR explicit
-    small_vector (size_type count, const allocator_type& alloc)
+    small_vector (count_type count, const allocator_type& alloc)
 #ifdef GCH_LIB_CONCEPTS
       requires DefaultInsertable
 #endif
-      : base (count, alloc)
+      : base (base::checked_count (count), alloc)
     { }
 
     GCH_CPP20_CONSTEXPR
-    small_vector (size_type count, const_reference value)
+    small_vector (count_type count, const_reference value)
 #ifdef GCH_LIB_CONCEPTS
       requires CopyInsertable && concepts::DefaultConstructible<allocator_type>
 #endif
@@ -5247,11 +7711,48 @@ namespace gch
     { }
 
     GCH_CPP20_CONSTEXPR
-    small_vector (size_type count, const_reference value, const allocator_type& alloc)
+    small_vector (count_type count, const_reference value, const allocator_type& alloc)
 #ifdef GCH_LIB_CONCEPTS
       requires CopyInsertable
 #endif
-      : base (count, value, alloc)
+      : base (base::checked_count (count), value, alloc)
+    { }
+
+    GCH_CPP20_CONSTEXPR
+    small_vector (count_type count, for_overwrite_t)
+#ifdef GCH_LIB_CONCEPTS
+      requires DefaultInsertable && concepts::DefaultConstructible<allocator_type>
+#endif
+      : small_vector (count, for_overwrite, allocator_type ())
+    { }
+
+    GCH_CPP20_CONSTEXPR
+    small_vector (count_type count, for_overwrite_t, const allocator_type& alloc)
+#ifdef GCH_LIB_CONCEPTS
+      requires DefaultInsertable
+#endif
+      : base (base::checked_count (count), for_overwrite, alloc)
+    { }
+
+    // Takes ownership of `p`, which must have been allocated for `capacity` elements by an
+    // allocator equal to `alloc`, and whose first `size` elements are constructed. If `capacity`
+    // is not greater than `InlineCapacity`, the elements are moved into the inline storage and `p`
+    // is deallocated. This is not available with `small_vector_layout::heap_header`.
+    GCH_CPP20_CONSTEXPR
+    small_vector (adopt_allocation_t, pointer p, size_type size, size_type capacity)
+#ifdef GCH_LIB_CONCEPTS
+      requires MoveInsertable && concepts::DefaultConstructible<allocator_type>
+#endif
+      : small_vector (adopt_allocation, p, size, capacity, allocator_type ())
+    { }
+
+    GCH_CPP20_CONSTEXPR
+    small_vector (adopt_allocation_t, pointer p, size_type size, size_type capacity,
+                  const allocator_type& alloc)
+#ifdef GCH_LIB_CONCEPTS
+      requires MoveInsertable
+#endif
+      : base (adopt_allocation, p, size, capacity, alloc)
     { }
 
 #ifdef GCH_LIB_CONCEPTS
@@ -5266,7 +7767,7 @@ namespace gch
                 &&! std::is_convertible<Generator, const allocator_type&>::value>::type * = nullptr>
 #endif
     GCH_CPP20_CONSTEXPR
-    small_vector (size_type count, Generator g)
+    small_vector (count_type count, Generator g)
       : small_vector (count, g, allocator_type ())
     { }
 
@@ -5281,8 +7782,8 @@ namespace gch
                 &&! std::is_convertible<Generator, const allocator_type&>::value>::type * = nullptr>
 #endif
     GCH_CPP20_CONSTEXPR
-    small_vector (size_type count, Generator g, const allocator_type& alloc)
-      : base (count, g, alloc)
+    small_vector (count_type count, Generator g, const allocator_type& alloc)
+      : base (base::checked_count (count), g, alloc)
     { }
 
 #ifdef GCH_LIB_CONCEPTS
@@ -5342,7 +7843,7 @@ namespace gch
     requires CopyInsertable
 #endif
     GCH_CPP20_CONSTEXPR explicit
-    small_vector (const small_vector<T, I, Allocator>& other)
+    small_vector (const small_vector<T, I, Allocator, Options>& other)
       : base (base::bypass, other)
     { }
 
@@ -5351,7 +7852,7 @@ namespace gch
     requires MoveInsertable
 #endif
     GCH_CPP20_CONSTEXPR explicit
-    small_vector (small_vector<T, I, Allocator>&& other)
+    small_vector (small_vector<T, I, Allocator, Options>&& other)
       noexcept (std::is_nothrow_move_constructible<value_type>::value && I < InlineCapacity)
       : base (base::bypass, std::move (other))
     { }
@@ -5361,7 +7862,7 @@ namespace gch
     requires CopyInsertable
 #endif
     GCH_CPP20_CONSTEXPR
-    small_vector (const small_vector<T, I, Allocator>& other, const allocator_type& alloc)
+    small_vector (const small_vector<T, I, Allocator, Options>& other, const allocator_type& alloc)
       : base (base::bypass, other, alloc)
     { }
 
@@ -5370,7 +7871,7 @@ namespace gch
     requires MoveInsertable
 #endif
     GCH_CPP20_CONSTEXPR
-    small_vector (small_vector<T, I, Allocator>&& other, const allocator_type& alloc)
+    small_vector (small_vector<T, I, Allocator, Options>&& other, const allocator_type& alloc)
       : base (base::bypass, std::move (other), alloc)
     { }
 
@@ -5432,12 +7933,12 @@ namespace gch
 
     GCH_CPP20_CONSTEXPR
     void
-    assign (size_type count, const_reference value)
+    assign (count_type count, const_reference value)
 #ifdef GCH_LIB_CONCEPTS
       requires CopyInsertable && CopyAssignable
 #endif
     {
-      base::assign_with_copies (count, value);
+      base::assign_with_copies (base::checked_count (count), value);
     }
 
 #ifdef GCH_LIB_CONCEPTS
@@ -5486,7 +7987,7 @@ namespace gch
 #endif
     GCH_CPP20_CONSTEXPR
     void
-    assign (const small_vector<T, I, Allocator>& other)
+    assign (const small_vector<T, I, Allocator, Options>& other)
     {
       base::copy_assign (other);
     }
@@ -5520,7 +8021,7 @@ namespace gch
 #endif
     GCH_CPP20_CONSTEXPR
     void
-    assign (small_vector<T, I, Allocator>&& other)
+    assign (small_vector<T, I, Allocator, Options>&& other)
       noexcept (  I <= InlineCapacity
               &&  (  std::is_same<std::allocator<value_type>, Allocator>::value
                  ||  std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value
@@ -5611,7 +8112,7 @@ namespace gch
              >
     GCH_CPP20_CONSTEXPR
     void
-    swap (small_vector<T, I, Allocator>& other)
+    swap (small_vector<T, I, Allocator, Options>& other)
 #ifdef GCH_LIB_CONCEPTS
       requires (MoveInsertable && MoveAssignable && Swappable)
            ||  (  (  std::is_same<std::allocator<value_type>, Allocator>::value
@@ -5841,12 +8342,13 @@ namespace gch
 
     GCH_CPP20_CONSTEXPR
     iterator
-    insert (const_iterator pos, size_type count, const_reference value)
+    insert (const_iterator pos, count_type count, const_reference value)
 #ifdef GCH_LIB_CONCEPTS
       requires CopyInsertable && CopyAssignable
 #endif
     {
-      return iterator (base::insert_copies (base::ptr_cast (pos), count, value));
+      return iterator (
+        base::insert_copies (base::ptr_cast (pos), base::checked_count (count), value));
     }
 
     // Note: Unlike std::vector, this does not require MoveConstructible because we
@@ -5900,6 +8402,74 @@ namespace gch
       return iterator (base::emplace_at (base::ptr_cast (pos), std::forward<Args> (args)...));
     }
 
+    // The `try_` functions return false (or a null pointer) instead of throwing if the vector needs
+    // to grow and the allocation fails, and leave the vector unchanged. If the allocator is
+    // `std::allocator`, the allocation uses the non-throwing `operator new`. Other allocators may
+    // define `try_allocate_at_least` to return a null pointer on failure. Otherwise, only
+    // `std::bad_alloc` is caught.
+    GCH_NODISCARD GCH_CPP20_CONSTEXPR
+    bool
+    try_insert (const_iterator pos, const_reference value)
+#ifdef GCH_LIB_CONCEPTS
+      requires CopyInsertable && CopyAssignable
+#endif
+    {
+      return base::try_emplace_at (base::ptr_cast (pos), value) != nullptr;
+    }
+
+    GCH_NODISCARD GCH_CPP20_CONSTEXPR
+    bool
+    try_insert (const_iterator pos, value_type&& value)
+#ifdef GCH_LIB_CONCEPTS
+      requires MoveInsertable && MoveAssignable
+#endif
+    {
+      return base::try_emplace_at (base::ptr_cast (pos), std::move (value)) != nullptr;
+    }
+
+    GCH_NODISCARD GCH_CPP20_CONSTEXPR
+    bool
+    try_insert (const_iterator pos, count_type count, const_reference value)
+#ifdef GCH_LIB_CONCEPTS
+      requires CopyInsertable && CopyAssignable
+#endif
+    {
+      return base::is_representable_count (count)
+         &&  base::try_insert_copies (base::ptr_cast (pos), static_cast<size_type> (count), value);
+    }
+
+#ifdef GCH_LIB_CONCEPTS
+    template <std::input_iterator InputIt>
+    requires EmplaceConstructible<std::iter_reference_t<InputIt>>::value
+         &&  MoveInsertable
+         &&  MoveAssignable
+#else
+    template <typename InputIt,
+              typename std::enable_if<std::is_base_of<
+                std::input_iterator_tag,
+                typename std::iterator_traits<InputIt>::iterator_category
+                >::value>::type * = nullptr>
+#endif
+    GCH_NODISCARD GCH_CPP20_CONSTEXPR
+    bool
+    try_insert (const_iterator pos, InputIt first, InputIt last)
+    {
+      using iterator_cat = typename std::iterator_traits<InputIt>::iterator_category;
+      return base::try_insert_range (base::ptr_cast (pos), first, last, iterator_cat { });
+    }
+
+    GCH_NODISCARD GCH_CPP20_CONSTEXPR
+    bool
+    try_insert (const_iterator pos, std::initializer_list<value_type> ilist)
+#ifdef GCH_LIB_CONCEPTS
+      requires EmplaceConstructible<const_reference>::value
+           &&  MoveInsertable
+           &&  MoveAssignable
+#endif
+    {
+      return try_insert (pos, ilist.begin (), ilist.end ());
+    }
+
     GCH_CPP20_CONSTEXPR
     iterator
     erase (const_iterator pos)
@@ -5910,7 +8480,7 @@ namespace gch
       assert (0 <= (pos    - begin ()) && "`pos` is out of bounds (before `begin ()`)."   );
       assert (0 <  (end () - pos)      && "`pos` is out of bounds (at or after `end ()`).");
 
-      return iterator (base::erase_at (base::ptr_cast (pos)));
+      return iterator (base::apply_shrink_policy (base::erase_at (base::ptr_cast (pos))));
     }
 
     GCH_CPP20_CONSTEXPR
@@ -5924,7 +8494,8 @@ namespace gch
       assert (0 <= (first  - begin ()) && "`first` is out of bounds (before `begin ()`)."  );
       assert (0 <= (end () - last)     && "`last` is out of bounds (after `end ()`).");
 
-      return iterator (base::erase_range (base::ptr_cast (first), base::ptr_cast (last)));
+      return iterator (base::apply_shrink_policy (
+        base::erase_range (base::ptr_cast (first), base::ptr_cast (last))));
     }
 
     GCH_CPP20_CONSTEXPR
@@ -5958,6 +8529,73 @@ namespace gch
       return *base::append_element (std::forward<Args> (args)...);
     }
 
+    GCH_CPP20_CONSTEXPR
+    void
+    unchecked_push_back (const_reference value)
+#ifdef GCH_LIB_CONCEPTS
+      requires CopyInsertable
+#endif
+    {
+      unchecked_emplace_back (value);
+    }
+
+    GCH_CPP20_CONSTEXPR
+    void
+    unchecked_push_back (value_type&& value)
+#ifdef GCH_LIB_CONCEPTS
+      requires MoveInsertable
+#endif
+    {
+      unchecked_emplace_back (std::move (value));
+    }
+
+    // Like `emplace_back`, but the caller guarantees that `size () < capacity ()`, so the vector
+    // never grows. This keeps the reallocation path out of loops which have already reserved.
+    template <typename ...Args>
+#ifdef GCH_LIB_CONCEPTS
+    requires EmplaceConstructible<Args...>::value
+#endif
+    GCH_CPP20_CONSTEXPR
+    reference
+    unchecked_emplace_back (Args&&... args)
+    {
+      assert (size () < capacity ()
+              &&  "`unchecked_emplace_back ()` called on a full `small_vector`.");
+      return *base::emplace_into_current_end (std::forward<Args> (args)...);
+    }
+
+    GCH_NODISCARD GCH_CPP20_CONSTEXPR
+    pointer
+    try_push_back (const_reference value)
+#ifdef GCH_LIB_CONCEPTS
+      requires CopyInsertable
+#endif
+    {
+      return try_emplace_back (value);
+    }
+
+    GCH_NODISCARD GCH_CPP20_CONSTEXPR
+    pointer
+    try_push_back (value_type&& value)
+#ifdef GCH_LIB_CONCEPTS
+      requires MoveInsertable
+#endif
+    {
+      return try_emplace_back (std::move (value));
+    }
+
+    // Returns a pointer to the new element, or a null pointer if the vector could not grow.
+    template <typename ...Args>
+#ifdef GCH_LIB_CONCEPTS
+    requires EmplaceConstructible<Args...>::value && MoveInsertable
+#endif
+    GCH_NODISCARD GCH_CPP20_CONSTEXPR
+    pointer
+    try_emplace_back (Args&&... args)
+    {
+      return base::try_append_element (std::forward<Args> (args)...);
+    }
+
     GCH_CPP20_CONSTEXPR
     void
     pop_back (void)
@@ -5967,16 +8605,28 @@ namespace gch
     {
       assert (! empty () && "`pop_back ()` called on an empty `small_vector`.");
       base::erase_last ();
+      base::apply_shrink_policy ();
     }
 
     GCH_CPP20_CONSTEXPR
     void
-    reserve (size_type new_capacity)
+    reserve (count_type new_capacity)
+#ifdef GCH_LIB_CONCEPTS
+      requires MoveInsertable
+#endif
+    {
+      base::request_capacity (base::checked_count (new_capacity));
+    }
+
+    GCH_NODISCARD GCH_CPP20_CONSTEXPR
+    bool
+    try_reserve (count_type new_capacity)
 #ifdef GCH_LIB_CONCEPTS
       requires MoveInsertable
 #endif
     {
-      base::request_capacity (new_capacity);
+      return base::is_representable_count (new_capacity)
+         &&  base::try_request_capacity (static_cast<size_type> (new_capacity));
     }
 
     GCH_CPP20_CONSTEXPR
@@ -5997,33 +8647,124 @@ namespace gch
 #endif
     {
       base::erase_all ();
+      base::apply_shrink_policy ();
+    }
+
+    // Destroys the elements and moves back to the inline storage, releasing the allocation.
+    GCH_CPP20_CONSTEXPR
+    void
+    reset (void) noexcept
+#ifdef GCH_LIB_CONCEPTS
+      requires Erasable
+#endif
+    {
+      base::reset_to_inline_storage ();
+    }
+
+    // Hands the allocation and the elements in it over to the caller, and leaves the vector empty
+    // and inlined. If the elements are inlined, they are first moved to a new allocation with
+    // exactly enough room for them. This is not available with `small_vector_layout::heap_header`.
+    GCH_NODISCARD GCH_CPP20_CONSTEXPR
+    small_vector_allocation<pointer, size_type, allocator_type>
+    release (void)
+#ifdef GCH_LIB_CONCEPTS
+      requires MoveInsertable
+#endif
+    {
+      return base::release_allocation ();
     }
 
     GCH_CPP20_CONSTEXPR
     void
-    resize (size_type count)
+    resize (count_type count)
 #ifdef GCH_LIB_CONCEPTS
       requires MoveInsertable && DefaultInsertable
 #endif
     {
-      base::resize_with (count);
+      base::resize_with (base::checked_count (count));
     }
 
     GCH_CPP20_CONSTEXPR
     void
-    resize (size_type count, const_reference value)
+    resize (count_type count, const_reference value)
+#ifdef GCH_LIB_CONCEPTS
+      requires CopyInsertable
+#endif
+    {
+      base::resize_with (base::checked_count (count), value);
+    }
+
+    GCH_NODISCARD GCH_CPP20_CONSTEXPR
+    bool
+    try_resize (count_type count)
+#ifdef GCH_LIB_CONCEPTS
+      requires MoveInsertable && DefaultInsertable
+#endif
+    {
+      return base::is_representable_count (count)
+         &&  base::try_resize_with (static_cast<size_type> (count));
+    }
+
+    GCH_NODISCARD GCH_CPP20_CONSTEXPR
+    bool
+    try_resize (count_type count, const_reference value)
 #ifdef GCH_LIB_CONCEPTS
       requires CopyInsertable
 #endif
     {
-      base::resize_with (count, value);
+      return base::is_representable_count (count)
+         &&  base::try_resize_with (static_cast<size_type> (count), value);
+    }
+
+    // Like `resize`, but new elements are default-initialized. Elements of trivial types are left
+    // with indeterminate values, which must be overwritten before they are read.
+    GCH_CPP20_CONSTEXPR
+    void
+    resize_for_overwrite (count_type count)
+#ifdef GCH_LIB_CONCEPTS
+      requires MoveInsertable && DefaultInsertable
+#endif
+    {
+      base::resize_with (base::checked_count (count), for_overwrite);
+    }
+
+    // Like `std::basic_string::resize_and_overwrite`. Resizes to `count` elements as if by
+    // `resize_for_overwrite`, then calls `op (data (), count)`, which returns the new size. If the
+    // vector grows, it allocates exactly `count` elements. If `op` returns more than `count`, the
+    // new elements are erased and `std::length_error` is thrown.
+    template <typename Operation>
+    GCH_CPP20_CONSTEXPR
+    void
+    resize_and_overwrite (count_type count, Operation op)
+#ifdef GCH_LIB_CONCEPTS
+      requires MoveInsertable && DefaultInsertable
+#endif
+    {
+      base::resize_and_overwrite (base::checked_count (count), op);
+    }
+
+    // Appends `max_count` elements as if by `resize_for_overwrite`, then calls `op (p, max_count)`,
+    // where `p` points to the first appended element. `op` returns the number of appended elements
+    // to keep. The vector grows according to the growth policy. If `op` returns more than
+    // `max_count`, the appended elements are erased and `std::length_error` is thrown.
+    template <typename Operation>
+    GCH_CPP20_CONSTEXPR
+    void
+    append_and_overwrite (count_type max_count, Operation op)
+#ifdef GCH_LIB_CONCEPTS
+      requires MoveInsertable && DefaultInsertable
+#endif
+    {
+      base::append_and_overwrite (base::checked_count (max_count), op);
     }
 
+    // This is also true if the elements are in an external buffer provided by the allocator,
+    // such as with `gch::buffer_allocator`.
     GCH_NODISCARD constexpr
     bool
     inlined (void) const noexcept
     {
-      return ! base::has_allocation ();
+      return ! base::has_allocation () || base::is_external_buffer (base::data_ptr ());
     }
 
     GCH_NODISCARD constexpr
@@ -6076,7 +8817,7 @@ namespace gch
     template <unsigned I>
     GCH_CPP20_CONSTEXPR
     small_vector&
-    append (const small_vector<T, I, Allocator>& other)
+    append (const small_vector<T, I, Allocator, Options>& other)
 #ifdef GCH_LIB_CONCEPTS
       requires CopyInsertable
 #endif
@@ -6087,7 +8828,7 @@ namespace gch
     template <unsigned I>
     GCH_CPP20_CONSTEXPR
     small_vector&
-    append (small_vector<T, I, Allocator>&& other)
+    append (small_vector<T, I, Allocator, Options>&& other)
 #ifdef GCH_LIB_CONCEPTS
       requires MoveInsertable
 #endif
@@ -6102,34 +8843,86 @@ namespace gch
       other.clear ();
       return *this;
     }
+
+    // Like `append`, but the caller guarantees that there is enough capacity for the range.
+#ifdef GCH_LIB_CONCEPTS
+    template <std::input_iterator InputIt>
+    requires EmplaceConstructible<std::iter_reference_t<InputIt>>::value
+#else
+    template <typename InputIt,
+              typename std::enable_if<std::is_base_of<
+                std::input_iterator_tag,
+                typename std::iterator_traits<InputIt>::iterator_category
+                >::value>::type * = nullptr>
+#endif
+    GCH_CPP20_CONSTEXPR
+    small_vector&
+    unchecked_append (InputIt first, InputIt last)
+    {
+      using iterator_cat = typename std::iterator_traits<InputIt>::iterator_category;
+      base::append_range_unchecked (first, last, iterator_cat { });
+      return *this;
+    }
+
+#ifdef GCH_LIB_CONCEPTS
+    template <std::input_iterator InputIt>
+    requires EmplaceConstructible<std::iter_reference_t<InputIt>>::value
+         &&  MoveInsertable
+#else
+    template <typename InputIt,
+              typename std::enable_if<std::is_base_of<
+                std::input_iterator_tag,
+                typename std::iterator_traits<InputIt>::iterator_category
+                >::value>::type * = nullptr>
+#endif
+    GCH_NODISCARD GCH_CPP20_CONSTEXPR
+    bool
+    try_append (InputIt first, InputIt last)
+    {
+      using iterator_cat = typename std::iterator_traits<InputIt>::iterator_category;
+      return base::try_append_range (first, last, iterator_cat { });
+    }
+
+    GCH_NODISCARD GCH_CPP20_CONSTEXPR
+    bool
+    try_append (std::initializer_list<value_type> ilist)
+#ifdef GCH_LIB_CONCEPTS
+      requires EmplaceConstructible<const_reference>::value
+           &&  MoveInsertable
+#endif
+    {
+      return try_append (ilist.begin (), ilist.end ());
+    }
   };
 
-  template <typename T, unsigned InlineCapacityLHS, unsigned InlineCapacityRHS, typename Allocator>
+  template <typename T, unsigned InlineCapacityLHS, unsigned InlineCapacityRHS, typename Allocator,
+            typename Options>
   inline GCH_CPP20_CONSTEXPR
   bool
-  operator== (const small_vector<T, InlineCapacityLHS, Allocator>& lhs,
-              const small_vector<T, InlineCapacityRHS, Allocator>& rhs)
+  operator== (const small_vector<T, InlineCapacityLHS, Allocator, Options>& lhs,
+              const small_vector<T, InlineCapacityRHS, Allocator, Options>& rhs)
   {
     return lhs.size () == rhs.size () && std::equal (lhs.begin (), lhs.end (), rhs.begin ());
   }
 
-  template <typename T, unsigned InlineCapacity, typename Allocator>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options>
   inline GCH_CPP20_CONSTEXPR
   bool
-  operator== (const small_vector<T, InlineCapacity, Allocator>& lhs,
-              const small_vector<T, InlineCapacity, Allocator>& rhs)
+  operator== (const small_vector<T, InlineCapacity, Allocator, Options>& lhs,
+              const small_vector<T, InlineCapacity, Allocator, Options>& rhs)
   {
     return lhs.size () == rhs.size () && std::equal (lhs.begin (), lhs.end (), rhs.begin ());
   }
 
 #ifdef GCH_LIB_THREE_WAY_COMPARISON
 
-  template <typename T, unsigned InlineCapacityLHS, unsigned InlineCapacityRHS, typename Allocator>
+  template <typename T, unsigned InlineCapacityLHS, unsigned InlineCapacityRHS, typename Allocator,
+            typename Options>
   requires std::three_way_comparable<T>
   constexpr
   auto
-  operator<=> (const small_vector<T, InlineCapacityLHS, Allocator>& lhs,
-               const small_vector<T, InlineCapacityRHS, Allocator>& rhs)
+  operator<=> (const small_vector<T, InlineCapacityLHS, Allocator, Options>& lhs,
+               const small_vector<T, InlineCapacityRHS, Allocator, Options>& rhs)
   {
     return std::lexicographical_compare_three_way (
       lhs.begin (), lhs.end (),
@@ -6137,12 +8930,12 @@ namespace gch
       std::compare_three_way { });
   }
 
-  template <typename T, unsigned InlineCapacity, typename Allocator>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options>
   requires std::three_way_comparable<T>
   constexpr
   auto
-  operator<=> (const small_vector<T, InlineCapacity, Allocator>& lhs,
-               const small_vector<T, InlineCapacity, Allocator>& rhs)
+  operator<=> (const small_vector<T, InlineCapacity, Allocator, Options>& lhs,
+               const small_vector<T, InlineCapacity, Allocator, Options>& rhs)
   {
     return std::lexicographical_compare_three_way (
       lhs.begin (), lhs.end (),
@@ -6150,11 +8943,12 @@ namespace gch
       std::compare_three_way { });
   }
 
-  template <typename T, unsigned InlineCapacityLHS, unsigned InlineCapacityRHS, typename Allocator>
+  template <typename T, unsigned InlineCapacityLHS, unsigned InlineCapacityRHS, typename Allocator,
+            typename Options>
   constexpr
   auto
-  operator<=> (const small_vector<T, InlineCapacityLHS, Allocator>& lhs,
-               const small_vector<T, InlineCapacityRHS, Allocator>& rhs)
+  operator<=> (const small_vector<T, InlineCapacityLHS, Allocator, Options>& lhs,
+               const small_vector<T, InlineCapacityRHS, Allocator, Options>& rhs)
   {
     constexpr auto comparison = [](const T& l, const T& r) {
       return (l < r) ? std::weak_ordering::less
@@ -6168,11 +8962,11 @@ namespace gch
       comparison);
   }
 
-  template <typename T, unsigned InlineCapacity, typename Allocator>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options>
   constexpr
   auto
-  operator<=> (const small_vector<T, InlineCapacity, Allocator>& lhs,
-               const small_vector<T, InlineCapacity, Allocator>& rhs)
+  operator<=> (const small_vector<T, InlineCapacity, Allocator, Options>& lhs,
+               const small_vector<T, InlineCapacity, Allocator, Options>& rhs)
   {
     constexpr auto comparison = [](const T& l, const T& r) {
       return (l < r) ? std::weak_ordering::less
@@ -6188,99 +8982,105 @@ namespace gch
 
 #else
 
-  template <typename T, unsigned InlineCapacityLHS, unsigned InlineCapacityRHS, typename Allocator>
+  template <typename T, unsigned InlineCapacityLHS, unsigned InlineCapacityRHS, typename Allocator,
+            typename Options>
   inline GCH_CPP20_CONSTEXPR
   bool
-  operator!= (const small_vector<T, InlineCapacityLHS, Allocator>& lhs,
-              const small_vector<T, InlineCapacityRHS, Allocator>& rhs)
+  operator!= (const small_vector<T, InlineCapacityLHS, Allocator, Options>& lhs,
+              const small_vector<T, InlineCapacityRHS, Allocator, Options>& rhs)
   {
     return ! (lhs == rhs);
   }
 
-  template <typename T, unsigned InlineCapacity, typename Allocator>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options>
   inline GCH_CPP20_CONSTEXPR
   bool
-  operator!= (const small_vector<T, InlineCapacity, Allocator>& lhs,
-              const small_vector<T, InlineCapacity, Allocator>& rhs)
+  operator!= (const small_vector<T, InlineCapacity, Allocator, Options>& lhs,
+              const small_vector<T, InlineCapacity, Allocator, Options>& rhs)
   {
     return ! (lhs == rhs);
   }
 
-  template <typename T, unsigned InlineCapacityLHS, unsigned InlineCapacityRHS, typename Allocator>
+  template <typename T, unsigned InlineCapacityLHS, unsigned InlineCapacityRHS, typename Allocator,
+            typename Options>
   inline GCH_CPP20_CONSTEXPR
   bool
-  operator<  (const small_vector<T, InlineCapacityLHS, Allocator>& lhs,
-              const small_vector<T, InlineCapacityRHS, Allocator>& rhs)
+  operator<  (const small_vector<T, InlineCapacityLHS, Allocator, Options>& lhs,
+              const small_vector<T, InlineCapacityRHS, Allocator, Options>& rhs)
   {
     return std::lexicographical_compare (lhs.begin (), lhs.end (), rhs.begin (), rhs.end ());
   }
 
-  template <typename T, unsigned InlineCapacity, typename Allocator>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options>
   inline GCH_CPP20_CONSTEXPR
   bool
-  operator<  (const small_vector<T, InlineCapacity, Allocator>& lhs,
-              const small_vector<T, InlineCapacity, Allocator>& rhs)
+  operator<  (const small_vector<T, InlineCapacity, Allocator, Options>& lhs,
+              const small_vector<T, InlineCapacity, Allocator, Options>& rhs)
   {
     return std::lexicographical_compare (lhs.begin (), lhs.end (), rhs.begin (), rhs.end ());
   }
 
-  template <typename T, unsigned InlineCapacityLHS, unsigned InlineCapacityRHS, typename Allocator>
+  template <typename T, unsigned InlineCapacityLHS, unsigned InlineCapacityRHS, typename Allocator,
+            typename Options>
   inline GCH_CPP20_CONSTEXPR
   bool
-  operator>= (const small_vector<T, InlineCapacityLHS, Allocator>& lhs,
-              const small_vector<T, InlineCapacityRHS, Allocator>& rhs)
+  operator>= (const small_vector<T, InlineCapacityLHS, Allocator, Options>& lhs,
+              const small_vector<T, InlineCapacityRHS, Allocator, Options>& rhs)
   {
     return ! (lhs < rhs);
   }
 
-  template <typename T, unsigned InlineCapacity, typename Allocator>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options>
   inline GCH_CPP20_CONSTEXPR
   bool
-  operator>= (const small_vector<T, InlineCapacity, Allocator>& lhs,
-              const small_vector<T, InlineCapacity, Allocator>& rhs)
+  operator>= (const small_vector<T, InlineCapacity, Allocator, Options>& lhs,
+              const small_vector<T, InlineCapacity, Allocator, Options>& rhs)
   {
     return ! (lhs < rhs);
   }
 
-  template <typename T, unsigned InlineCapacityLHS, unsigned InlineCapacityRHS, typename Allocator>
+  template <typename T, unsigned InlineCapacityLHS, unsigned InlineCapacityRHS, typename Allocator,
+            typename Options>
   inline GCH_CPP20_CONSTEXPR
   bool
-  operator>  (const small_vector<T, InlineCapacityLHS, Allocator>& lhs,
-              const small_vector<T, InlineCapacityRHS, Allocator>& rhs)
+  operator>  (const small_vector<T, InlineCapacityLHS, Allocator, Options>& lhs,
+              const small_vector<T, InlineCapacityRHS, Allocator, Options>& rhs)
   {
     return rhs < lhs;
   }
 
-  template <typename T, unsigned InlineCapacity, typename Allocator>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options>
   inline GCH_CPP20_CONSTEXPR
   bool
-  operator>  (const small_vector<T, InlineCapacity, Allocator>& lhs,
-              const small_vector<T, InlineCapacity, Allocator>& rhs)
+  operator>  (const small_vector<T, InlineCapacity, Allocator, Options>& lhs,
+              const small_vector<T, InlineCapacity, Allocator, Options>& rhs)
   {
     return rhs < lhs;
   }
 
-  template <typename T, unsigned InlineCapacityLHS, unsigned InlineCapacityRHS, typename Allocator>
+  template <typename T, unsigned InlineCapacityLHS, unsigned InlineCapacityRHS, typename Allocator,
+            typename Options>
   inline GCH_CPP20_CONSTEXPR
   bool
-  operator<= (const small_vector<T, InlineCapacityLHS, Allocator>& lhs,
-              const small_vector<T, InlineCapacityRHS, Allocator>& rhs)
+  operator<= (const small_vector<T, InlineCapacityLHS, Allocator, Options>& lhs,
+              const small_vector<T, InlineCapacityRHS, Allocator, Options>& rhs)
   {
     return rhs >= lhs;
   }
 
-  template <typename T, unsigned InlineCapacity, typename Allocator>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options>
   inline GCH_CPP20_CONSTEXPR
   bool
-  operator<= (const small_vector<T, InlineCapacity, Allocator>& lhs,
-              const small_vector<T, InlineCapacity, Allocator>& rhs)
+  operator<= (const small_vector<T, InlineCapacity, Allocator, Options>& lhs,
+              const small_vector<T, InlineCapacity, Allocator, Options>& rhs)
   {
     return rhs >= lhs;
   }
 
 #endif
 
-  template <typename T, unsigned InlineCapacity, typename Allocator
+  template <typename T, unsigned InlineCapacity, typename Allocator,
+            typename Options
 #ifndef GCH_LIB_CONCEPTS
           , typename std::enable_if<std::is_move_constructible<T>::value
                                 &&  std::is_move_assignable<T>::value
@@ -6292,11 +9092,12 @@ namespace gch
             >
   inline GCH_CPP20_CONSTEXPR
   void
-  swap (small_vector<T, InlineCapacity, Allocator>& lhs,
-        small_vector<T, InlineCapacity, Allocator>& rhs)
+  swap (small_vector<T, InlineCapacity, Allocator, Options>& lhs,
+        small_vector<T, InlineCapacity, Allocator, Options>& rhs)
     noexcept (noexcept (lhs.swap (rhs)))
 #ifdef GCH_LIB_CONCEPTS
-    requires concepts::MoveInsertable<T, small_vector<T, InlineCapacity, Allocator>, Allocator>
+    requires concepts::MoveInsertable<T, small_vector<T, InlineCapacity, Allocator, Options>,
+                                      Allocator>
           && concepts::MoveAssignable<T>
           && concepts::Swappable<T>
 #endif
@@ -6304,7 +9105,8 @@ namespace gch
     lhs.swap (rhs);
   }
 
-  template <typename T, unsigned InlineCapacityLHS, unsigned InlineCapacityRHS, typename Allocator
+  template <typename T, unsigned InlineCapacityLHS, unsigned InlineCapacityRHS, typename Allocator,
+            typename Options
 #ifndef GCH_LIB_CONCEPTS
           , typename std::enable_if<std::is_move_constructible<T>::value
                                 &&  std::is_move_assignable<T>::value
@@ -6316,11 +9118,12 @@ namespace gch
             >
   inline GCH_CPP20_CONSTEXPR
   void
-  swap (small_vector<T, InlineCapacityLHS, Allocator>& lhs,
-        small_vector<T, InlineCapacityRHS, Allocator>& rhs)
+  swap (small_vector<T, InlineCapacityLHS, Allocator, Options>& lhs,
+        small_vector<T, InlineCapacityRHS, Allocator, Options>& rhs)
     noexcept (noexcept (lhs.swap (rhs)))
 #ifdef GCH_LIB_CONCEPTS
-    requires concepts::MoveInsertable<T, small_vector<T, InlineCapacityLHS, Allocator>, Allocator>
+    requires concepts::MoveInsertable<T, small_vector<T, InlineCapacityLHS, Allocator, Options>,
+                                      Allocator>
           && concepts::MoveAssignable<T>
           && concepts::Swappable<T>
 #endif
@@ -6328,137 +9131,138 @@ namespace gch
     lhs.swap (rhs);
   }
 
-  template <typename T, unsigned InlineCapacity, typename Allocator, typename U>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options, typename U>
   inline GCH_CPP20_CONSTEXPR
-  typename small_vector<T, InlineCapacity, Allocator>::size_type
-  erase (small_vector<T, InlineCapacity, Allocator>& v, const U& value)
+  typename small_vector<T, InlineCapacity, Allocator, Options>::size_type
+  erase (small_vector<T, InlineCapacity, Allocator, Options>& v, const U& value)
   {
     const auto original_size = v.size ();
     v.erase (std::remove (v.begin (), v.end (), value), v.end ());
     return original_size - v.size ();
   }
 
-  template <typename T, unsigned InlineCapacity, typename Allocator, typename Pred>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options,
+            typename Pred>
   inline GCH_CPP20_CONSTEXPR
-  typename small_vector<T, InlineCapacity, Allocator>::size_type
-  erase_if (small_vector<T, InlineCapacity, Allocator>& v, Pred pred)
+  typename small_vector<T, InlineCapacity, Allocator, Options>::size_type
+  erase_if (small_vector<T, InlineCapacity, Allocator, Options>& v, Pred pred)
   {
     const auto original_size = v.size ();
     v.erase (std::remove_if (v.begin (), v.end (), pred), v.end ());
     return original_size - v.size ();
   }
 
-  template <typename T, unsigned InlineCapacity, typename Allocator>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options>
   constexpr
-  typename small_vector<T, InlineCapacity, Allocator>::iterator
-  begin (small_vector<T, InlineCapacity, Allocator>& v) noexcept
+  typename small_vector<T, InlineCapacity, Allocator, Options>::iterator
+  begin (small_vector<T, InlineCapacity, Allocator, Options>& v) noexcept
   {
     return v.begin ();
   }
 
-  template <typename T, unsigned InlineCapacity, typename Allocator>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options>
   constexpr
-  typename small_vector<T, InlineCapacity, Allocator>::const_iterator
-  begin (const small_vector<T, InlineCapacity, Allocator>& v) noexcept
+  typename small_vector<T, InlineCapacity, Allocator, Options>::const_iterator
+  begin (const small_vector<T, InlineCapacity, Allocator, Options>& v) noexcept
   {
     return v.begin ();
   }
 
-  template <typename T, unsigned InlineCapacity, typename Allocator>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options>
   constexpr
-  typename small_vector<T, InlineCapacity, Allocator>::const_iterator
-  cbegin (const small_vector<T, InlineCapacity, Allocator>& v) noexcept
+  typename small_vector<T, InlineCapacity, Allocator, Options>::const_iterator
+  cbegin (const small_vector<T, InlineCapacity, Allocator, Options>& v) noexcept
   {
     return begin (v);
   }
 
-  template <typename T, unsigned InlineCapacity, typename Allocator>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options>
   constexpr
-  typename small_vector<T, InlineCapacity, Allocator>::iterator
-  end (small_vector<T, InlineCapacity, Allocator>& v) noexcept
+  typename small_vector<T, InlineCapacity, Allocator, Options>::iterator
+  end (small_vector<T, InlineCapacity, Allocator, Options>& v) noexcept
   {
     return v.end ();
   }
 
-  template <typename T, unsigned InlineCapacity, typename Allocator>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options>
   constexpr
-  typename small_vector<T, InlineCapacity, Allocator>::const_iterator
-  end (const small_vector<T, InlineCapacity, Allocator>& v) noexcept
+  typename small_vector<T, InlineCapacity, Allocator, Options>::const_iterator
+  end (const small_vector<T, InlineCapacity, Allocator, Options>& v) noexcept
   {
     return v.end ();
   }
 
-  template <typename T, unsigned InlineCapacity, typename Allocator>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options>
   constexpr
-  typename small_vector<T, InlineCapacity, Allocator>::const_iterator
-  cend (const small_vector<T, InlineCapacity, Allocator>& v) noexcept
+  typename small_vector<T, InlineCapacity, Allocator, Options>::const_iterator
+  cend (const small_vector<T, InlineCapacity, Allocator, Options>& v) noexcept
   {
     return end (v);
   }
 
-  template <typename T, unsigned InlineCapacity, typename Allocator>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options>
   constexpr
-  typename small_vector<T, InlineCapacity, Allocator>::reverse_iterator
-  rbegin (small_vector<T, InlineCapacity, Allocator>& v) noexcept
+  typename small_vector<T, InlineCapacity, Allocator, Options>::reverse_iterator
+  rbegin (small_vector<T, InlineCapacity, Allocator, Options>& v) noexcept
   {
     return v.rbegin ();
   }
 
-  template <typename T, unsigned InlineCapacity, typename Allocator>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options>
   constexpr
-  typename small_vector<T, InlineCapacity, Allocator>::const_reverse_iterator
-  rbegin (const small_vector<T, InlineCapacity, Allocator>& v) noexcept
+  typename small_vector<T, InlineCapacity, Allocator, Options>::const_reverse_iterator
+  rbegin (const small_vector<T, InlineCapacity, Allocator, Options>& v) noexcept
   {
     return v.rbegin ();
   }
 
-  template <typename T, unsigned InlineCapacity, typename Allocator>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options>
   constexpr
-  typename small_vector<T, InlineCapacity, Allocator>::const_reverse_iterator
-  crbegin (const small_vector<T, InlineCapacity, Allocator>& v) noexcept
+  typename small_vector<T, InlineCapacity, Allocator, Options>::const_reverse_iterator
+  crbegin (const small_vector<T, InlineCapacity, Allocator, Options>& v) noexcept
   {
     return rbegin (v);
   }
 
-  template <typename T, unsigned InlineCapacity, typename Allocator>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options>
   constexpr
-  typename small_vector<T, InlineCapacity, Allocator>::reverse_iterator
-  rend (small_vector<T, InlineCapacity, Allocator>& v) noexcept
+  typename small_vector<T, InlineCapacity, Allocator, Options>::reverse_iterator
+  rend (small_vector<T, InlineCapacity, Allocator, Options>& v) noexcept
   {
     return v.rend ();
   }
 
-  template <typename T, unsigned InlineCapacity, typename Allocator>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options>
   constexpr
-  typename small_vector<T, InlineCapacity, Allocator>::const_reverse_iterator
-  rend (const small_vector<T, InlineCapacity, Allocator>& v) noexcept
+  typename small_vector<T, InlineCapacity, Allocator, Options>::const_reverse_iterator
+  rend (const small_vector<T, InlineCapacity, Allocator, Options>& v) noexcept
   {
     return v.rend ();
   }
 
-  template <typename T, unsigned InlineCapacity, typename Allocator>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options>
   constexpr
-  typename small_vector<T, InlineCapacity, Allocator>::const_reverse_iterator
-  crend (const small_vector<T, InlineCapacity, Allocator>& v) noexcept
+  typename small_vector<T, InlineCapacity, Allocator, Options>::const_reverse_iterator
+  crend (const small_vector<T, InlineCapacity, Allocator, Options>& v) noexcept
   {
     return rend (v);
   }
 
-  template <typename T, unsigned InlineCapacity, typename Allocator>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options>
   constexpr
-  typename small_vector<T, InlineCapacity, Allocator>::size_type
-  size (const small_vector<T, InlineCapacity, Allocator>& v) noexcept
+  typename small_vector<T, InlineCapacity, Allocator, Options>::size_type
+  size (const small_vector<T, InlineCapacity, Allocator, Options>& v) noexcept
   {
     return v.size ();
   }
 
-  template <typename T, unsigned InlineCapacity, typename Allocator>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options>
   constexpr
   typename std::common_type<
     std::ptrdiff_t,
     typename std::make_signed<
-      typename small_vector<T, InlineCapacity, Allocator>::size_type>::type>::type
-  ssize (const small_vector<T, InlineCapacity, Allocator>& v) noexcept
+      typename small_vector<T, InlineCapacity, Allocator, Options>::size_type>::type>::type
+  ssize (const small_vector<T, InlineCapacity, Allocator, Options>& v) noexcept
   {
     using ret_type = typename std::common_type<
       std::ptrdiff_t,
@@ -6466,26 +9270,26 @@ namespace gch
     return static_cast<ret_type> (v.size ());
   }
 
-  template <typename T, unsigned InlineCapacity, typename Allocator>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options>
   GCH_NODISCARD constexpr
   bool
-  empty (const small_vector<T, InlineCapacity, Allocator>& v) noexcept
+  empty (const small_vector<T, InlineCapacity, Allocator, Options>& v) noexcept
   {
     return v.empty ();
   }
 
-  template <typename T, unsigned InlineCapacity, typename Allocator>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options>
   constexpr
-  typename small_vector<T, InlineCapacity, Allocator>::pointer
-  data (small_vector<T, InlineCapacity, Allocator>& v) noexcept
+  typename small_vector<T, InlineCapacity, Allocator, Options>::pointer
+  data (small_vector<T, InlineCapacity, Allocator, Options>& v) noexcept
   {
     return v.data ();
   }
 
-  template <typename T, unsigned InlineCapacity, typename Allocator>
+  template <typename T, unsigned InlineCapacity, typename Allocator, typename Options>
   constexpr
-  typename small_vector<T, InlineCapacity, Allocator>::const_pointer
-  data (const small_vector<T, InlineCapacity, Allocator>& v) noexcept
+  typename small_vector<T, InlineCapacity, Allocator, Options>::const_pointer
+  data (const small_vector<T, InlineCapacity, Allocator, Options>& v) noexcept
   {
     return v.data ();
   }
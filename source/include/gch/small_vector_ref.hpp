@@ -0,0 +1,814 @@
+/** small_vector_ref.hpp
+ * A non-owning reference to a `small_vector` of any inline capacity.
+ * Functions which take a `small_vector_ref<T>` can read and grow any
+ * `small_vector<T, N>` without being templated on `N`, in the same way
+ * as `llvm::SmallVectorImpl`.
+ *
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GCH_SMALL_VECTOR_REF_HPP
+#define GCH_SMALL_VECTOR_REF_HPP
+
+#include "small_vector.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#ifndef GCH_EXCEPTIONS
+#  include <cstdio>
+#  include <cstdlib>
+#endif
+
+namespace gch
+{
+
+  namespace detail
+  {
+
+    struct small_vector_access
+    {
+      template <typename T, unsigned InlineCapacity, typename Allocator, typename Options>
+      static
+      auto
+      get_data (const small_vector<T, InlineCapacity, Allocator, Options>& v) noexcept
+        -> decltype (v.get_data ())
+      {
+        return v.get_data ();
+      }
+    };
+
+    // The data of a vector with the standard layout begins with a `small_vector_data_base`, which
+    // does not depend on the inline capacity. `small_vector_ref` reads the pointer, size, and
+    // capacity from it directly. The other layouts have no such header, so this is null for them.
+    template <typename Header, typename Layout>
+    struct small_vector_ref_header
+    {
+      template <typename Vector>
+      static
+      const Header *
+      get (const Vector&) noexcept
+      {
+        return nullptr;
+      }
+    };
+
+    template <typename Header>
+    struct small_vector_ref_header<Header, small_vector_layout::standard>
+    {
+      template <typename Vector>
+      static
+      const Header *
+      get (const Vector& v) noexcept
+      {
+        return std::addressof (small_vector_access::get_data (v));
+      }
+    };
+
+    // The operations of a `small_vector` which `small_vector_ref` calls through. There is one table
+    // for each type of vector. Operations which need copies or default-constructed elements are
+    // null if `T` does not support them, so that the table can still be built for such types.
+    template <typename T, typename Allocator, typename Options>
+    struct small_vector_ref_operations
+    {
+      // Every inline capacity has the same member types.
+      using vector_type    = small_vector<T, 0, Allocator, Options>;
+      using allocator_type = typename vector_type::allocator_type;
+      using size_type      = typename vector_type::size_type;
+      using count_type     = typename vector_type::count_type;
+      using pointer        = typename vector_type::pointer;
+      using iterator       = typename vector_type::iterator;
+      using const_iterator = typename vector_type::const_iterator;
+
+      pointer        (*data)          (const void *) noexcept;
+      size_type      (*size)          (const void *) noexcept;
+      size_type      (*capacity)      (const void *) noexcept;
+      size_type      (*max_size)      (const void *) noexcept;
+      bool           (*inlined)       (const void *) noexcept;
+      allocator_type (*get_allocator) (const void *) noexcept;
+
+      void     (*reserve)       (void *, count_type);
+      bool     (*try_reserve)   (void *, count_type);
+      void     (*shrink_to_fit) (void *);
+      void     (*clear)         (void *) noexcept;
+      void     (*reset)         (void *) noexcept;
+      void     (*resize)        (void *, count_type);
+      void     (*resize_copies) (void *, count_type, const T&);
+      pointer  (*append_copy)   (void *, const T&);
+      pointer  (*append_move)   (void *, T&&);
+      void     (*pop_back)      (void *);
+      iterator (*insert_copy)   (void *, const_iterator, const T&);
+      iterator (*insert_move)   (void *, const_iterator, T&&);
+      iterator (*insert_copies) (void *, const_iterator, count_type, const T&);
+      iterator (*insert_range)  (void *, const_iterator, const T *, const T *);
+      iterator (*erase)         (void *, const_iterator, const_iterator);
+      void     (*assign_copies) (void *, count_type, const T&);
+      void     (*assign_range)  (void *, const T *, const T *);
+    };
+
+    template <typename T>
+    struct is_small_vector_ref_copyable
+      : std::integral_constant<bool, std::is_copy_constructible<T>::value
+                                 &&  std::is_copy_assignable<T>::value>
+    { };
+
+    // The operations which need copies of `T`.
+    template <typename Vector, typename T,
+              bool IsCopyable = is_small_vector_ref_copyable<T>::value>
+    struct small_vector_ref_copy_thunks
+    {
+      using size_type      = typename Vector::size_type;
+      using count_type     = typename Vector::count_type;
+      using pointer        = typename Vector::pointer;
+      using iterator       = typename Vector::iterator;
+      using const_iterator = typename Vector::const_iterator;
+
+      static
+      Vector&
+      get (void *v) noexcept
+      {
+        return *static_cast<Vector *> (v);
+      }
+
+      static
+      void
+      resize_copies (void *v, count_type count, const T& value)
+      {
+        get (v).resize (count, value);
+      }
+
+      static
+      pointer
+      append_copy (void *v, const T& value)
+      {
+        return std::addressof (get (v).emplace_back (value));
+      }
+
+      static
+      iterator
+      insert_copy (void *v, const_iterator pos, const T& value)
+      {
+        return get (v).insert (pos, value);
+      }
+
+      static
+      iterator
+      insert_copies (void *v, const_iterator pos, count_type count, const T& value)
+      {
+        return get (v).insert (pos, count, value);
+      }
+
+      static
+      iterator
+      insert_range (void *v, const_iterator pos, const T *first, const T *last)
+      {
+        return get (v).insert (pos, first, last);
+      }
+
+      static
+      void
+      assign_copies (void *v, count_type count, const T& value)
+      {
+        get (v).assign (count, value);
+      }
+
+      static
+      void
+      assign_range (void *v, const T *first, const T *last)
+      {
+        get (v).assign (first, last);
+      }
+    };
+
+    template <typename Vector, typename T>
+    struct small_vector_ref_copy_thunks<Vector, T, false>
+    {
+      static constexpr std::nullptr_t resize_copies = nullptr;
+      static constexpr std::nullptr_t append_copy   = nullptr;
+      static constexpr std::nullptr_t insert_copy   = nullptr;
+      static constexpr std::nullptr_t insert_copies = nullptr;
+      static constexpr std::nullptr_t insert_range  = nullptr;
+      static constexpr std::nullptr_t assign_copies = nullptr;
+      static constexpr std::nullptr_t assign_range  = nullptr;
+    };
+
+    // The operation which needs default-constructed elements of `T`.
+    template <typename Vector, typename T,
+              bool IsDefaultConstructible = std::is_default_constructible<T>::value>
+    struct small_vector_ref_default_thunks
+    {
+      static
+      void
+      resize (void *v, typename Vector::count_type count)
+      {
+        static_cast<Vector *> (v)->resize (count);
+      }
+    };
+
+    template <typename Vector, typename T>
+    struct small_vector_ref_default_thunks<Vector, T, false>
+    {
+      static constexpr std::nullptr_t resize = nullptr;
+    };
+
+    template <typename Vector, typename Operations>
+    struct small_vector_ref_thunks
+    {
+      using value_type     = typename Vector::value_type;
+      using allocator_type = typename Vector::allocator_type;
+      using size_type      = typename Vector::size_type;
+      using count_type     = typename Vector::count_type;
+      using pointer        = typename Vector::pointer;
+      using iterator       = typename Vector::iterator;
+      using const_iterator = typename Vector::const_iterator;
+
+      using copy_thunks    = small_vector_ref_copy_thunks<Vector, value_type>;
+      using default_thunks = small_vector_ref_default_thunks<Vector, value_type>;
+
+      static
+      const Vector&
+      get (const void *v) noexcept
+      {
+        return *static_cast<const Vector *> (v);
+      }
+
+      static
+      Vector&
+      get (void *v) noexcept
+      {
+        return *static_cast<Vector *> (v);
+      }
+
+      static
+      pointer
+      data (const void *v) noexcept
+      {
+        return const_cast<Vector&> (get (v)).data ();
+      }
+
+      static
+      size_type
+      size (const void *v) noexcept
+      {
+        return get (v).size ();
+      }
+
+      static
+      size_type
+      capacity (const void *v) noexcept
+      {
+        return get (v).capacity ();
+      }
+
+      static
+      size_type
+      max_size (const void *v) noexcept
+      {
+        return get (v).max_size ();
+      }
+
+      static
+      bool
+      inlined (const void *v) noexcept
+      {
+        return get (v).inlined ();
+      }
+
+      static
+      allocator_type
+      get_allocator (const void *v) noexcept
+      {
+        return get (v).get_allocator ();
+      }
+
+      static
+      void
+      reserve (void *v, count_type new_capacity)
+      {
+        get (v).reserve (new_capacity);
+      }
+
+      static
+      bool
+      try_reserve (void *v, count_type new_capacity)
+      {
+        return get (v).try_reserve (new_capacity);
+      }
+
+      static
+      void
+      shrink_to_fit (void *v)
+      {
+        get (v).shrink_to_fit ();
+      }
+
+      static
+      void
+      clear (void *v) noexcept
+      {
+        get (v).clear ();
+      }
+
+      static
+      void
+      reset (void *v) noexcept
+      {
+        get (v).reset ();
+      }
+
+      static
+      pointer
+      append_move (void *v, value_type&& value)
+      {
+        return std::addressof (get (v).emplace_back (std::move (value)));
+      }
+
+      static
+      void
+      pop_back (void *v)
+      {
+        get (v).pop_back ();
+      }
+
+      static
+      iterator
+      insert_move (void *v, const_iterator pos, value_type&& value)
+      {
+        return get (v).insert (pos, std::move (value));
+      }
+
+      static
+      iterator
+      erase (void *v, const_iterator first, const_iterator last)
+      {
+        return get (v).erase (first, last);
+      }
+
+      static
+      const Operations&
+      table (void) noexcept
+      {
+        static constexpr Operations ops {
+          &data,
+          &size,
+          &capacity,
+          &max_size,
+          &inlined,
+          &get_allocator,
+          &reserve,
+          &try_reserve,
+          &shrink_to_fit,
+          &clear,
+          &reset,
+          default_thunks::resize,
+          copy_thunks::resize_copies,
+          copy_thunks::append_copy,
+          &append_move,
+          &pop_back,
+          copy_thunks::insert_copy,
+          &insert_move,
+          copy_thunks::insert_copies,
+          copy_thunks::insert_range,
+          &erase,
+          copy_thunks::assign_copies,
+          copy_thunks::assign_range,
+        };
+        return ops;
+      }
+    };
+
+  } // namespace gch::detail
+
+  // A non-owning reference to a `small_vector<T, N, Allocator, Options>` for any `N`. It has the
+  // interface of the vector, and forwards the operations which may change the size or the capacity
+  // to it through a table of function pointers. This lets a function which grows a vector be
+  // compiled once instead of once for each inline capacity.
+  //
+  // With the standard layout, `data ()`, `size ()`, `capacity ()`, and the element accessors read
+  // the vector directly, so they cost the same as they do on the vector. With the other layouts,
+  // these also go through the table, which costs an indirect call each. Every operation which
+  // changes the vector is an indirect call, so this is best used where code size matters more than
+  // the cost of a call per insertion. `emplace_back` and `emplace` construct a temporary and move
+  // it into the vector, since their arguments cannot be forwarded through the table. Inserting a
+  // range of iterators other than pointers appends the elements and then rotates them into place.
+  //
+  // Like a reference, a `small_vector_ref` cannot be reseated after construction, and the vector
+  // must outlive it. Unlike the vector, it cannot be used in constant expressions.
+  template <typename T, typename Allocator = std::allocator<T>,
+            typename Options = small_vector_default_options>
+  class small_vector_ref
+  {
+    using operations  = detail::small_vector_ref_operations<T, Allocator, Options>;
+    using vector_type = typename operations::vector_type;
+
+  public:
+    using value_type             = T;
+    using allocator_type         = Allocator;
+    using size_type              = typename vector_type::size_type;
+    using count_type             = typename vector_type::count_type;
+    using difference_type        = typename vector_type::difference_type;
+    using reference              =       value_type&;
+    using const_reference        = const value_type&;
+    using pointer                = typename vector_type::pointer;
+    using const_pointer          = typename vector_type::const_pointer;
+
+    using iterator               = typename vector_type::iterator;
+    using const_iterator         = typename vector_type::const_iterator;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    small_vector_ref            (const small_vector_ref&)     = default;
+    small_vector_ref& operator= (const small_vector_ref&)     = delete;
+    ~small_vector_ref           (void)                        = default;
+
+    template <unsigned InlineCapacity>
+    GCH_IMPLICIT_CONVERSION
+    small_vector_ref (small_vector<T, InlineCapacity, Allocator, Options>& v) noexcept
+      : m_vector (std::addressof (v)),
+        m_header (header_access::get (v)),
+        m_ops    (&detail::small_vector_ref_thunks<
+                    small_vector<T, InlineCapacity, Allocator, Options>, operations>::table ())
+    { }
+
+    // A reference to a temporary would dangle.
+    template <unsigned InlineCapacity>
+    small_vector_ref (small_vector<T, InlineCapacity, Allocator, Options>&&) = delete;
+
+    small_vector_ref&
+    operator= (std::initializer_list<value_type> ilist)
+    {
+      assign (ilist);
+      return *this;
+    }
+
+    void
+    assign (count_type count, const_reference value)
+    {
+      m_ops->assign_copies (m_vector, count, value);
+    }
+
+    template <typename InputIt,
+              typename std::enable_if<std::is_base_of<
+                std::input_iterator_tag,
+                typename std::iterator_traits<InputIt>::iterator_category
+                >::value>::type * = nullptr>
+    void
+    assign (InputIt first, InputIt last)
+    {
+      clear ();
+      append (first, last);
+    }
+
+    void
+    assign (std::initializer_list<value_type> ilist)
+    {
+      m_ops->assign_range (m_vector, ilist.begin (), ilist.end ());
+    }
+
+    allocator_type
+    get_allocator (void) const noexcept
+    {
+      return m_ops->get_allocator (m_vector);
+    }
+
+    iterator
+    begin (void) const noexcept
+    {
+      return iterator { data () };
+    }
+
+    iterator
+    end (void) const noexcept
+    {
+      return std::next (begin (), static_cast<difference_type> (size ()));
+    }
+
+    const_iterator
+    cbegin (void) const noexcept
+    {
+      return begin ();
+    }
+
+    const_iterator
+    cend (void) const noexcept
+    {
+      return end ();
+    }
+
+    reverse_iterator
+    rbegin (void) const noexcept
+    {
+      return reverse_iterator { end () };
+    }
+
+    reverse_iterator
+    rend (void) const noexcept
+    {
+      return reverse_iterator { begin () };
+    }
+
+    const_reverse_iterator
+    crbegin (void) const noexcept
+    {
+      return rbegin ();
+    }
+
+    const_reverse_iterator
+    crend (void) const noexcept
+    {
+      return rend ();
+    }
+
+    reference
+    at (size_type pos) const
+    {
+      if (size () <= pos)
+        throw_index_error ();
+      return (*this)[pos];
+    }
+
+    reference
+    operator[] (size_type pos) const
+    {
+      return begin ()[static_cast<difference_type> (pos)];
+    }
+
+    reference
+    front (void) const
+    {
+      return (*this)[0];
+    }
+
+    reference
+    back (void) const
+    {
+      return (*this)[size () - 1];
+    }
+
+    pointer
+    data (void) const noexcept
+    {
+      return has_header::value ? m_header->data_ptr () : m_ops->data (m_vector);
+    }
+
+    size_type
+    size (void) const noexcept
+    {
+      return has_header::value ? m_header->size () : m_ops->size (m_vector);
+    }
+
+    GCH_NODISCARD
+    bool
+    empty (void) const noexcept
+    {
+      return size () == 0;
+    }
+
+    size_type
+    max_size (void) const noexcept
+    {
+      return m_ops->max_size (m_vector);
+    }
+
+    size_type
+    capacity (void) const noexcept
+    {
+      return has_header::value ? m_header->capacity () : m_ops->capacity (m_vector);
+    }
+
+    GCH_NODISCARD
+    bool
+    inlined (void) const noexcept
+    {
+      return m_ops->inlined (m_vector);
+    }
+
+    void
+    reserve (count_type new_capacity) const
+    {
+      m_ops->reserve (m_vector, new_capacity);
+    }
+
+    GCH_NODISCARD
+    bool
+    try_reserve (count_type new_capacity) const
+    {
+      return m_ops->try_reserve (m_vector, new_capacity);
+    }
+
+    void
+    shrink_to_fit (void) const
+    {
+      m_ops->shrink_to_fit (m_vector);
+    }
+
+    void
+    clear (void) const noexcept
+    {
+      m_ops->clear (m_vector);
+    }
+
+    void
+    reset (void) const noexcept
+    {
+      m_ops->reset (m_vector);
+    }
+
+    iterator
+    insert (const_iterator pos, const_reference value) const
+    {
+      check_copyable ();
+      return m_ops->insert_copy (m_vector, pos, value);
+    }
+
+    iterator
+    insert (const_iterator pos, value_type&& value) const
+    {
+      return m_ops->insert_move (m_vector, pos, std::move (value));
+    }
+
+    iterator
+    insert (const_iterator pos, count_type count, const_reference value) const
+    {
+      check_copyable ();
+      return m_ops->insert_copies (m_vector, pos, count, value);
+    }
+
+    template <typename InputIt,
+              typename std::enable_if<std::is_base_of<
+                std::input_iterator_tag,
+                typename std::iterator_traits<InputIt>::iterator_category
+                >::value>::type * = nullptr>
+    iterator
+    insert (const_iterator pos, InputIt first, InputIt last) const
+    {
+      const difference_type offset   = pos - cbegin ();
+      const size_type       old_size = size ();
+      append (first, last);
+
+      const iterator ret = std::next (begin (), offset);
+      std::rotate (ret, std::next (begin (), static_cast<difference_type> (old_size)), end ());
+      return ret;
+    }
+
+    iterator
+    insert (const_iterator pos, std::initializer_list<value_type> ilist) const
+    {
+      check_copyable ();
+      return m_ops->insert_range (m_vector, pos, ilist.begin (), ilist.end ());
+    }
+
+    template <typename ...Args>
+    iterator
+    emplace (const_iterator pos, Args&&... args) const
+    {
+      return insert (pos, value_type (std::forward<Args> (args)...));
+    }
+
+    iterator
+    erase (const_iterator pos) const
+    {
+      assert (0 <= (pos    - cbegin ()) && "`pos` is out of bounds (before `begin ()`)."   );
+      assert (0 <  (cend () - pos)      && "`pos` is out of bounds (at or after `end ()`).");
+
+      return m_ops->erase (m_vector, pos, std::next (pos));
+    }
+
+    iterator
+    erase (const_iterator first, const_iterator last) const
+    {
+      return m_ops->erase (m_vector, first, last);
+    }
+
+    void
+    push_back (const_reference value) const
+    {
+      check_copyable ();
+      m_ops->append_copy (m_vector, value);
+    }
+
+    void
+    push_back (value_type&& value) const
+    {
+      m_ops->append_move (m_vector, std::move (value));
+    }
+
+    template <typename ...Args>
+    reference
+    emplace_back (Args&&... args) const
+    {
+      return *m_ops->append_move (m_vector, value_type (std::forward<Args> (args)...));
+    }
+
+    void
+    pop_back (void) const
+    {
+      assert (! empty () && "`pop_back ()` called on an empty `small_vector`.");
+      m_ops->pop_back (m_vector);
+    }
+
+    void
+    resize (count_type count) const
+    {
+      static_assert (std::is_default_constructible<value_type>::value,
+                     "`resize (count)` requires a default constructible `value_type`.");
+      m_ops->resize (m_vector, count);
+    }
+
+    void
+    resize (count_type count, const_reference value) const
+    {
+      check_copyable ();
+      m_ops->resize_copies (m_vector, count, value);
+    }
+
+    // If an element throws, the elements which were appended are erased.
+    template <typename InputIt,
+              typename std::enable_if<std::is_base_of<
+                std::input_iterator_tag,
+                typename std::iterator_traits<InputIt>::iterator_category
+                >::value>::type * = nullptr>
+    void
+    append (InputIt first, InputIt last) const
+    {
+      const size_type old_size = size ();
+      GCH_TRY
+      {
+        for (; ! (first == last); ++first)
+          emplace_back (*first);
+      }
+      GCH_CATCH (...)
+      {
+        erase (std::next (cbegin (), static_cast<difference_type> (old_size)), cend ());
+        GCH_THROW;
+      }
+    }
+
+    void
+    append (std::initializer_list<value_type> ilist) const
+    {
+      insert (cend (), ilist);
+    }
+
+  private:
+    using has_header    = std::is_same<typename Options::layout, small_vector_layout::standard>;
+    using header_type   = detail::small_vector_data_base<pointer, size_type>;
+    using header_access = detail::small_vector_ref_header<header_type, typename Options::layout>;
+
+    static
+    void
+    check_copyable (void) noexcept
+    {
+      static_assert (detail::is_small_vector_ref_copyable<value_type>::value,
+                     "This operation requires a copy constructible and copy assignable "
+                     "`value_type`.");
+    }
+
+    GCH_NORETURN
+    static
+    void
+    throw_index_error (void)
+    {
+#ifdef GCH_EXCEPTIONS
+      throw std::out_of_range ("The requested index was out of range.");
+#else
+      std::fprintf (stderr, "[gch::small_vector_ref] The requested index was out of range.\n");
+      std::abort ();
+#endif
+    }
+
+    void              *m_vector;
+    const header_type *m_header;
+    const operations  *m_ops;
+  };
+
+  template <typename T, typename Allocator, typename Options>
+  inline
+  bool
+  operator== (const small_vector_ref<T, Allocator, Options>& lhs,
+              const small_vector_ref<T, Allocator, Options>& rhs)
+  {
+    return lhs.size () == rhs.size () && std::equal (lhs.begin (), lhs.end (), rhs.begin ());
+  }
+
+  template <typename T, typename Allocator, typename Options>
+  inline
+  bool
+  operator!= (const small_vector_ref<T, Allocator, Options>& lhs,
+              const small_vector_ref<T, Allocator, Options>& rhs)
+  {
+    return ! (lhs == rhs);
+  }
+
+} // namespace gch
+
+#endif // GCH_SMALL_VECTOR_REF_HPP
@@ -0,0 +1,1192 @@
+/** static_vector.hpp
+ * A vector with a fixed capacity which keeps all of its elements
+ * inline and never allocates, following the semantics of
+ * `std::inplace_vector` (P0843). It shares its implementation with
+ * `small_vector`, so it only stores its size next to the elements.
+ *
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GCH_STATIC_VECTOR_HPP
+#define GCH_STATIC_VECTOR_HPP
+
+#include "small_vector.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifndef GCH_EXCEPTIONS
+#  include <cstdio>
+#  include <cstdlib>
+#endif
+
+namespace gch
+{
+
+  namespace detail
+  {
+
+    // Elements of types which are trivially default constructible and destructible are kept in an
+    // array of `T`, which lets them be used during constant evaluation.
+    template <typename T>
+    struct is_constexpr_storable
+      : std::integral_constant<bool, std::is_trivially_default_constructible<T>::value
+                                 &&  std::is_trivially_destructible<T>::value>
+    { };
+
+    template <typename T, unsigned Capacity,
+              bool IsConstexprStorable = Capacity != 0 && is_constexpr_storable<T>::value>
+    class static_vector_storage
+      : public inline_storage<T, Capacity>
+    { };
+
+    template <typename T, unsigned Capacity>
+    class static_vector_storage<T, Capacity, true>
+    {
+    public:
+      static_vector_storage            (void)                             = default;
+      static_vector_storage            (const static_vector_storage&)     = delete;
+      static_vector_storage            (static_vector_storage&&) noexcept = delete;
+      static_vector_storage& operator= (const static_vector_storage&)     = delete;
+      static_vector_storage& operator= (static_vector_storage&&) noexcept = delete;
+      ~static_vector_storage           (void)                             = default;
+
+      GCH_NODISCARD GCH_CPP14_CONSTEXPR
+      T *
+      get_inline_ptr (void) noexcept
+      {
+        return m_data;
+      }
+
+    private:
+      T m_data[Capacity];
+    };
+
+    template <typename T>
+    class static_vector_storage<T, 0, false>
+    {
+    public:
+      GCH_NODISCARD GCH_CPP14_CONSTEXPR
+      T *
+      get_inline_ptr (void) noexcept
+      {
+        return nullptr;
+      }
+    };
+
+    // The data for a `static_vector`. The elements are always in the inline storage, so only the
+    // size is stored.
+    template <typename Pointer, typename SizeT, typename T, unsigned Capacity>
+    class static_vector_data
+    {
+    public:
+      using ptr     = Pointer;
+      using size_ty = SizeT;
+
+      GCH_CPP20_CONSTEXPR
+      static_vector_data (void) noexcept
+        : m_size (0)
+      { }
+
+      static_vector_data            (const static_vector_data&)     = delete;
+      static_vector_data            (static_vector_data&&) noexcept = delete;
+      static_vector_data& operator= (const static_vector_data&)     = delete;
+      static_vector_data& operator= (static_vector_data&&) noexcept = delete;
+      ~static_vector_data           (void)                          = default;
+
+      constexpr
+      ptr
+      data_ptr (void) const noexcept
+      {
+        return const_cast<static_vector_data *> (this)->storage ();
+      }
+
+      static constexpr
+      size_ty
+      capacity (void) noexcept
+      {
+        return static_cast<size_ty> (Capacity);
+      }
+
+      constexpr
+      size_ty
+      size (void) const noexcept
+      {
+        return m_size;
+      }
+
+      static constexpr
+      bool
+      is_allocated (void) noexcept
+      {
+        return false;
+      }
+
+      GCH_CPP20_CONSTEXPR
+      void
+      set_data_ptr (ptr data_ptr) noexcept
+      {
+        assert (data_ptr == storage () && "A `static_vector` cannot allocate.");
+        static_cast<void> (data_ptr);
+      }
+
+      GCH_CPP20_CONSTEXPR
+      void
+      set_capacity (size_ty capacity) noexcept
+      {
+        assert (capacity == Capacity && "A `static_vector` cannot allocate.");
+        static_cast<void> (capacity);
+      }
+
+      GCH_CPP20_CONSTEXPR
+      void
+      set_size (size_ty size) noexcept
+      {
+        m_size = size;
+      }
+
+      GCH_CPP20_CONSTEXPR
+      void
+      set (ptr data_ptr, size_ty capacity, size_ty size)
+      {
+        set_data_ptr (data_ptr);
+        set_capacity (capacity);
+        set_size (size);
+      }
+
+      // There is never an allocation to swap.
+      GCH_CPP20_CONSTEXPR
+      void
+      swap_data_ptr (static_vector_data&) noexcept
+      { }
+
+      GCH_CPP20_CONSTEXPR
+      void
+      swap_capacity (static_vector_data&) noexcept
+      { }
+
+      GCH_CPP20_CONSTEXPR
+      void
+      swap_size (static_vector_data& other) noexcept
+      {
+        using std::swap;
+        swap (m_size, other.m_size);
+      }
+
+      // Only used when there is no storage.
+      GCH_CPP20_CONSTEXPR
+      void
+      swap (static_vector_data& other) noexcept
+      {
+        static_assert (Capacity == 0, "The elements must be swapped as well.");
+        swap_size (other);
+      }
+
+      GCH_CPP14_CONSTEXPR
+      T *
+      storage (void) noexcept
+      {
+        return m_storage.get_inline_ptr ();
+      }
+
+      static constexpr
+      std::size_t
+      allocation_offset (void) noexcept
+      {
+        return 0;
+      }
+
+    private:
+      static_vector_storage<T, Capacity> m_storage;
+      size_ty                            m_size;
+    };
+
+    struct static_vector_layout
+    { };
+
+    template <typename Pointer, typename SizeT, typename T, unsigned Capacity>
+    struct small_vector_layout_data<static_vector_layout, Pointer, SizeT, T, Capacity>
+    {
+      using type = static_vector_data<Pointer, SizeT, T, Capacity>;
+    };
+
+    template <typename Pointer, typename SizeT, typename T, unsigned Capacity>
+    struct has_constexpr_inline_storage<static_vector_data<Pointer, SizeT, T, Capacity>>
+      : std::integral_constant<bool, Capacity == 0 || is_constexpr_storable<T>::value>
+    { };
+
+    // The size is stored in the smallest unsigned type whose signed counterpart can hold
+    // `Capacity`, since the signed type is used as the `difference_type` of the iterators.
+    template <unsigned Capacity>
+    struct static_vector_options
+      : small_vector_default_options
+    {
+      using size_type = typename std::conditional<
+        Capacity <= static_cast<unsigned> ((std::numeric_limits<signed char>::max) ()),
+        unsigned char,
+        typename std::conditional<
+          Capacity <= static_cast<unsigned> ((std::numeric_limits<short>::max) ()),
+          unsigned short,
+          typename std::conditional<
+            Capacity <= static_cast<unsigned> ((std::numeric_limits<int>::max) ()),
+            unsigned,
+            std::size_t>::type>::type>::type;
+
+      using layout = static_vector_layout;
+    };
+
+  } // namespace gch::detail
+
+  // A vector with a capacity of `Capacity` elements, which are stored inline. Operations which
+  // would exceed the capacity throw `std::bad_alloc`, except for the `try_` functions, which
+  // return `false` (or `nullptr`) and leave the vector unchanged, and the `unchecked_` functions,
+  // which require that there is enough space.
+  //
+  // Note: This may only be used in constant expressions if `T` is trivially default
+  //       constructible and trivially destructible.
+  template <typename T, unsigned Capacity>
+  class static_vector
+    : private detail::small_vector_base<std::allocator<T>, Capacity,
+                                        detail::static_vector_options<Capacity>>
+  {
+    using base = detail::small_vector_base<std::allocator<T>, Capacity,
+                                           detail::static_vector_options<Capacity>>;
+
+    using size_ty = typename base::size_ty;
+
+  public:
+    using value_type             = T;
+    using size_type              = std::size_t;
+    using difference_type        = typename base::difference_type;
+    using reference              =       value_type&;
+    using const_reference        = const value_type&;
+    using pointer                =       value_type *;
+    using const_pointer          = const value_type *;
+
+    using iterator               = small_vector_iterator<pointer, difference_type>;
+    using const_iterator         = small_vector_iterator<const_pointer, difference_type>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    GCH_CPP20_CONSTEXPR
+    static_vector (void) noexcept = default;
+
+    GCH_CPP20_CONSTEXPR
+    static_vector (const static_vector& other)
+      : base (base::bypass, other)
+    { }
+
+    GCH_CPP20_CONSTEXPR
+    static_vector (static_vector&& other)
+      noexcept (std::is_nothrow_move_constructible<value_type>::value)
+      : base (base::bypass, std::move (other))
+    { }
+
+    GCH_CPP20_CONSTEXPR explicit
+    static_vector (size_type count)
+      : base (checked_size (count), std::allocator<value_type> ())
+    { }
+
+    GCH_CPP20_CONSTEXPR
+    static_vector (size_type count, const_reference value)
+      : base (checked_size (count), value, std::allocator<value_type> ())
+    { }
+
+#ifdef GCH_LIB_CONCEPTS
+    template <std::input_iterator InputIt>
+#else
+    template <typename InputIt,
+              typename std::enable_if<
+                std::is_base_of<
+                  std::input_iterator_tag,
+                  typename std::iterator_traits<InputIt>::iterator_category>::value
+                >::type * = nullptr>
+#endif
+    GCH_CPP20_CONSTEXPR
+    static_vector (InputIt first, InputIt last)
+    {
+      append (first, last);
+    }
+
+    GCH_CPP20_CONSTEXPR
+    static_vector (std::initializer_list<value_type> init)
+      : static_vector (init.begin (), init.end ())
+    { }
+
+    GCH_CPP20_CONSTEXPR
+    ~static_vector (void) = default;
+
+    GCH_CPP20_CONSTEXPR
+    static_vector&
+    operator= (const static_vector& other)
+    {
+      if (&other != this)
+        base::copy_assign (other);
+      return *this;
+    }
+
+    GCH_CPP20_CONSTEXPR
+    static_vector&
+    operator= (static_vector&& other)
+      noexcept (std::is_nothrow_move_assignable<value_type>::value
+            &&  std::is_nothrow_move_constructible<value_type>::value)
+    {
+      if (&other != this)
+        base::move_assign (other);
+      return *this;
+    }
+
+    GCH_CPP20_CONSTEXPR
+    static_vector&
+    operator= (std::initializer_list<value_type> ilist)
+    {
+      assign (ilist);
+      return *this;
+    }
+
+    GCH_CPP20_CONSTEXPR
+    void
+    assign (size_type count, const_reference value)
+    {
+      base::assign_with_copies (checked_size (count), value);
+    }
+
+#ifdef GCH_LIB_CONCEPTS
+    template <std::input_iterator InputIt>
+#else
+    template <typename InputIt,
+              typename std::enable_if<std::is_base_of<
+                std::input_iterator_tag,
+                typename std::iterator_traits<InputIt>::iterator_category
+                >::value>::type * = nullptr>
+#endif
+    GCH_CPP20_CONSTEXPR
+    void
+    assign (InputIt first, InputIt last)
+    {
+      using iterator_cat = typename std::iterator_traits<InputIt>::iterator_category;
+      assign_range (first, last, iterator_cat { });
+    }
+
+    GCH_CPP20_CONSTEXPR
+    void
+    assign (std::initializer_list<value_type> ilist)
+    {
+      assign (ilist.begin (), ilist.end ());
+    }
+
+    GCH_CPP20_CONSTEXPR
+    void
+    swap (static_vector& other)
+      noexcept (std::is_nothrow_move_constructible<value_type>::value
+            &&  std::is_nothrow_move_assignable<value_type>::value
+#ifdef GCH_LIB_IS_SWAPPABLE
+            &&  std::is_nothrow_swappable<value_type>::value
+#else
+            &&  detail::small_vector_adl::is_nothrow_swappable<value_type>::value
+#endif
+               )
+    {
+      base::swap (other);
+    }
+
+    GCH_CPP14_CONSTEXPR
+    iterator
+    begin (void) noexcept
+    {
+      return iterator { base::begin_ptr () };
+    }
+
+    constexpr
+    const_iterator
+    begin (void) const noexcept
+    {
+      return const_iterator { base::begin_ptr () };
+    }
+
+    constexpr
+    const_iterator
+    cbegin (void) const noexcept
+    {
+      return begin ();
+    }
+
+    GCH_CPP14_CONSTEXPR
+    iterator
+    end (void) noexcept
+    {
+      return iterator { base::end_ptr () };
+    }
+
+    constexpr
+    const_iterator
+    end (void) const noexcept
+    {
+      return const_iterator { base::end_ptr () };
+    }
+
+    constexpr
+    const_iterator
+    cend (void) const noexcept
+    {
+      return end ();
+    }
+
+    GCH_CPP14_CONSTEXPR
+    reverse_iterator
+    rbegin (void) noexcept
+    {
+      return reverse_iterator { end () };
+    }
+
+    constexpr
+    const_reverse_iterator
+    rbegin (void) const noexcept
+    {
+      return const_reverse_iterator { end () };
+    }
+
+    constexpr
+    const_reverse_iterator
+    crbegin (void) const noexcept
+    {
+      return rbegin ();
+    }
+
+    GCH_CPP14_CONSTEXPR
+    reverse_iterator
+    rend (void) noexcept
+    {
+      return reverse_iterator { begin () };
+    }
+
+    constexpr
+    const_reverse_iterator
+    rend (void) const noexcept
+    {
+      return const_reverse_iterator { begin () };
+    }
+
+    constexpr
+    const_reverse_iterator
+    crend (void) const noexcept
+    {
+      return rend ();
+    }
+
+    GCH_CPP14_CONSTEXPR
+    reference
+    at (size_type pos)
+    {
+      if (size () <= pos)
+        base::throw_index_error ();
+      return begin ()[static_cast<difference_type> (pos)];
+    }
+
+    GCH_CPP14_CONSTEXPR
+    const_reference
+    at (size_type pos) const
+    {
+      if (size () <= pos)
+        base::throw_index_error ();
+      return begin ()[static_cast<difference_type> (pos)];
+    }
+
+    GCH_CPP14_CONSTEXPR
+    reference
+    operator[] (size_type pos)
+    {
+      return begin ()[static_cast<difference_type> (pos)];
+    }
+
+    constexpr
+    const_reference
+    operator[] (size_type pos) const
+    {
+      return begin ()[static_cast<difference_type> (pos)];
+    }
+
+    GCH_CPP14_CONSTEXPR
+    reference
+    front (void)
+    {
+      return (*this)[0];
+    }
+
+    constexpr
+    const_reference
+    front (void) const
+    {
+      return (*this)[0];
+    }
+
+    GCH_CPP14_CONSTEXPR
+    reference
+    back (void)
+    {
+      return (*this)[size () - 1];
+    }
+
+    constexpr
+    const_reference
+    back (void) const
+    {
+      return (*this)[size () - 1];
+    }
+
+    GCH_CPP14_CONSTEXPR
+    pointer
+    data (void) noexcept
+    {
+      return base::begin_ptr ();
+    }
+
+    constexpr
+    const_pointer
+    data (void) const noexcept
+    {
+      return base::begin_ptr ();
+    }
+
+    constexpr
+    size_type
+    size (void) const noexcept
+    {
+      return static_cast<size_type> (base::get_size ());
+    }
+
+    GCH_NODISCARD constexpr
+    bool
+    empty (void) const noexcept
+    {
+      return size () == 0;
+    }
+
+    static constexpr
+    size_type
+    max_size (void) noexcept
+    {
+      return Capacity;
+    }
+
+    static constexpr
+    size_type
+    capacity (void) noexcept
+    {
+      return Capacity;
+    }
+
+    static GCH_CPP20_CONSTEXPR
+    void
+    reserve (size_type new_capacity)
+    {
+      if (Capacity < new_capacity)
+        throw_capacity_error ();
+    }
+
+    GCH_NODISCARD
+    static constexpr
+    bool
+    try_reserve (size_type new_capacity) noexcept
+    {
+      return new_capacity <= Capacity;
+    }
+
+    static GCH_CPP20_CONSTEXPR
+    void
+    shrink_to_fit (void) noexcept
+    { }
+
+    GCH_CPP20_CONSTEXPR
+    iterator
+    insert (const_iterator pos, const_reference value)
+    {
+      return emplace (pos, value);
+    }
+
+    GCH_CPP20_CONSTEXPR
+    iterator
+    insert (const_iterator pos, value_type&& value)
+    {
+      return emplace (pos, std::move (value));
+    }
+
+    GCH_CPP20_CONSTEXPR
+    iterator
+    insert (const_iterator pos, size_type count, const_reference value)
+    {
+      if (base::num_uninitialized () < count)
+        throw_capacity_error ();
+      return iterator (base::insert_copies (base::ptr_cast (pos), static_cast<size_ty> (count),
+                                            value));
+    }
+
+#ifdef GCH_LIB_CONCEPTS
+    template <std::input_iterator InputIt>
+#else
+    template <typename InputIt,
+              typename std::enable_if<std::is_base_of<
+                std::input_iterator_tag,
+                typename std::iterator_traits<InputIt>::iterator_category
+                >::value>::type * = nullptr>
+#endif
+    GCH_CPP20_CONSTEXPR
+    iterator
+    insert (const_iterator pos, InputIt first, InputIt last)
+    {
+      if (first == last)
+        return iterator (base::ptr_cast (pos));
+      return insert_range (pos, first, last);
+    }
+
+    GCH_CPP20_CONSTEXPR
+    iterator
+    insert (const_iterator pos, std::initializer_list<value_type> ilist)
+    {
+      return insert (pos, ilist.begin (), ilist.end ());
+    }
+
+    template <typename ...Args>
+    GCH_CPP20_CONSTEXPR
+    iterator
+    emplace (const_iterator pos, Args&&... args)
+    {
+      if (base::num_uninitialized () == 0)
+        throw_capacity_error ();
+      return iterator (base::emplace_at (base::ptr_cast (pos), std::forward<Args> (args)...));
+    }
+
+    GCH_NODISCARD GCH_CPP20_CONSTEXPR
+    bool
+    try_insert (const_iterator pos, const_reference value)
+    {
+      if (base::num_uninitialized () == 0)
+        return false;
+      base::emplace_at (base::ptr_cast (pos), value);
+      return true;
+    }
+
+    GCH_NODISCARD GCH_CPP20_CONSTEXPR
+    bool
+    try_insert (const_iterator pos, value_type&& value)
+    {
+      if (base::num_uninitialized () == 0)
+        return false;
+      base::emplace_at (base::ptr_cast (pos), std::move (value));
+      return true;
+    }
+
+    GCH_NODISCARD GCH_CPP20_CONSTEXPR
+    bool
+    try_insert (const_iterator pos, size_type count, const_reference value)
+    {
+      if (base::num_uninitialized () < count)
+        return false;
+      base::insert_copies (base::ptr_cast (pos), static_cast<size_ty> (count), value);
+      return true;
+    }
+
+#ifdef GCH_LIB_CONCEPTS
+    template <std::input_iterator InputIt>
+#else
+    template <typename InputIt,
+              typename std::enable_if<std::is_base_of<
+                std::input_iterator_tag,
+                typename std::iterator_traits<InputIt>::iterator_category
+                >::value>::type * = nullptr>
+#endif
+    GCH_NODISCARD GCH_CPP20_CONSTEXPR
+    bool
+    try_insert (const_iterator pos, InputIt first, InputIt last)
+    {
+      using iterator_cat = typename std::iterator_traits<InputIt>::iterator_category;
+      return try_insert_range (pos, first, last, iterator_cat { });
+    }
+
+    GCH_NODISCARD GCH_CPP20_CONSTEXPR
+    bool
+    try_insert (const_iterator pos, std::initializer_list<value_type> ilist)
+    {
+      return try_insert (pos, ilist.begin (), ilist.end ());
+    }
+
+    GCH_CPP20_CONSTEXPR
+    iterator
+    erase (const_iterator pos)
+    {
+      assert (0 <= (pos    - begin ()) && "`pos` is out of bounds (before `begin ()`)."   );
+      assert (0 <  (end () - pos)      && "`pos` is out of bounds (at or after `end ()`).");
+
+      return iterator (base::erase_at (base::ptr_cast (pos)));
+    }
+
+    GCH_CPP20_CONSTEXPR
+    iterator
+    erase (const_iterator first, const_iterator last)
+    {
+      assert (0 <= (last   - first)    && "Invalid range.");
+      assert (0 <= (first  - begin ()) && "`first` is out of bounds (before `begin ()`)."  );
+      assert (0 <= (end () - last)     && "`last` is out of bounds (after `end ()`).");
+
+      return iterator (base::erase_range (base::ptr_cast (first), base::ptr_cast (last)));
+    }
+
+    GCH_CPP20_CONSTEXPR
+    void
+    push_back (const_reference value)
+    {
+      emplace_back (value);
+    }
+
+    GCH_CPP20_CONSTEXPR
+    void
+    push_back (value_type&& value)
+    {
+      emplace_back (std::move (value));
+    }
+
+    template <typename ...Args>
+    GCH_CPP20_CONSTEXPR
+    reference
+    emplace_back (Args&&... args)
+    {
+      if (base::num_uninitialized () == 0)
+        throw_capacity_error ();
+      return unchecked_emplace_back (std::forward<Args> (args)...);
+    }
+
+    GCH_NODISCARD GCH_CPP20_CONSTEXPR
+    pointer
+    try_push_back (const_reference value)
+    {
+      return try_emplace_back (value);
+    }
+
+    GCH_NODISCARD GCH_CPP20_CONSTEXPR
+    pointer
+    try_push_back (value_type&& value)
+    {
+      return try_emplace_back (std::move (value));
+    }
+
+    // Returns a pointer to the new element, or `nullptr` if the vector was full.
+    template <typename ...Args>
+    GCH_NODISCARD GCH_CPP20_CONSTEXPR
+    pointer
+    try_emplace_back (Args&&... args)
+    {
+      if (base::num_uninitialized () == 0)
+        return nullptr;
+      return std::addressof (unchecked_emplace_back (std::forward<Args> (args)...));
+    }
+
+    GCH_CPP20_CONSTEXPR
+    void
+    unchecked_push_back (const_reference value)
+    {
+      unchecked_emplace_back (value);
+    }
+
+    GCH_CPP20_CONSTEXPR
+    void
+    unchecked_push_back (value_type&& value)
+    {
+      unchecked_emplace_back (std::move (value));
+    }
+
+    template <typename ...Args>
+    GCH_CPP20_CONSTEXPR
+    reference
+    unchecked_emplace_back (Args&&... args)
+    {
+      assert (size () < capacity ()
+              &&  "`unchecked_emplace_back ()` called on a full `static_vector`.");
+      return *base::emplace_into_current_end (std::forward<Args> (args)...);
+    }
+
+    GCH_CPP20_CONSTEXPR
+    void
+    pop_back (void)
+    {
+      assert (! empty () && "`pop_back ()` called on an empty `static_vector`.");
+      base::erase_last ();
+    }
+
+    GCH_CPP20_CONSTEXPR
+    void
+    clear (void) noexcept
+    {
+      base::erase_all ();
+    }
+
+    GCH_CPP20_CONSTEXPR
+    void
+    resize (size_type count)
+    {
+      base::resize_with (checked_size (count));
+    }
+
+    GCH_CPP20_CONSTEXPR
+    void
+    resize (size_type count, const_reference value)
+    {
+      base::resize_with (checked_size (count), value);
+    }
+
+    GCH_NODISCARD GCH_CPP20_CONSTEXPR
+    bool
+    try_resize (size_type count)
+    {
+      if (Capacity < count)
+        return false;
+      base::resize_with (static_cast<size_ty> (count));
+      return true;
+    }
+
+    GCH_NODISCARD GCH_CPP20_CONSTEXPR
+    bool
+    try_resize (size_type count, const_reference value)
+    {
+      if (Capacity < count)
+        return false;
+      base::resize_with (static_cast<size_ty> (count), value);
+      return true;
+    }
+
+#ifdef GCH_LIB_CONCEPTS
+    template <std::input_iterator InputIt>
+#else
+    template <typename InputIt,
+              typename std::enable_if<std::is_base_of<
+                std::input_iterator_tag,
+                typename std::iterator_traits<InputIt>::iterator_category
+                >::value>::type * = nullptr>
+#endif
+    GCH_CPP20_CONSTEXPR
+    static_vector&
+    append (InputIt first, InputIt last)
+    {
+      append_range (first, last);
+      return *this;
+    }
+
+    GCH_CPP20_CONSTEXPR
+    static_vector&
+    append (std::initializer_list<value_type> ilist)
+    {
+      return append (ilist.begin (), ilist.end ());
+    }
+
+    // Like `append`, but the caller guarantees that there is enough capacity for the range.
+#ifdef GCH_LIB_CONCEPTS
+    template <std::input_iterator InputIt>
+#else
+    template <typename InputIt,
+              typename std::enable_if<std::is_base_of<
+                std::input_iterator_tag,
+                typename std::iterator_traits<InputIt>::iterator_category
+                >::value>::type * = nullptr>
+#endif
+    GCH_CPP20_CONSTEXPR
+    static_vector&
+    unchecked_append (InputIt first, InputIt last)
+    {
+      using iterator_cat = typename std::iterator_traits<InputIt>::iterator_category;
+      base::append_range_unchecked (first, last, iterator_cat { });
+      return *this;
+    }
+
+#ifdef GCH_LIB_CONCEPTS
+    template <std::input_iterator InputIt>
+#else
+    template <typename InputIt,
+              typename std::enable_if<std::is_base_of<
+                std::input_iterator_tag,
+                typename std::iterator_traits<InputIt>::iterator_category
+                >::value>::type * = nullptr>
+#endif
+    GCH_NODISCARD GCH_CPP20_CONSTEXPR
+    bool
+    try_append (InputIt first, InputIt last)
+    {
+      using iterator_cat = typename std::iterator_traits<InputIt>::iterator_category;
+      return try_append_range (first, last, iterator_cat { });
+    }
+
+    GCH_NODISCARD GCH_CPP20_CONSTEXPR
+    bool
+    try_append (std::initializer_list<value_type> ilist)
+    {
+      return try_append (ilist.begin (), ilist.end ());
+    }
+
+  private:
+    GCH_NORETURN
+    static GCH_CPP20_CONSTEXPR
+    void
+    throw_capacity_error (void)
+    {
+#ifdef GCH_EXCEPTIONS
+      throw std::bad_alloc ();
+#else
+      std::fprintf (stderr, "[gch::static_vector] The required size exceeds the capacity.\n");
+      std::abort ();
+#endif
+    }
+
+    static GCH_CPP20_CONSTEXPR
+    size_ty
+    checked_size (size_type count)
+    {
+      if (Capacity < count)
+        throw_capacity_error ();
+      return static_cast<size_ty> (count);
+    }
+
+    template <typename ForwardIt>
+    static GCH_CPP20_CONSTEXPR
+    size_type
+    range_length (ForwardIt first, ForwardIt last)
+    {
+      // Don't use the base's range length, since the size type may be narrower than the range.
+      return static_cast<size_type> (std::distance (first, last));
+    }
+
+    template <typename InputIt>
+    GCH_CPP20_CONSTEXPR
+    void
+    assign_range (InputIt first, InputIt last, std::input_iterator_tag)
+    {
+      clear ();
+      append_range (first, last);
+    }
+
+    template <typename ForwardIt>
+    GCH_CPP20_CONSTEXPR
+    void
+    assign_range (ForwardIt first, ForwardIt last, std::forward_iterator_tag)
+    {
+      if (Capacity < range_length (first, last))
+        throw_capacity_error ();
+      base::assign_with_range (first, last, std::forward_iterator_tag { });
+    }
+
+    template <typename InputIt>
+    GCH_CPP20_CONSTEXPR
+    void
+    append_range (InputIt first, InputIt last)
+    {
+      using iterator_cat = typename std::iterator_traits<InputIt>::iterator_category;
+      if (! try_append_range (first, last, iterator_cat { }))
+        throw_capacity_error ();
+    }
+
+    template <typename InputIt>
+    GCH_CPP20_CONSTEXPR
+    iterator
+    insert_range (const_iterator pos, InputIt first, InputIt last)
+    {
+      const difference_type offset = pos - cbegin ();
+      using iterator_cat = typename std::iterator_traits<InputIt>::iterator_category;
+      if (! try_insert_range (pos, first, last, iterator_cat { }))
+        throw_capacity_error ();
+      return begin () + offset;
+    }
+
+    template <typename InputIt>
+    GCH_CPP20_CONSTEXPR
+    bool
+    try_append_range (InputIt first, InputIt last, std::input_iterator_tag)
+    {
+      // Remove the new elements if we run out of space or if one of them throws.
+      const size_ty original_size = base::get_size ();
+      GCH_TRY
+      {
+        for (; ! (first == last); ++first)
+        {
+          if (base::num_uninitialized () == 0)
+          {
+            base::erase_range (base::unchecked_next (base::begin_ptr (), original_size),
+                               base::end_ptr ());
+            return false;
+          }
+          base::emplace_into_current_end (*first);
+        }
+      }
+      GCH_CATCH (...)
+      {
+        base::erase_range (base::unchecked_next (base::begin_ptr (), original_size),
+                           base::end_ptr ());
+        GCH_THROW;
+      }
+      return true;
+    }
+
+    template <typename ForwardIt>
+    GCH_CPP20_CONSTEXPR
+    bool
+    try_append_range (ForwardIt first, ForwardIt last, std::forward_iterator_tag)
+    {
+      if (base::num_uninitialized () < range_length (first, last))
+        return false;
+      base::append_range_unchecked (first, last, std::forward_iterator_tag { });
+      return true;
+    }
+
+    template <typename InputIt>
+    GCH_CPP20_CONSTEXPR
+    bool
+    try_insert_range (const_iterator pos, InputIt first, InputIt last, std::input_iterator_tag)
+    {
+      // We can't know the length of the range ahead of time, so append it and then rotate it into
+      // place.
+      const difference_type offset        = pos - cbegin ();
+      const difference_type original_size = static_cast<difference_type> (size ());
+      if (! try_append_range (first, last, std::input_iterator_tag { }))
+        return false;
+      std::rotate (begin () + offset, begin () + original_size, end ());
+      return true;
+    }
+
+    template <typename ForwardIt>
+    GCH_CPP20_CONSTEXPR
+    bool
+    try_insert_range (const_iterator pos, ForwardIt first, ForwardIt last,
+                      std::forward_iterator_tag)
+    {
+      if (first == last)
+        return true;
+
+      if (base::num_uninitialized () < range_length (first, last))
+        return false;
+      base::insert_range (base::ptr_cast (pos), first, last, std::forward_iterator_tag { });
+      return true;
+    }
+  };
+
+  template <typename T, unsigned Capacity>
+  inline GCH_CPP20_CONSTEXPR
+  bool
+  operator== (const static_vector<T, Capacity>& lhs, const static_vector<T, Capacity>& rhs)
+  {
+    return lhs.size () == rhs.size () && std::equal (lhs.begin (), lhs.end (), rhs.begin ());
+  }
+
+#ifdef GCH_LIB_THREE_WAY_COMPARISON
+
+  template <typename T, unsigned Capacity>
+  requires std::three_way_comparable<T>
+  constexpr
+  auto
+  operator<=> (const static_vector<T, Capacity>& lhs, const static_vector<T, Capacity>& rhs)
+  {
+    return std::lexicographical_compare_three_way (
+      lhs.begin (), lhs.end (),
+      rhs.begin (), rhs.end (),
+      std::compare_three_way { });
+  }
+
+  template <typename T, unsigned Capacity>
+  constexpr
+  auto
+  operator<=> (const static_vector<T, Capacity>& lhs, const static_vector<T, Capacity>& rhs)
+  {
+    constexpr auto comparison = [](const T& l, const T& r) {
+      return (l < r) ? std::weak_ordering::less
+                     : (r < l) ? std::weak_ordering::greater
+                               : std::weak_ordering::equivalent;
+    };
+
+    return std::lexicographical_compare_three_way (
+      lhs.begin (), lhs.end (),
+      rhs.begin (), rhs.end (),
+      comparison);
+  }
+
+#else
+
+  template <typename T, unsigned Capacity>
+  inline GCH_CPP20_CONSTEXPR
+  bool
+  operator!= (const static_vector<T, Capacity>& lhs, const static_vector<T, Capacity>& rhs)
+  {
+    return ! (lhs == rhs);
+  }
+
+  template <typename T, unsigned Capacity>
+  inline GCH_CPP20_CONSTEXPR
+  bool
+  operator<  (const static_vector<T, Capacity>& lhs, const static_vector<T, Capacity>& rhs)
+  {
+    return std::lexicographical_compare (lhs.begin (), lhs.end (), rhs.begin (), rhs.end ());
+  }
+
+  template <typename T, unsigned Capacity>
+  inline GCH_CPP20_CONSTEXPR
+  bool
+  operator>= (const static_vector<T, Capacity>& lhs, const static_vector<T, Capacity>& rhs)
+  {
+    return ! (lhs < rhs);
+  }
+
+  template <typename T, unsigned Capacity>
+  inline GCH_CPP20_CONSTEXPR
+  bool
+  operator>  (const static_vector<T, Capacity>& lhs, const static_vector<T, Capacity>& rhs)
+  {
+    return rhs < lhs;
+  }
+
+  template <typename T, unsigned Capacity>
+  inline GCH_CPP20_CONSTEXPR
+  bool
+  operator<= (const static_vector<T, Capacity>& lhs, const static_vector<T, Capacity>& rhs)
+  {
+    return rhs >= lhs;
+  }
+
+#endif
+
+  template <typename T, unsigned Capacity>
+  inline GCH_CPP20_CONSTEXPR
+  void
+  swap (static_vector<T, Capacity>& lhs, static_vector<T, Capacity>& rhs)
+    noexcept (noexcept (lhs.swap (rhs)))
+  {
+    lhs.swap (rhs);
+  }
+
+  template <typename T, unsigned Capacity, typename U>
+  inline GCH_CPP20_CONSTEXPR
+  typename static_vector<T, Capacity>::size_type
+  erase (static_vector<T, Capacity>& v, const U& value)
+  {
+    const auto original_size = v.size ();
+    v.erase (std::remove (v.begin (), v.end (), value), v.end ());
+    return original_size - v.size ();
+  }
+
+  template <typename T, unsigned Capacity, typename Pred>
+  inline GCH_CPP20_CONSTEXPR
+  typename static_vector<T, Capacity>::size_type
+  erase_if (static_vector<T, Capacity>& v, Pred pred)
+  {
+    const auto original_size = v.size ();
+    v.erase (std::remove_if (v.begin (), v.end (), pred), v.end ());
+    return original_size - v.size ();
+  }
+
+} // namespace gch
+
+#endif // GCH_STATIC_VECTOR_HPP
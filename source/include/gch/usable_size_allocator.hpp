@@ -0,0 +1,195 @@
+/** usable_size_allocator.hpp
+ * An allocator backed by `std::malloc` which reports the usable size
+ * of each block through `allocate_at_least`. This lets a `small_vector`
+ * record the whole malloc bucket as its capacity instead of only the
+ * number of elements it asked for.
+ *
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GCH_USABLE_SIZE_ALLOCATOR_HPP
+#define GCH_USABLE_SIZE_ALLOCATOR_HPP
+
+#include "small_vector.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#ifndef GCH_EXCEPTIONS
+#  include <cstdio>
+#endif
+
+#if defined (_WIN32)
+#  include <malloc.h>
+#  ifndef GCH_HAS_MALLOC_USABLE_SIZE
+#    define GCH_HAS_MALLOC_USABLE_SIZE
+#  endif
+#elif defined (__APPLE__)
+#  include <malloc/malloc.h>
+#  ifndef GCH_HAS_MALLOC_USABLE_SIZE
+#    define GCH_HAS_MALLOC_USABLE_SIZE
+#  endif
+#elif defined (__linux__) || defined (__GLIBC__) || defined (__ANDROID__)
+#  include <malloc.h>
+#  ifndef GCH_HAS_MALLOC_USABLE_SIZE
+#    define GCH_HAS_MALLOC_USABLE_SIZE
+#  endif
+#elif defined (__FreeBSD__)
+#  include <malloc_np.h>
+#  ifndef GCH_HAS_MALLOC_USABLE_SIZE
+#    define GCH_HAS_MALLOC_USABLE_SIZE
+#  endif
+#endif
+
+namespace gch
+{
+
+  namespace detail
+  {
+
+    // Returns the number of bytes usable in a block returned by `std::malloc`, or `fallback` if
+    // this cannot be queried on the current platform.
+    inline
+    std::size_t
+    malloc_usable_size (void *p, std::size_t fallback) noexcept
+    {
+#ifdef GCH_HAS_MALLOC_USABLE_SIZE
+      static_cast<void> (fallback);
+#  if defined (_WIN32)
+      return ::_msize (p);
+#  elif defined (__APPLE__)
+      return ::malloc_size (p);
+#  else
+      return ::malloc_usable_size (p);
+#  endif
+#else
+      static_cast<void> (p);
+      return fallback;
+#endif
+    }
+
+  } // namespace gch::detail
+
+  template <typename T>
+  class usable_size_allocator
+  {
+  public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal                        = std::true_type;
+
+    template <typename U>
+    struct rebind
+    {
+      using other = usable_size_allocator<U>;
+    };
+
+    static_assert (alignof (T) <= alignof (std::max_align_t),
+                   "`usable_size_allocator` does not support over-aligned types.");
+
+    usable_size_allocator            (void)                             = default;
+    usable_size_allocator            (const usable_size_allocator&)     = default;
+    usable_size_allocator            (usable_size_allocator&&) noexcept = default;
+    usable_size_allocator& operator= (const usable_size_allocator&)     = default;
+    usable_size_allocator& operator= (usable_size_allocator&&) noexcept = default;
+    ~usable_size_allocator           (void)                             = default;
+
+    template <typename U>
+    constexpr
+    usable_size_allocator (const usable_size_allocator<U>&) noexcept
+    { }
+
+    GCH_NODISCARD
+    T *
+    allocate (size_type n)
+    {
+      return allocate_at_least (n).ptr;
+    }
+
+    GCH_NODISCARD
+    allocation_result<T *, size_type>
+    allocate_at_least (size_type n)
+    {
+      if (max_size () < n)
+        throw_allocation_error ();
+
+      void *p = std::malloc (n * sizeof (T));
+      if (p == nullptr && n != 0)
+        throw_allocation_error ();
+
+      const size_type bytes = detail::malloc_usable_size (p, n * sizeof (T));
+      return { static_cast<T *> (p), bytes / sizeof (T) };
+    }
+
+    // Allocates with `std::calloc`, which can often hand back fresh pages from the operating
+    // system without writing to them.
+    GCH_NODISCARD
+    T *
+    allocate_zeroed (size_type n)
+    {
+      if (max_size () < n)
+        throw_allocation_error ();
+
+      void *p = std::calloc (n, sizeof (T));
+      if (p == nullptr && n != 0)
+        throw_allocation_error ();
+
+      return static_cast<T *> (p);
+    }
+
+    void
+    deallocate (T *p, size_type) noexcept
+    {
+      std::free (p);
+    }
+
+    GCH_NODISCARD constexpr
+    size_type
+    max_size (void) const noexcept
+    {
+      return (std::numeric_limits<size_type>::max) () / sizeof (T);
+    }
+
+  private:
+    GCH_NORETURN
+    static
+    void
+    throw_allocation_error (void)
+    {
+#ifdef GCH_EXCEPTIONS
+      throw std::bad_alloc ();
+#else
+      std::fprintf (stderr, "[gch::usable_size_allocator] Allocation failed.\n");
+      std::abort ();
+#endif
+    }
+  };
+
+  template <typename T, typename U>
+  constexpr
+  bool
+  operator== (const usable_size_allocator<T>&, const usable_size_allocator<U>&) noexcept
+  {
+    return true;
+  }
+
+  template <typename T, typename U>
+  constexpr
+  bool
+  operator!= (const usable_size_allocator<T>&, const usable_size_allocator<U>&) noexcept
+  {
+    return false;
+  }
+
+} // namespace gch
+
+#endif // GCH_USABLE_SIZE_ALLOCATOR_HPP
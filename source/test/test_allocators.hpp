@@ -10,7 +10,9 @@
 
 #include "test_common.hpp"
 
+#include <cstdlib>
 #include <memory>
+#include <new>
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
@@ -613,6 +615,215 @@ namespace gch
       return ! (lhs == rhs);
     }
 
+    // Allocates `Extra` more elements than requested and reports them through `allocate_at_least`.
+    template <typename T, std::size_t Extra>
+    struct at_least_allocator
+      : base_allocator<T>
+    {
+      using size_type = typename base_allocator<T>::size_type;
+
+      template <typename U>
+      struct rebind
+      {
+        using other = at_least_allocator<U, Extra>;
+      };
+
+      at_least_allocator (void) = default;
+
+      template <typename U>
+      constexpr GCH_IMPLICIT_CONVERSION
+      at_least_allocator (const at_least_allocator<U, Extra>&) noexcept
+      { }
+
+      GCH_NODISCARD GCH_CPP20_CONSTEXPR
+      gch::allocation_result<T *, size_type>
+      allocate_at_least (size_type n)
+      {
+        return { this->allocate (n + Extra), n + Extra };
+      }
+    };
+
+    template <typename T, std::size_t Extra>
+    constexpr
+    bool
+    operator!= (const at_least_allocator<T, Extra>& lhs,
+                const at_least_allocator<T, Extra>& rhs) noexcept
+    {
+      return ! (lhs == rhs);
+    }
+
+    template <typename T, typename U, std::size_t Extra>
+    constexpr
+    bool
+    operator!= (const at_least_allocator<T, Extra>& lhs,
+                const at_least_allocator<U, Extra>& rhs) noexcept
+    {
+      return ! (lhs == rhs);
+    }
+
+    // Like `at_least_allocator`, but also takes an allocation hint. The number of allocations
+    // which were given a hint is counted.
+    template <typename T, std::size_t Extra>
+    struct hinted_at_least_allocator
+      : at_least_allocator<T, Extra>
+    {
+      using size_type = typename at_least_allocator<T, Extra>::size_type;
+
+      template <typename U>
+      struct rebind
+      {
+        using other = hinted_at_least_allocator<U, Extra>;
+      };
+
+      hinted_at_least_allocator (void) = default;
+
+      template <typename U>
+      constexpr GCH_IMPLICIT_CONVERSION
+      hinted_at_least_allocator (const hinted_at_least_allocator<U, Extra>&) noexcept
+      { }
+
+      using at_least_allocator<T, Extra>::allocate_at_least;
+
+      GCH_NODISCARD
+      gch::allocation_result<T *, size_type>
+      allocate_at_least (size_type n, const T *hint)
+      {
+        static_cast<void> (hint);
+        ++num_hinted_allocations ();
+        return allocate_at_least (n);
+      }
+
+      static
+      std::size_t&
+      num_hinted_allocations (void) noexcept
+      {
+        static std::size_t count = 0;
+        return count;
+      }
+    };
+
+    template <typename T, std::size_t Extra>
+    constexpr
+    bool
+    operator!= (const hinted_at_least_allocator<T, Extra>& lhs,
+                const hinted_at_least_allocator<T, Extra>& rhs) noexcept
+    {
+      return ! (lhs == rhs);
+    }
+
+    template <typename T, typename U, std::size_t Extra>
+    constexpr
+    bool
+    operator!= (const hinted_at_least_allocator<T, Extra>& lhs,
+                const hinted_at_least_allocator<U, Extra>& rhs) noexcept
+    {
+      return ! (lhs == rhs);
+    }
+
+    // Fails to allocate more than `Limit` elements by throwing `std::bad_alloc`.
+    template <typename T, std::size_t Limit>
+    struct limited_allocator
+      : base_allocator<T>
+    {
+      using pointer   = typename base_allocator<T>::pointer;
+      using size_type = typename base_allocator<T>::size_type;
+
+      template <typename U>
+      struct rebind
+      {
+        using other = limited_allocator<U, Limit>;
+      };
+
+      limited_allocator (void) = default;
+
+      template <typename U>
+      constexpr GCH_IMPLICIT_CONVERSION
+      limited_allocator (const limited_allocator<U, Limit>&) noexcept
+      { }
+
+      GCH_NODISCARD GCH_CPP20_CONSTEXPR
+      pointer
+      allocate (size_type n)
+      {
+        if (Limit < n)
+        {
+#ifdef GCH_EXCEPTIONS
+          throw std::bad_alloc ();
+#else
+          std::abort ();
+#endif
+        }
+        return base_allocator<T>::allocate (n);
+      }
+    };
+
+    template <typename T, std::size_t Limit>
+    constexpr
+    bool
+    operator!= (const limited_allocator<T, Limit>& lhs,
+                const limited_allocator<T, Limit>& rhs) noexcept
+    {
+      return ! (lhs == rhs);
+    }
+
+    template <typename T, typename U, std::size_t Limit>
+    constexpr
+    bool
+    operator!= (const limited_allocator<T, Limit>& lhs,
+                const limited_allocator<U, Limit>& rhs) noexcept
+    {
+      return ! (lhs == rhs);
+    }
+
+    // Like `limited_allocator`, but also reports failure through `try_allocate_at_least`.
+    template <typename T, std::size_t Limit>
+    struct try_limited_allocator
+      : limited_allocator<T, Limit>
+    {
+      using pointer   = typename limited_allocator<T, Limit>::pointer;
+      using size_type = typename limited_allocator<T, Limit>::size_type;
+
+      template <typename U>
+      struct rebind
+      {
+        using other = try_limited_allocator<U, Limit>;
+      };
+
+      try_limited_allocator (void) = default;
+
+      template <typename U>
+      constexpr GCH_IMPLICIT_CONVERSION
+      try_limited_allocator (const try_limited_allocator<U, Limit>&) noexcept
+      { }
+
+      GCH_NODISCARD GCH_CPP20_CONSTEXPR
+      gch::allocation_result<pointer, size_type>
+      try_allocate_at_least (size_type n)
+      {
+        if (Limit < n)
+          return { nullptr, 0 };
+        return { this->allocate (n), n };
+      }
+    };
+
+    template <typename T, std::size_t Limit>
+    constexpr
+    bool
+    operator!= (const try_limited_allocator<T, Limit>& lhs,
+                const try_limited_allocator<T, Limit>& rhs) noexcept
+    {
+      return ! (lhs == rhs);
+    }
+
+    template <typename T, typename U, std::size_t Limit>
+    constexpr
+    bool
+    operator!= (const try_limited_allocator<T, Limit>& lhs,
+                const try_limited_allocator<U, Limit>& rhs) noexcept
+    {
+      return ! (lhs == rhs);
+    }
+
     template <typename T, typename Traits = allocator_pointer_trait<pointer_wrapper<T>>>
     struct fancy_pointer_allocator
       : base_allocator<T, Traits>
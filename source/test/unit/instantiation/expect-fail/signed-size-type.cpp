@@ -0,0 +1,16 @@
+/** signed-size-type.cpp
+ * Copyright © 2022 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "gch/small_vector.hpp"
+
+// The size type must be unsigned.
+struct signed_size_type_holder
+{
+  gch::small_vector_with_size_type<int, int, 4> x;
+};
+
+signed_size_type_holder h;
@@ -0,0 +1,126 @@
+/** test-and-overwrite.cpp
+ * Copyright © 2022 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+#include "test_allocators.hpp"
+
+struct iota_writer
+{
+  template <typename Pointer, typename SizeType>
+  GCH_SMALL_VECTOR_TEST_CONSTEXPR
+  SizeType
+  operator() (Pointer p, SizeType n) const
+  {
+    for (SizeType i = 0; i < n; ++i)
+      p[i] = static_cast<int> (i) + first;
+    return n < result ? n : result;
+  }
+
+  int         first;
+  std::size_t result;
+};
+
+struct empty_writer
+{
+  template <typename Pointer, typename SizeType>
+  GCH_SMALL_VECTOR_TEST_CONSTEXPR
+  SizeType
+  operator() (Pointer, SizeType) const
+  {
+    return 0;
+  }
+};
+
+#ifdef GCH_SMALL_VECTOR_TEST_EXCEPTION_SAFETY_TESTING
+
+struct throwing_writer
+{
+  template <typename Pointer, typename SizeType>
+  SizeType
+  operator() (Pointer, SizeType) const
+  {
+    throw gch::test_types::test_exception ();
+  }
+};
+
+#endif
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+  using namespace gch::test_types;
+
+  // Append without reallocation.
+  {
+    gch::small_vector<int, 4> v { 1 };
+    v.append_and_overwrite (3, iota_writer { 10, 2 });
+    CHECK (decltype (v) { 1, 10, 11 } == v);
+    CHECK_IF_NOT_CONSTEXPR (v.inlined ());
+
+    v.append_and_overwrite (1, empty_writer { });
+    CHECK (decltype (v) { 1, 10, 11 } == v);
+  }
+
+  // Append with reallocation.
+  {
+    gch::small_vector<int, 2> v { 1, 2 };
+    v.append_and_overwrite (8, iota_writer { 10, 3 });
+    CHECK (decltype (v) { 1, 2, 10, 11, 12 } == v);
+    CHECK (! v.inlined ());
+
+    // Appending nothing is a no-op.
+    v.append_and_overwrite (0, iota_writer { 0, 0 });
+    CHECK (decltype (v) { 1, 2, 10, 11, 12 } == v);
+  }
+
+  // Repeated appends use the growth policy.
+  {
+    gch::small_vector<int, 0> v;
+    for (int i = 0; i < 10; ++i)
+    {
+      v.append_and_overwrite (4, iota_writer { 3 * i, 3 });
+      CHECK (static_cast<std::size_t> (3 * (i + 1)) == v.size ());
+    }
+    CHECK (27 == v[27]);
+    CHECK (v.capacity () < 2 * v.size () + 4);
+  }
+
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+
+#ifdef GCH_SMALL_VECTOR_TEST_EXCEPTION_SAFETY_TESTING
+  // The elements added for `op` are removed if it throws.
+  {
+    gch::small_vector<int, 2, verifying_allocator<int>> v { 1, 2, 3 };
+    auto v_save = v;
+
+    EXPECT_TEST_EXCEPTION (v.append_and_overwrite (3, throwing_writer { }));
+    CHECK (v == v_save);
+  }
+#endif
+
+  // Test strong exception guarantees when allocating over the maximum size.
+  {
+    gch::small_vector_with_allocator<std::int8_t, sized_allocator<std::int8_t, std::uint8_t>> w;
+    w.assign (100, 1);
+
+    auto w_save = w;
+
+    GCH_TRY
+    {
+      EXPECT_THROW (w.append_and_overwrite (28, empty_writer { }));
+    }
+    GCH_CATCH (const std::length_error&)
+    { }
+
+    CHECK (w == w_save);
+  }
+
+#endif
+
+  return 0;
+}
@@ -0,0 +1,87 @@
+/** test-try.cpp
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+#include "test_allocators.hpp"
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+  using namespace gch::test_types;
+
+  // Append without and with reallocation.
+  {
+    gch::small_vector<int, 4> v { 1 };
+    bool ret = v.try_append ({ 2, 3 });
+    CHECK (ret);
+    CHECK (decltype (v) { 1, 2, 3 } == v);
+    CHECK_IF_NOT_CONSTEXPR (v.inlined ());
+
+    ret = v.try_append ({ 4, 5, 6 });
+    CHECK (ret);
+    CHECK (decltype (v) { 1, 2, 3, 4, 5, 6 } == v);
+    CHECK (! v.inlined ());
+  }
+
+  // Append from input iterators.
+  {
+    gch::small_vector<int, 2> v { 1 };
+    int a[] = { 2, 3, 4, 5 };
+    using it = single_pass_iterator<int *>;
+    bool ret = v.try_append (it { std::begin (a) }, it { std::end (a) });
+    CHECK (ret);
+    CHECK (decltype (v) { 1, 2, 3, 4, 5 } == v);
+  }
+
+  // Fail to allocate.
+  {
+    gch::small_vector<int, 4, try_limited_allocator<int, 8>> v { 1, 2, 3 };
+    int a[] = { 4, 5, 6, 7, 8, 9 };
+    using it = single_pass_iterator<int *>;
+
+    bool ret = v.try_append (std::begin (a), std::end (a));
+    CHECK (! ret);
+    CHECK (decltype (v) { 1, 2, 3 } == v);
+
+    ret = v.try_append (it { std::begin (a) }, it { std::end (a) });
+    CHECK (! ret);
+    CHECK (decltype (v) { 1, 2, 3 } == v);
+  }
+
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+
+  // Fail because of the maximum size.
+  {
+    gch::small_vector_with_allocator<std::int8_t, sized_allocator<std::int8_t, std::uint8_t>> w;
+    w.assign (w.max_size () - 1, 1);
+    auto w_save = w;
+
+    bool ret = w.try_append ({ 1, 2 });
+    CHECK (! ret);
+    CHECK (w == w_save);
+  }
+
+#ifdef GCH_SMALL_VECTOR_TEST_EXCEPTION_SAFETY_TESTING
+  // Test strong exception guarantees when an element throws.
+  {
+    gch::small_vector<triggering_type, 2, verifying_allocator<triggering_type>> v (1);
+    auto v_save = v;
+    triggering_type a[3];
+    using it = single_pass_iterator<triggering_type *>;
+
+    exception_trigger::push (2);
+    EXPECT_TEST_EXCEPTION (
+      static_cast<void> (v.try_append (it { std::begin (a) }, it { std::end (a) })));
+    CHECK (v == v_save);
+  }
+#endif
+
+#endif
+
+  return 0;
+}
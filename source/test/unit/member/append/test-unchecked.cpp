@@ -0,0 +1,93 @@
+/** test-unchecked.cpp
+ * Copyright © 2022 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+#include "test_allocators.hpp"
+
+template <typename T, typename Iterator, typename Allocator = std::allocator<T>>
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test_with_iterator (Allocator alloc = Allocator ())
+{
+  const T a[] { T (2), T (3), T (4) };
+
+  // Inlined.
+  {
+    gch::small_vector<T, 4, Allocator> v ({ T (1) }, alloc);
+    v.unchecked_append (Iterator (a), Iterator (a + 3));
+    CHECK (decltype (v) { T (1), T (2), T (3), T (4) } == v);
+    CHECK (4 == v.capacity ());
+
+    // Appending nothing is a no-op, even when full.
+    v.unchecked_append (Iterator (a), Iterator (a));
+    CHECK (4 == v.size ());
+  }
+
+  // Allocated.
+  {
+    gch::small_vector<T, 1, Allocator> v ({ T (1) }, alloc);
+    v.reserve (4);
+
+    const auto capacity = v.capacity ();
+    const auto data     = v.data ();
+
+    v.unchecked_append (Iterator (a), Iterator (a + 3));
+    CHECK (decltype (v) { T (1), T (2), T (3), T (4) } == v);
+    CHECK (capacity == v.capacity ());
+    CHECK (data == v.data ());
+  }
+
+  return 0;
+}
+
+template <typename T, typename Allocator = std::allocator<T>>
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test_with_type (Allocator alloc = Allocator ())
+{
+  CHECK (0 == test_with_iterator<T, const T *> (alloc));
+  CHECK (0 == test_with_iterator<T, gch::test_types::single_pass_iterator<const T *>> (alloc));
+  return 0;
+}
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+  using namespace gch::test_types;
+
+  CHECK (0 == test_with_type<trivially_copyable_data_base> ());
+  CHECK (0 == test_with_type<nontrivial_data_base> ());
+
+  CHECK (0 == test_with_type<nontrivial_data_base,
+                             fancy_pointer_allocator<nontrivial_data_base>> ());
+
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+  CHECK (0 == test_with_type<nontrivial_data_base, verifying_allocator<nontrivial_data_base>> ());
+
+  // Throw during the construction of an element (No change).
+  {
+    using vector_type =
+      gch::small_vector<triggering_type, 4, verifying_allocator<triggering_type>>;
+
+    const triggering_type a[] { 2, 3 };
+    vector_type v { 1 };
+    vector_type v_save = v;
+
+    exception_trigger::push (1);
+    EXPECT_TEST_EXCEPTION (v.unchecked_append (a, a + 2));
+    CHECK (v == v_save);
+
+    using input_it = single_pass_iterator<const triggering_type *>;
+    exception_trigger::push (1);
+    EXPECT_TEST_EXCEPTION (v.unchecked_append (input_it (a), input_it (a + 2)));
+    CHECK (v == v_save);
+  }
+#endif
+
+  return 0;
+}
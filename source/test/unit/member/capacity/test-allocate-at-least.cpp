@@ -0,0 +1,111 @@
+/** test-allocate-at-least.cpp
+ * Copyright © 2022 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+#include "test_allocators.hpp"
+
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+#  include "gch/usable_size_allocator.hpp"
+#endif
+
+template <typename T, std::size_t Extra>
+using at_least_vector = gch::small_vector<T, 4, gch::test_types::at_least_allocator<T, Extra>>;
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+  // The count returned by `allocate_at_least` is recorded as the capacity.
+  {
+    at_least_vector<int, 3> v;
+    CHECK (4 == v.capacity ());
+
+    v.reserve (5);
+    CHECK (11 == v.capacity ());
+
+    // No reallocation until the extra space is used up.
+    const int *data = v.data ();
+    for (int i = 0; i < 11; ++i)
+      v.push_back (i);
+    CHECK (data == v.data ());
+    CHECK (11 == v.capacity ());
+
+    v.push_back (11);
+    CHECK (25 == v.capacity ());
+    CHECK (12 == v.size ());
+    for (int i = 0; i < 12; ++i)
+      CHECK (i == v[static_cast<std::size_t> (i)]);
+  }
+
+  // Insertions and appends which reallocate use the extra space.
+  {
+    const int arr[] = { 5, 6, 7 };
+
+    at_least_vector<int, 3> v { 1, 2, 3, 4 };
+    v.insert (v.begin (), 2, 0);
+    CHECK (11 == v.capacity ());
+    CHECK (v == at_least_vector<int, 3> { 0, 0, 1, 2, 3, 4 });
+
+    at_least_vector<int, 3> w { 1, 2, 3, 4 };
+    w.append (std::begin (arr), std::end (arr));
+    CHECK (11 == w.capacity ());
+    CHECK (w == at_least_vector<int, 3> { 1, 2, 3, 4, 5, 6, 7 });
+
+    at_least_vector<int, 1> x;
+    x.assign (std::begin (arr), std::end (arr));
+    CHECK (4 == x.capacity ());
+
+    x.assign (7, 1);
+    CHECK (9 == x.capacity ());
+    CHECK (x == at_least_vector<int, 1> (7, 1));
+  }
+
+  // An allocator which returns exactly what was requested behaves as before.
+  {
+    at_least_vector<int, 0> v;
+    v.reserve (5);
+    CHECK (8 == v.capacity ());
+
+    gch::small_vector<int, 4> w;
+    w.reserve (5);
+    CHECK (8 == w.capacity ());
+  }
+
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+  // The allocation hint is passed on to allocators which take one.
+  {
+    using alloc_type = gch::test_types::hinted_at_least_allocator<int, 3>;
+    alloc_type::num_hinted_allocations () = 0;
+
+    gch::small_vector<int, 4, alloc_type> v { 1, 2, 3, 4 };
+    v.insert (v.begin (), 0);
+    CHECK (1 == alloc_type::num_hinted_allocations ());
+    CHECK (11 == v.capacity ());
+    CHECK (v == gch::small_vector<int, 4, alloc_type> { 0, 1, 2, 3, 4 });
+  }
+
+  {
+    gch::small_vector<int, 4, gch::usable_size_allocator<int>> v;
+    v.reserve (5);
+    CHECK (8 <= v.capacity ());
+
+    for (int i = 0; i < 100; ++i)
+      v.push_back (i);
+    CHECK (100 <= v.capacity ());
+
+    v.erase (v.begin (), v.begin () + 50);
+    CHECK (50 == v.size ());
+    CHECK (50 == v.front ());
+
+    v.shrink_to_fit ();
+    CHECK (50 <= v.capacity ());
+    CHECK (99 == v.back ());
+  }
+#endif
+
+  return 0;
+}
@@ -0,0 +1,180 @@
+/** test-arena-allocator.cpp
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+#include "test_allocators.hpp"
+
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+
+#include "gch/arena_allocator.hpp"
+
+#include <cstdint>
+
+static
+bool
+is_aligned (const void *p, std::size_t alignment)
+{
+  return reinterpret_cast<std::uintptr_t> (p) % alignment == 0;
+}
+
+template <typename Vector>
+bool
+is_iota (const Vector& v)
+{
+  for (std::size_t i = 0; i < v.size (); ++i)
+  {
+    if (v[i] != static_cast<typename Vector::value_type> (i))
+      return false;
+  }
+  return true;
+}
+
+template <typename T, unsigned N = 4>
+using arena_vector = gch::small_vector<T, N, gch::arena_allocator<T>>;
+
+static_assert (! std::allocator_traits<gch::arena_allocator<int>>::is_always_equal::value, "");
+
+static_assert (
+  std::allocator_traits<gch::arena_allocator<int>>::propagate_on_container_swap::value, "");
+
+#endif
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+  using namespace gch::test_types;
+
+  // The arena itself.
+  {
+    gch::arena a (256);
+    CHECK (0 == a.capacity ());
+
+    void *p = a.allocate (3, 1);
+    void *q = a.allocate (8, 8);
+    CHECK (is_aligned (q, 8));
+    CHECK (static_cast<char *> (p) + 3 <= static_cast<char *> (q));
+
+    void *r = a.allocate (64, 64);
+    CHECK (is_aligned (r, 64));
+
+    // Only the most recent allocation is given back.
+    a.deallocate (q, 8);
+    a.deallocate (r, 64);
+    CHECK (r == a.allocate (64, 64));
+
+    CHECK (a.try_resize (r, 64, 128));
+    CHECK (! a.try_resize (q, 8, 16));
+    CHECK (! a.try_resize (r, 128, 1024));
+
+    // Larger allocations get a new chunk.
+    void *s = a.allocate (1000, 8);
+    CHECK (is_aligned (s, 8));
+    CHECK (1256 <= a.capacity ());
+
+    // Release everything, keeping only the newest chunk.
+    const std::size_t kept = a.capacity () - 256;
+    a.release ();
+    CHECK (kept == a.capacity ());
+    CHECK (s == a.allocate (1000, 8));
+  }
+
+  // Growth in place.
+  {
+    gch::arena a (1 << 16);
+    arena_vector<int> v (a);
+    for (int i = 0; i < 5; ++i)
+      v.push_back (i);
+    CHECK (! v.inlined ());
+
+    const int *first_allocation = v.data ();
+    for (int i = 5; i < 1000; ++i)
+      v.push_back (i);
+    CHECK (first_allocation == v.data ());
+    CHECK (is_iota (v));
+
+    // Another allocation comes after the vector, so it can no longer grow in place.
+    arena_vector<int> w ({ 1, 2, 3, 4, 5 }, a);
+    v.resize (v.capacity () + 1);
+    CHECK (first_allocation != v.data ());
+    CHECK (999 == v[999]);
+    CHECK (0 == v.back ());
+
+    // Elements which are not trivially relocatable are moved as usual.
+    arena_vector<non_trivial> x (a);
+    for (int i = 0; i < 1000; ++i)
+      x.push_back (i);
+    CHECK (1000 == x.size ());
+    CHECK (999 == x.back ());
+  }
+
+  // The allocator propagates on copy, move, and swap.
+  {
+    gch::arena a;
+    gch::arena b;
+    using alloc_type = gch::arena_allocator<int>;
+
+    arena_vector<int> v ({ 1, 2, 3, 4, 5, 6 }, a);
+    arena_vector<int> w ({ 7, 8, 9, 10, 11 }, b);
+
+    const int *w_data = w.data ();
+    v = std::move (w);
+    CHECK (alloc_type (b) == v.get_allocator ());
+    CHECK (w_data == v.data ());
+    CHECK (arena_vector<int> ({ 7, 8, 9, 10, 11 }, b) == v);
+
+    arena_vector<int> x ({ 1, 2, 3, 4, 5, 6 }, a);
+    const int *v_data = v.data ();
+    const int *x_data = x.data ();
+    v.swap (x);
+    CHECK (alloc_type (a) == v.get_allocator ());
+    CHECK (alloc_type (b) == x.get_allocator ());
+    CHECK (x_data == v.data ());
+    CHECK (v_data == x.data ());
+
+    v = x;
+    CHECK (alloc_type (b) == v.get_allocator ());
+    CHECK (v == x);
+
+    arena_vector<int> y (x);
+    CHECK (alloc_type (b) == y.get_allocator ());
+    CHECK (y == x);
+  }
+
+#ifdef GCH_SMALL_VECTOR_TEST_EXCEPTION_SAFETY_TESTING
+  // Throwing elements leave the vector unchanged, whichever element throws.
+  {
+    gch::arena a;
+    using vector_type = arena_vector<triggering_type, 2>;
+
+    for (std::size_t n = 0; ; ++n)
+    {
+      vector_type v ({ 1, 2, 3, 4 }, a);
+      const vector_type before (v);
+
+      exception_trigger::push (n);
+      GCH_TRY
+      {
+        v.append ({ 5, 6, 7, 8, 9 });
+      }
+      GCH_CATCH (const test_exception&)
+      {
+        CHECK (before == v);
+        continue;
+      }
+
+      exception_trigger::reset ();
+      CHECK (9 == v.size ());
+      break;
+    }
+  }
+#endif
+#endif
+
+  return 0;
+}
@@ -0,0 +1,172 @@
+/** test-caching-allocator.cpp
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+
+#include "gch/caching_allocator.hpp"
+
+#include <array>
+#include <thread>
+
+template <typename T, unsigned N = 4>
+using caching_vector = gch::small_vector<T, N, gch::caching_allocator<T>>;
+
+static_assert (
+  std::allocator_traits<gch::caching_allocator<int>>::is_always_equal::value, "");
+
+#endif
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+  using namespace gch::test_types;
+  using alloc_type = gch::caching_allocator<int>;
+
+  alloc_type::trim ();
+  CHECK (0 == alloc_type::cached_bytes ());
+
+  // Requests are rounded up to a power-of-two number of bytes.
+  {
+    alloc_type alloc;
+
+    auto r = alloc.allocate_at_least (1);
+    CHECK (4 == r.count);
+    alloc.deallocate (r.ptr, r.count);
+
+    r = alloc.allocate_at_least (5);
+    CHECK (8 == r.count);
+    alloc.deallocate (r.ptr, r.count);
+
+    r = alloc.allocate_at_least (16384);
+    CHECK (16384 == r.count);
+    alloc.deallocate (r.ptr, r.count);
+
+    // Larger requests are not cached.
+    const std::size_t before = alloc_type::cached_bytes ();
+    r = alloc.allocate_at_least (16385);
+    CHECK (16385 == r.count);
+    alloc.deallocate (r.ptr, r.count);
+    CHECK (before == alloc_type::cached_bytes ());
+
+    gch::caching_allocator<std::array<char, 24>> array_alloc;
+    auto s = array_alloc.allocate_at_least (1);
+    CHECK (1 == s.count);
+    array_alloc.deallocate (s.ptr, s.count);
+
+    s = array_alloc.allocate_at_least (3);
+    CHECK (5 == s.count);
+    array_alloc.deallocate (s.ptr, 3);
+  }
+
+  // Freed blocks are reused by the next allocation of the same size.
+  {
+    alloc_type::trim ();
+
+    alloc_type alloc;
+    int *p = alloc.allocate (5);
+    alloc.deallocate (p, 5);
+    CHECK (32 == alloc_type::cached_bytes ());
+
+    int *q = alloc.allocate (7);
+    CHECK (p == q);
+    CHECK (0 == alloc_type::cached_bytes ());
+    alloc.deallocate (q, 8);
+  }
+
+  // The caches are bounded.
+  {
+    alloc_type::trim ();
+
+    alloc_type alloc;
+    int *blocks[8];
+    for (int *& p : blocks)
+      p = alloc.allocate (16384);
+    for (int *p : blocks)
+      alloc.deallocate (p, 16384);
+    CHECK (gch::detail::thread_block_cache::max_cached_bytes == alloc_type::cached_bytes ());
+
+    alloc_type::trim ();
+    CHECK (0 == alloc_type::cached_bytes ());
+  }
+
+  // Blocks freed on another thread go to the cache of that thread.
+  {
+    alloc_type::trim ();
+
+    alloc_type alloc;
+    int *p = alloc.allocate (100);
+
+    std::size_t other_cached_bytes = 0;
+    std::thread t ([&] () noexcept {
+      alloc_type other_alloc;
+      other_alloc.deallocate (p, 100);
+      other_cached_bytes = alloc_type::cached_bytes ();
+
+      // Now allocate on the other thread and free on this one.
+      p = other_alloc.allocate (128);
+    });
+    t.join ();
+
+    CHECK (512 == other_cached_bytes);
+    CHECK (0 == alloc_type::cached_bytes ());
+
+    alloc.deallocate (p, 128);
+    CHECK (512 == alloc_type::cached_bytes ());
+  }
+
+  // With doubling growth, a vector only asks for whole blocks.
+  {
+    alloc_type::trim ();
+
+    caching_vector<int> v;
+    for (int i = 0; i < 100; ++i)
+      v.push_back (i);
+    CHECK (128 == v.capacity ());
+    CHECK (99 == v.back ());
+
+    // Every buffer it grew out of was cached.
+    const int *data = v.data ();
+    v.reset ();
+    CHECK (v.inlined ());
+    CHECK (32 + 64 + 128 + 256 + 512 == alloc_type::cached_bytes ());
+
+    caching_vector<int> w;
+    w.reserve (65);
+    CHECK (data == w.data ());
+    CHECK (128 == w.capacity ());
+
+    caching_vector<non_trivial> x;
+    for (int i = 0; i < 100; ++i)
+      x.push_back (i);
+    caching_vector<non_trivial> y (x);
+    CHECK (x == y);
+    x.swap (y);
+    CHECK (x == y);
+  }
+
+  // Vectors may be destroyed on other threads.
+  {
+    std::vector<caching_vector<int>> vectors (16);
+    for (auto& v : vectors)
+    {
+      for (int i = 0; i < 64; ++i)
+        v.push_back (i);
+    }
+
+    std::thread t ([&] () noexcept {
+      vectors.clear ();
+    });
+    t.join ();
+  }
+#endif
+
+  return 0;
+}
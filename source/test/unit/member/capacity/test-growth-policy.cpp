@@ -0,0 +1,156 @@
+/** test-growth-policy.cpp
+ * Copyright © 2022 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+#include "test_allocators.hpp"
+
+template <typename GrowthPolicy>
+struct growth_options
+  : gch::small_vector_default_options
+{
+  using growth_policy = GrowthPolicy;
+};
+
+template <typename T, unsigned N, typename GrowthPolicy, typename Allocator = std::allocator<T>>
+using growth_vector = gch::small_vector<T, N, Allocator, growth_options<GrowthPolicy>>;
+
+struct tripling
+{
+  template <typename T, typename SizeType>
+  static constexpr
+  SizeType
+  calculate_new_capacity (SizeType current, SizeType required, SizeType maximum) noexcept
+  {
+    return (maximum - current) / 2 <= current ? maximum
+                                              : (required < 3 * current ? 3 * current : required);
+  }
+};
+
+template <typename GrowthPolicy>
+static GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test_push_back (std::initializer_list<std::size_t> expected)
+{
+  growth_vector<int, 4, GrowthPolicy> v;
+  CHECK (4 == v.capacity ());
+
+  auto it = expected.begin ();
+  while (it != expected.end ())
+  {
+    if (v.size () == v.capacity ())
+    {
+      v.push_back (static_cast<int> (v.size ()));
+      CHECK (*it++ == v.capacity ());
+    }
+    else
+      v.push_back (static_cast<int> (v.size ()));
+  }
+
+  return 0;
+}
+
+template <typename GrowthPolicy>
+static GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test_saturation (void)
+{
+  // The growth policy must not grow past `max_size ()`.
+  using alloc_type = gch::test_types::sized_allocator<std::int8_t, std::uint8_t>;
+  growth_vector<std::int8_t, 1, GrowthPolicy, alloc_type> v;
+  CHECK (127U == v.max_size ());
+
+  while (v.size () < v.max_size ())
+  {
+    v.push_back (1);
+    CHECK (v.size () <= v.capacity ());
+    CHECK (v.capacity () <= v.max_size ());
+  }
+
+  CHECK (v.capacity () == v.max_size ());
+
+  return 0;
+}
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+  using namespace gch::small_vector_growth;
+
+  static_assert (std::is_same<gch::small_vector<int, 4>,
+                              gch::small_vector<int, 4, std::allocator<int>,
+                                                gch::small_vector_default_options>>::value,
+                 "The default options should be used by default.");
+
+  CHECK (0 == test_push_back<doubling> ({ 8, 16, 32 }));
+  CHECK (0 == test_push_back<one_and_a_half> ({ 6, 9, 13, 19 }));
+  CHECK (0 == test_push_back<exact> ({ 5, 6, 7, 8 }));
+  CHECK (0 == test_push_back<chunked<8 * sizeof (int)>> ({ 8, 16, 24, 32 }));
+  CHECK (0 == test_push_back<chunked<2 * sizeof (int)>> ({ 6, 8, 10 }));
+  CHECK (0 == test_push_back<tripling> ({ 12, 36 }));
+
+  CHECK (0 == test_saturation<doubling> ());
+  CHECK (0 == test_saturation<one_and_a_half> ());
+  CHECK (0 == test_saturation<exact> ());
+  CHECK (0 == test_saturation<chunked<16>> ());
+
+  // `reserve` uses the growth policy.
+  {
+    growth_vector<int, 4, exact> v;
+    v.reserve (5);
+    CHECK (5 == v.capacity ());
+
+    v.reserve (7);
+    CHECK (7 == v.capacity ());
+
+    growth_vector<int, 4, doubling> w;
+    w.reserve (5);
+    CHECK (8 == w.capacity ());
+  }
+
+  // A request larger than the growth is used as-is.
+  {
+    growth_vector<int, 4, one_and_a_half> v;
+    v.reserve (20);
+    CHECK (20 == v.capacity ());
+  }
+
+  // Range appends and insertions use the growth policy.
+  {
+    const int arr[] = { 1, 2, 3 };
+
+    growth_vector<int, 4, exact> v { 1, 2, 3 };
+    v.append (std::begin (arr), std::end (arr));
+    CHECK (6 == v.capacity ());
+
+    v.insert (v.begin (), 3, 0);
+    CHECK (9 == v.capacity ());
+
+    growth_vector<int, 4, one_and_a_half> w { 1, 2, 3, 4 };
+    w.insert (w.end (), 1, 5);
+    CHECK (6 == w.capacity ());
+
+    w.append (std::begin (arr), std::end (arr));
+    CHECK (9 == w.capacity ());
+    CHECK (w == growth_vector<int, 4, one_and_a_half> { 1, 2, 3, 4, 5, 1, 2, 3 });
+  }
+
+  // Vectors with different inline capacities and the same options interoperate.
+  {
+    growth_vector<int, 2, exact> v { 1, 2, 3 };
+    growth_vector<int, 4, exact> w { 4, 5 };
+
+    v.swap (w);
+    CHECK (v == growth_vector<int, 2, exact> { 4, 5 });
+    CHECK (w == growth_vector<int, 4, exact> { 1, 2, 3 });
+
+    w.assign (std::move (v));
+    CHECK (w == growth_vector<int, 4, exact> { 4, 5 });
+  }
+
+  return 0;
+}
@@ -0,0 +1,121 @@
+/** test-huge-page-allocator.cpp
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+#include "test_allocators.hpp"
+
+#if ! defined (GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR) && ! defined (_WIN32)
+
+#include "gch/huge_page_allocator.hpp"
+
+#include <cstdint>
+
+template <typename T>
+bool
+is_huge_page_aligned (const T *p)
+{
+  return reinterpret_cast<std::uintptr_t> (p) % gch::detail::huge_page_size == 0;
+}
+
+template <typename Vector>
+bool
+is_iota (const Vector& v)
+{
+  for (std::size_t i = 0; i < v.size (); ++i)
+  {
+    if (v[i] != static_cast<typename Vector::value_type> (i))
+      return false;
+  }
+  return true;
+}
+
+template <typename Allocator>
+void
+test_with_allocator (void)
+{
+  constexpr std::size_t num_huge = gch::detail::huge_page_size / sizeof (int);
+
+  gch::small_vector<int, 4, Allocator> v;
+  for (int i = 0; i < 100; ++i)
+    v.push_back (i);
+  CHECK (100 == v.size ());
+  CHECK (v.capacity () < num_huge);
+
+  // Grow into huge pages.
+  for (int i = 100; i < static_cast<int> (num_huge) + 1; ++i)
+    v.push_back (i);
+  CHECK (is_iota (v));
+  CHECK (is_huge_page_aligned (v.data ()));
+  CHECK (0 == v.capacity () % num_huge);
+
+  v.resize (3 * num_huge);
+  CHECK (is_huge_page_aligned (v.data ()));
+  CHECK (0 == v.capacity () % num_huge);
+
+  // Copies are allocated with the same rules.
+  gch::small_vector<int, 4, Allocator> w (v);
+  CHECK (w == v);
+  CHECK (is_huge_page_aligned (w.data ()));
+
+  // Shrink back to the wrapped allocator, then to inline storage.
+  v.resize (10);
+  v.shrink_to_fit ();
+  CHECK (10 == v.capacity ());
+  CHECK (is_iota (v));
+
+  v.resize (4);
+  v.shrink_to_fit ();
+  CHECK (v.inlined ());
+  CHECK (is_iota (v));
+}
+
+#endif
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+#if ! defined (GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR) && ! defined (_WIN32)
+  using namespace gch::test_types;
+
+  using alloc_type = gch::huge_page_allocator<int>;
+
+  static_assert (! alloc_type::is_huge (0), "");
+  static_assert (! alloc_type::is_huge (gch::detail::huge_page_size / sizeof (int) - 1), "");
+  static_assert (alloc_type::is_huge (gch::detail::huge_page_size / sizeof (int)), "");
+
+  test_with_allocator<alloc_type> ();
+
+  // Small allocations are made by the wrapped allocator, which checks that each deallocation
+  // matches an allocation.
+  test_with_allocator<gch::huge_page_allocator<int, verifying_allocator<int>>> ();
+
+  // A lower threshold.
+  {
+    using small_threshold_alloc = gch::huge_page_allocator<int, std::allocator<int>, 4096>;
+    gch::small_vector<int, 4, small_threshold_alloc> v;
+    v.resize (1024);
+    CHECK (is_huge_page_aligned (v.data ()));
+    CHECK (gch::detail::huge_page_size / sizeof (int) == v.capacity ());
+
+    v.resize (1023);
+    v.shrink_to_fit ();
+    CHECK (1023 == v.capacity ());
+  }
+
+  // The allocator is rebound with the wrapped allocator.
+  {
+    using rebound_type = std::allocator_traits<alloc_type>::rebind_alloc<char>;
+    static_assert (std::is_same<gch::huge_page_allocator<char>, rebound_type>::value, "");
+
+    const rebound_type rebound { alloc_type { } };
+    CHECK (rebound == alloc_type { });
+  }
+#endif
+
+  return 0;
+}
@@ -0,0 +1,206 @@
+/** test-reallocate.cpp
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+#include "test_allocators.hpp"
+
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+
+#include <cstdlib>
+
+#ifndef _WIN32
+#  include "gch/mmap_allocator.hpp"
+#endif
+
+static std::size_t num_reallocations = 0;
+
+// Reallocates with `std::realloc` and counts the number of reallocations.
+template <typename T>
+struct realloc_allocator
+{
+  using value_type = T;
+
+  realloc_allocator (void) = default;
+
+  template <typename U>
+  constexpr
+  realloc_allocator (const realloc_allocator<U>&) noexcept
+  { }
+
+  T *
+  allocate (std::size_t n)
+  {
+    return check (std::malloc (n * sizeof (T)));
+  }
+
+  void
+  deallocate (T *p, std::size_t) noexcept
+  {
+    std::free (p);
+  }
+
+  gch::allocation_result<T *, std::size_t>
+  reallocate (T *p, std::size_t, std::size_t new_n)
+  {
+    ++num_reallocations;
+    return { check (std::realloc (static_cast<void *> (p), new_n * sizeof (T))), new_n };
+  }
+
+  static
+  T *
+  check (void *p)
+  {
+    if (p == nullptr)
+    {
+#ifdef GCH_EXCEPTIONS
+      throw std::bad_alloc ();
+#else
+      std::abort ();
+#endif
+    }
+    return static_cast<T *> (p);
+  }
+};
+
+template <typename T, typename U>
+constexpr
+bool
+operator== (const realloc_allocator<T>&, const realloc_allocator<U>&) noexcept
+{
+  return true;
+}
+
+template <typename T, typename U>
+constexpr
+bool
+operator!= (const realloc_allocator<T>&, const realloc_allocator<U>&) noexcept
+{
+  return false;
+}
+
+template <typename T, unsigned N = 4, typename Options = gch::small_vector_default_options>
+using realloc_vector = gch::small_vector<T, N, realloc_allocator<T>, Options>;
+
+template <typename Layout>
+using layout_options = gch::small_vector_layout_options<Layout>;
+
+template <typename Vector>
+bool
+is_iota (const Vector& v)
+{
+  for (std::size_t i = 0; i < v.size (); ++i)
+  {
+    if (v[i] != static_cast<typename Vector::value_type> (i))
+      return false;
+  }
+  return true;
+}
+
+template <unsigned N, typename Options>
+void
+test_growth (void)
+{
+  num_reallocations = 0;
+
+  realloc_vector<int, N, Options> v;
+  for (int i = 0; i < 1000; ++i)
+    v.push_back (i);
+  CHECK (1000 == v.size ());
+  CHECK (is_iota (v));
+  CHECK (0 < num_reallocations);
+
+  const std::size_t count = num_reallocations;
+  v.reserve (5000);
+  CHECK (count + 1 == num_reallocations);
+  CHECK (5000 <= v.capacity ());
+  CHECK (1000 == v.size ());
+  CHECK (is_iota (v));
+
+  v.resize (10000);
+  CHECK (count + 2 == num_reallocations);
+  CHECK (10000 == v.size ());
+  CHECK (0 == v.back ());
+  CHECK (999 == v[999]);
+}
+
+#endif
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+  using namespace gch::test_types;
+
+  // Allocations of trivially relocatable elements are grown with `reallocate`.
+  test_growth<4, gch::small_vector_default_options> ();
+  test_growth<0, gch::small_vector_default_options> ();
+  test_growth<4, layout_options<gch::small_vector_layout::compact>> ();
+  test_growth<0, layout_options<gch::small_vector_layout::heap_header>> ();
+
+  // The first allocation is made with `allocate`.
+  {
+    num_reallocations = 0;
+
+    realloc_vector<int> v { 1, 2, 3, 4 };
+    v.push_back (5);
+    CHECK (0 == num_reallocations);
+    CHECK (realloc_vector<int> { 1, 2, 3, 4, 5 } == v);
+  }
+
+  // Elements which are not trivially relocatable are relocated one by one.
+  {
+    num_reallocations = 0;
+
+    realloc_vector<non_trivial> v (5);
+    v.reserve (100);
+    v.push_back (non_trivial { });
+    CHECK (0 == num_reallocations);
+    CHECK (6 == v.size ());
+  }
+
+  // Arguments which refer to elements are still valid.
+  {
+    num_reallocations = 0;
+
+    realloc_vector<int> v { 1, 2, 3, 4, 5 };
+    v.resize (v.capacity ());
+    v.push_back (v.front ());
+    CHECK (1 == num_reallocations);
+    CHECK (1 == v.back ());
+
+    v.resize (v.capacity () + 1, v[1]);
+    CHECK (2 == num_reallocations);
+    CHECK (2 == v.back ());
+  }
+
+#ifndef _WIN32
+  {
+    gch::small_vector<int, 0, gch::mmap_allocator<int>> v;
+    for (int i = 0; i < 100000; ++i)
+      v.push_back (i);
+    CHECK (100000 == v.size ());
+    CHECK (is_iota (v));
+
+    v.reserve (1000000);
+    CHECK (1000000 <= v.capacity ());
+    CHECK (is_iota (v));
+
+    v.resize (10);
+    v.shrink_to_fit ();
+    CHECK (10 <= v.capacity ());
+    CHECK (is_iota (v));
+
+    auto w = v;
+    CHECK (w == v);
+  }
+#endif
+
+#endif
+
+  return 0;
+}
@@ -0,0 +1,141 @@
+/** test-block-copy.cpp
+ * Copyright © 2022 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+
+#include <array>
+
+using compact_options = gch::small_vector_layout_options<gch::small_vector_layout::compact>;
+
+// Too large to be copied as a single block.
+using big_trivial = std::array<int, 32>;
+
+template <typename Vector>
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+Vector
+make_vector (std::size_t count)
+{
+  Vector v;
+  for (std::size_t i = 0; i < count; ++i)
+    v.emplace_back (typename Vector::value_type { static_cast<int> (i + 1) });
+  return v;
+}
+
+template <typename Vector, typename Other>
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+check_equal (const Vector& v, const Other& w)
+{
+  CHECK (v.size () == w.size ());
+  CHECK (std::equal (v.begin (), v.end (), w.begin ()));
+  return 0;
+}
+
+template <typename T, unsigned N, unsigned M, typename Options>
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test_with_capacities (void)
+{
+  using n_vector = gch::small_vector<T, N, std::allocator<T>, Options>;
+  using m_vector = gch::small_vector<T, M, std::allocator<T>, Options>;
+
+  for (std::size_t i = 0; i <= N + 1; ++i)
+  {
+    const n_vector v = make_vector<n_vector> (i);
+
+    // Copy construction.
+    {
+      n_vector w (v);
+      CHECK (0 == check_equal (w, v));
+
+      m_vector x (v);
+      CHECK (0 == check_equal (x, v));
+
+      // Elements past the end of a copy must not be observable.
+      w.push_back (T { 42 });
+      CHECK (T { 42 } == w.back ());
+      CHECK (0 == check_equal (v, n_vector (w.begin (), std::prev (w.end ()))));
+    }
+
+    // Move construction.
+    {
+      n_vector w (v);
+      n_vector x (std::move (w));
+      CHECK (0 == check_equal (x, v));
+
+      n_vector y (v);
+      m_vector z (std::move (y));
+      CHECK (0 == check_equal (z, v));
+
+      m_vector a (make_vector<m_vector> (i));
+      n_vector b (std::move (a));
+      CHECK (0 == check_equal (b, v));
+    }
+
+    // Copy assignment.
+    for (std::size_t j = 0; j <= N + 1; ++j)
+    {
+      n_vector w = make_vector<n_vector> (j);
+      w = v;
+      CHECK (0 == check_equal (w, v));
+
+      m_vector x = make_vector<m_vector> (j);
+      x.assign (v);
+      CHECK (0 == check_equal (x, v));
+    }
+
+    // Swap.
+    for (std::size_t j = 0; j <= N + 1; ++j)
+    {
+      n_vector w (v);
+      n_vector x = make_vector<n_vector> (j);
+      w.swap (x);
+      CHECK (0 == check_equal (w, make_vector<n_vector> (j)));
+      CHECK (0 == check_equal (x, v));
+
+      m_vector y = make_vector<m_vector> (j);
+      x.swap (y);
+      CHECK (0 == check_equal (x, make_vector<n_vector> (j)));
+      CHECK (0 == check_equal (y, v));
+    }
+
+    // Swap with itself.
+    {
+      n_vector w (v);
+      w.swap (w);
+      CHECK (0 == check_equal (w, v));
+    }
+  }
+
+  return 0;
+}
+
+template <typename T, typename Options>
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test_with_type (void)
+{
+  CHECK (0 == (test_with_capacities<T, 4, 4, Options> ()));
+  CHECK (0 == (test_with_capacities<T, 4, 2, Options> ()));
+  CHECK (0 == (test_with_capacities<T, 2, 4, Options> ()));
+  CHECK (0 == (test_with_capacities<T, 4, 0, Options> ()));
+  return 0;
+}
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+  using namespace gch::test_types;
+
+  CHECK (0 == (test_with_type<int, gch::small_vector_default_options> ()));
+  CHECK (0 == (test_with_type<int, compact_options> ()));
+  CHECK (0 == (test_with_type<big_trivial, gch::small_vector_default_options> ()));
+  CHECK (0 == (test_with_type<non_trivial, gch::small_vector_default_options> ()));
+
+  return 0;
+}
@@ -0,0 +1,109 @@
+/** test-alignment.cpp
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+
+#include "gch/aligned_allocator.hpp"
+
+#include <cstdint>
+
+template <typename Layout = gch::small_vector_layout::standard>
+using aligned_options =
+  gch::small_vector_alignment_options<64, gch::small_vector_layout_options<Layout>>;
+
+template <typename T, unsigned N, typename Layout = gch::small_vector_layout::standard>
+using aligned_vector =
+  gch::small_vector<T, N, gch::aligned_allocator<T, 64>, aligned_options<Layout>>;
+
+static_assert (gch::aligned_allocator<float, 64>::alignment == 64, "");
+static_assert (gch::aligned_allocator<double, 1>::alignment == alignof (double), "");
+
+static_assert (alignof (aligned_vector<float, 16>) == 64,
+               "The inline storage should be over-aligned.");
+
+// The inline elements are not padded to the alignment.
+static_assert (sizeof (aligned_vector<float, 16>) <= 2 * 64 + 16 * sizeof (float), "");
+
+template <typename T>
+bool
+is_aligned (const T *p)
+{
+  return reinterpret_cast<std::uintptr_t> (p) % 64 == 0;
+}
+
+template <typename Vector>
+bool
+is_iota (const Vector& v)
+{
+  for (std::size_t i = 0; i < v.size (); ++i)
+  {
+    if (v[i] != static_cast<typename Vector::value_type> (i))
+      return false;
+  }
+  return true;
+}
+
+template <typename Vector>
+void
+test_with_vector (void)
+{
+  Vector v;
+  CHECK (v.inlined ());
+  CHECK (is_aligned (v.data ()));
+
+  for (int i = 0; i < 3; ++i)
+    v.push_back (static_cast<typename Vector::value_type> (i));
+  CHECK (v.inlined () == (3 <= v.inline_capacity ()));
+  CHECK (is_aligned (v.data ()));
+  CHECK (is_iota (v));
+
+  for (int i = 3; i < 1000; ++i)
+    v.push_back (static_cast<typename Vector::value_type> (i));
+  CHECK (! v.inlined ());
+  CHECK (is_aligned (v.data ()));
+  CHECK (is_iota (v));
+
+  Vector w (v);
+  CHECK (w == v);
+  CHECK (is_aligned (w.data ()));
+
+  v.resize (3);
+  v.shrink_to_fit ();
+  CHECK (v.inlined () == (3 <= v.inline_capacity ()));
+  CHECK (is_aligned (v.data ()));
+  CHECK (is_iota (v));
+
+  v.swap (w);
+  CHECK (1000 == v.size ());
+  CHECK (3 == w.size ());
+  CHECK (is_aligned (v.data ()));
+  CHECK (is_aligned (w.data ()));
+}
+
+#endif
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+  test_with_vector<aligned_vector<float, 16>> ();
+  test_with_vector<aligned_vector<double, 4>> ();
+  test_with_vector<aligned_vector<char, 8>> ();
+  test_with_vector<aligned_vector<float, 16, gch::small_vector_layout::compact>> ();
+  test_with_vector<aligned_vector<float, 0>> ();
+
+  // Argument-dependent lookup should not find `std::assume_aligned` for elements from `std`.
+  gch::small_vector<std::unique_ptr<int>, 2> v;
+  v.emplace_back (new int (1));
+  CHECK (1 == *v.data ()[0]);
+#endif
+
+  return 0;
+}
@@ -0,0 +1,141 @@
+/** test-heap-header.cpp
+ * Copyright © 2022 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+#include "test_allocators.hpp"
+
+using header_options = gch::small_vector_layout_options<gch::small_vector_layout::heap_header>;
+
+template <typename T, typename Allocator = std::allocator<T>>
+using header_vector = gch::small_vector<T, 0, Allocator, header_options>;
+
+static_assert (sizeof (header_vector<int>) == sizeof (int *),
+               "An empty vector should only be a pointer.");
+
+static_assert (gch::default_buffer_size<std::allocator<int>, header_options>::value == 0,
+               "The heap header layout should not have a default inline capacity.");
+
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+
+template <typename T, typename Allocator>
+int
+test_with_allocator (const Allocator& alloc_a, const Allocator& alloc_b)
+{
+  using vector_type = header_vector<T, Allocator>;
+
+  // A vector without elements has no allocation.
+  {
+    vector_type v (alloc_a);
+    CHECK (v.empty ());
+    CHECK (0 == v.capacity ());
+    CHECK (nullptr == v.data ());
+
+    for (int i = 0; i < 20; ++i)
+      v.push_back (T (i));
+    CHECK (20 == v.size ());
+    CHECK (20 <= v.capacity ());
+    CHECK (T (19) == v.back ());
+
+    // The size must follow the elements to the new allocation.
+    v.erase (std::next (v.begin (), 5), v.end ());
+    v.shrink_to_fit ();
+    CHECK (5 == v.size ());
+    CHECK (5 == v.capacity ());
+    CHECK (v == vector_type { T (0), T (1), T (2), T (3), T (4) });
+
+    v.clear ();
+    v.shrink_to_fit ();
+    CHECK (0 == v.capacity ());
+    CHECK (nullptr == v.data ());
+  }
+
+  // Copies, moves, and swaps.
+  {
+    vector_type v ({ T (1), T (2), T (3) }, alloc_a);
+    vector_type w (v);
+    CHECK (v == w);
+
+    vector_type x (std::move (w));
+    CHECK (v == x);
+    CHECK (w.empty ());
+    CHECK (nullptr == w.data ());
+
+    w.assign ({ T (4), T (5) });
+    w.swap (x);
+    CHECK (w == v);
+    CHECK (x == vector_type { T (4), T (5) });
+
+    x = vector_type (alloc_a);
+    CHECK (x.empty ());
+    CHECK (0 == x.capacity ());
+  }
+
+  // Swap with a different allocator.
+  {
+    vector_type v ({ T (1), T (2), T (3) }, alloc_a);
+    vector_type w ({ T (4), T (5), T (6), T (7), T (8) }, alloc_b);
+
+    v.swap (w);
+    CHECK (v == vector_type { T (4), T (5), T (6), T (7), T (8) });
+    CHECK (w == vector_type { T (1), T (2), T (3) });
+
+    vector_type x (alloc_b);
+    x.swap (v);
+    CHECK (v.empty ());
+    CHECK (x == vector_type { T (4), T (5), T (6), T (7), T (8) });
+  }
+
+  return 0;
+}
+
+template <template <typename ...> class AllocatorT>
+int
+test_with_types (void)
+{
+  using namespace gch::test_types;
+
+  CHECK (0 == (test_with_allocator<int> (AllocatorT<int> (1), AllocatorT<int> (2))));
+  CHECK (0 == (test_with_allocator<char> (AllocatorT<char> (1), AllocatorT<char> (2))));
+  CHECK (0 == (test_with_allocator<non_trivial> (AllocatorT<non_trivial> (1),
+                                                 AllocatorT<non_trivial> (2))));
+
+  return 0;
+}
+
+#endif
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+#ifdef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+  // This layout cannot be used in constant expressions.
+  return 0;
+#else
+  using namespace gch::test_types;
+
+  CHECK (0 == test_with_types<verifying_allocator> ());
+  CHECK (0 == test_with_types<non_propagating_verifying_allocator> ());
+
+#ifdef GCH_SMALL_VECTOR_TEST_EXCEPTION_SAFETY_TESTING
+  // A failed reallocation leaves the header of the old allocation alone.
+  {
+    header_vector<triggering_type> v { 1, 2, 3 };
+    v.shrink_to_fit ();
+    auto v_save = v;
+
+    exception_trigger::push (1);
+    EXPECT_TEST_EXCEPTION (v.push_back (4));
+    CHECK (3 == v.size ());
+    CHECK (3 == v.capacity ());
+    CHECK (v == v_save);
+  }
+#endif
+
+  return 0;
+#endif
+}
@@ -0,0 +1,194 @@
+/** test-layout.cpp
+ * Copyright © 2022 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+
+using compact_options = gch::small_vector_layout_options<gch::small_vector_layout::compact>;
+
+template <typename T, unsigned N>
+using compact_vector = gch::small_vector<T, N, std::allocator<T>, compact_options>;
+
+static_assert (sizeof (compact_vector<int, 4>) < sizeof (gch::small_vector<int, 4>),
+               "The compact layout should be smaller.");
+
+static_assert (sizeof (compact_vector<int, 0>) == sizeof (gch::small_vector<int, 0>),
+               "The compact layout should have no effect without inline storage.");
+
+static_assert (gch::default_buffer_size<std::allocator<int>>::value
+                 < gch::default_buffer_size<std::allocator<int>, compact_options>::value,
+               "The compact layout should fit more elements in the default buffer.");
+
+template <typename T>
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test_with_type (void)
+{
+  // Move to an allocation and back.
+  {
+    compact_vector<T, 4> v { 1, 2, 3 };
+    CHECK_IF_NOT_CONSTEXPR (v.inlined ());
+    CHECK (3 == v.size ());
+
+    v.append ({ 4, 5, 6 });
+    CHECK (! v.inlined ());
+    CHECK (6 <= v.capacity ());
+    CHECK (v == compact_vector<T, 4> { 1, 2, 3, 4, 5, 6 });
+
+    v.erase (std::next (v.begin (), 2), v.end ());
+    v.shrink_to_fit ();
+    CHECK_IF_NOT_CONSTEXPR (v.inlined ());
+    CHECK_IF_NOT_CONSTEXPR (4 == v.capacity ());
+    CHECK (v == compact_vector<T, 4> { 1, 2 });
+  }
+
+  // Assign into the inline storage while allocated.
+  {
+    compact_vector<T, 4> v { 1, 2, 3, 4, 5 };
+    v.assign ({ 7, 8 });
+    CHECK_IF_NOT_CONSTEXPR (v.inlined ());
+    CHECK (v == compact_vector<T, 4> { 7, 8 });
+
+    compact_vector<T, 4> w { 1, 2, 3, 4, 5 };
+    w = v;
+    CHECK (w == v);
+
+    w = compact_vector<T, 4> { 1, 2, 3, 4, 5, 6 };
+    CHECK (! w.inlined ());
+    CHECK (w == compact_vector<T, 4> { 1, 2, 3, 4, 5, 6 });
+
+    compact_vector<T, 4> x (std::move (w));
+    CHECK (x == compact_vector<T, 4> { 1, 2, 3, 4, 5, 6 });
+    CHECK (w.empty ());
+  }
+
+  // Swap an allocated vector with an inlined vector.
+  {
+    compact_vector<T, 4> v { 1, 2, 3, 4, 5, 6 };
+    compact_vector<T, 2> w { 7 };
+
+    v.swap (w);
+    CHECK_IF_NOT_CONSTEXPR (v.inlined ());
+    CHECK (v == compact_vector<T, 4> { 7 });
+    CHECK (w == compact_vector<T, 2> { 1, 2, 3, 4, 5, 6 });
+
+    w.swap (v);
+    CHECK (v == compact_vector<T, 4> { 1, 2, 3, 4, 5, 6 });
+    CHECK (w == compact_vector<T, 2> { 7 });
+  }
+
+  // Swap an inlined vector with a vector whose allocation fits in its inline storage.
+  {
+    compact_vector<T, 4> v { 1 };
+    compact_vector<T, 2> w { 2, 3, 4 };
+    CHECK (! w.inlined ());
+
+    v.swap (w);
+    CHECK_IF_NOT_CONSTEXPR (v.inlined ());
+    CHECK_IF_NOT_CONSTEXPR (w.inlined ());
+    CHECK (v == compact_vector<T, 4> { 2, 3, 4 });
+    CHECK (w == compact_vector<T, 2> { 1 });
+  }
+
+  // Swap two allocated vectors.
+  {
+    compact_vector<T, 4> v { 1, 2, 3, 4, 5 };
+    compact_vector<T, 2> w { 6, 7, 8, 9, 10, 11 };
+
+    v.swap (w);
+    CHECK (v == compact_vector<T, 4> { 6, 7, 8, 9, 10, 11 });
+    CHECK (w == compact_vector<T, 2> { 1, 2, 3, 4, 5 });
+  }
+
+  // Swap with a vector which has no inline storage.
+  {
+    compact_vector<T, 4> v { 1, 2, 3, 4, 5 };
+    compact_vector<T, 0> w { 6, 7 };
+
+    v.swap (w);
+    CHECK (v == compact_vector<T, 4> { 6, 7 });
+    CHECK (w == compact_vector<T, 0> { 1, 2, 3, 4, 5 });
+
+    w.swap (v);
+    CHECK (v == compact_vector<T, 4> { 1, 2, 3, 4, 5 });
+    CHECK (w == compact_vector<T, 0> { 6, 7 });
+  }
+
+  // Moving takes the allocation only if it does not fit in the inline storage.
+  {
+    compact_vector<T, 2> v { 1, 2, 3 };
+    compact_vector<T, 2> w { 1, 2, 3, 4, 5 };
+    const T *w_data = w.data ();
+
+    compact_vector<T, 4> x (std::move (v));
+    CHECK_IF_NOT_CONSTEXPR (x.inlined ());
+    CHECK (x == compact_vector<T, 4> { 1, 2, 3 });
+
+    compact_vector<T, 4> y (std::move (w));
+    CHECK (! y.inlined ());
+    CHECK_IF_NOT_CONSTEXPR (w_data == y.data ());
+    CHECK_IF_NOT_CONSTEXPR (w.inlined ());
+    CHECK (y == compact_vector<T, 4> { 1, 2, 3, 4, 5 });
+
+    x = std::move (y);
+    CHECK (! x.inlined ());
+    CHECK_IF_NOT_CONSTEXPR (w_data == x.data ());
+    CHECK (x == compact_vector<T, 4> { 1, 2, 3, 4, 5 });
+  }
+
+  return 0;
+}
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+  CHECK (0 == test_with_type<int> ());
+  CHECK (0 == test_with_type<gch::test_types::non_trivial> ());
+
+#ifdef GCH_SMALL_VECTOR_TEST_EXCEPTION_SAFETY_TESTING
+  using namespace gch::test_types;
+
+  // The allocation must be kept if moving into the inline storage throws.
+  {
+    compact_vector<triggering_type, 4> v { 1, 2, 3, 4, 5 };
+    v.pop_back ();
+    v.pop_back ();
+    auto v_save = v;
+
+    exception_trigger::push (1);
+    EXPECT_TEST_EXCEPTION (v.shrink_to_fit ());
+    CHECK (! v.inlined ());
+    CHECK (v == v_save);
+  }
+
+  {
+    compact_vector<triggering_type, 4> v { 1, 2, 3, 4, 5 };
+    compact_vector<triggering_type, 2> w { 6, 7 };
+    auto v_save = v;
+    auto w_save = w;
+
+    exception_trigger::push (1);
+    EXPECT_TEST_EXCEPTION (v.swap (w));
+    CHECK (! v.inlined ());
+    CHECK (v == v_save);
+    CHECK (w == w_save);
+  }
+
+  {
+    compact_vector<triggering_type, 4> v { 1, 2, 3, 4, 5 };
+    auto v_save = v;
+
+    const triggering_type arr[] { 6, 7 };
+    exception_trigger::push (1);
+    EXPECT_TEST_EXCEPTION (v.assign (std::begin (arr), std::end (arr)));
+    CHECK (! v.inlined ());
+    CHECK (v == v_save);
+  }
+#endif
+
+  return 0;
+}
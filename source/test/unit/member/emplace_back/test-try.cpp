@@ -0,0 +1,105 @@
+/** test-try.cpp
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+#include "test_allocators.hpp"
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+  using namespace gch::test_types;
+
+  // Append without reallocation.
+  {
+    gch::small_vector<int, 4> v { 1 };
+    int *p = v.try_push_back (2);
+    CHECK (p == &v.back ());
+
+    p = v.try_emplace_back (3);
+    CHECK (p == &v.back ());
+    CHECK (decltype (v) { 1, 2, 3 } == v);
+    CHECK_IF_NOT_CONSTEXPR (v.inlined ());
+  }
+
+  // Append with reallocation.
+  {
+    gch::small_vector<int, 2> v { 1, 2 };
+    int *p = v.try_push_back (3);
+    CHECK (p == &v.back ());
+    CHECK (decltype (v) { 1, 2, 3 } == v);
+    CHECK (! v.inlined ());
+  }
+
+  // The argument may refer to an element which is moved during reallocation.
+  {
+    gch::small_vector<nontrivial_data_base, 2> v { 1, 2 };
+    nontrivial_data_base *p = v.try_push_back (v.front ());
+    CHECK (p == &v.back ());
+    CHECK (decltype (v) { 1, 2, 1 } == v);
+
+    v.shrink_to_fit ();
+    p = v.try_emplace_back (v[1]);
+    CHECK (p == &v.back ());
+    CHECK (decltype (v) { 1, 2, 1, 2 } == v);
+  }
+
+  // Fail to allocate.
+  {
+    gch::small_vector<int, 4, try_limited_allocator<int, 4>> v { 1, 2, 3, 4 };
+    int *p = v.try_push_back (5);
+    CHECK (nullptr == p);
+
+    p = v.try_emplace_back (5);
+    CHECK (nullptr == p);
+    CHECK (decltype (v) { 1, 2, 3, 4 } == v);
+  }
+
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+
+#ifdef GCH_EXCEPTIONS
+  // Fail to allocate with an allocator which throws `std::bad_alloc`.
+  {
+    gch::small_vector<nontrivial_data_base, 2, limited_allocator<nontrivial_data_base, 2>> v {
+      1, 2
+    };
+
+    nontrivial_data_base *p = v.try_push_back (v.front ());
+    CHECK (nullptr == p);
+    CHECK (decltype (v) { 1, 2 } == v);
+  }
+#endif
+
+  // Fail because of the maximum size.
+  {
+    gch::small_vector_with_allocator<std::int8_t, sized_allocator<std::int8_t, std::uint8_t>> w;
+    w.assign (w.max_size (), 1);
+    auto w_save = w;
+
+    std::int8_t *p = w.try_push_back (1);
+    CHECK (nullptr == p);
+    CHECK (w == w_save);
+  }
+
+  // Test strong exception guarantees when the element throws.
+  {
+    gch::small_vector<triggering_type, 2, verifying_allocator<triggering_type>> v (2);
+    auto v_save = v;
+
+    exception_trigger::push (0);
+    EXPECT_TEST_EXCEPTION (static_cast<void> (v.try_emplace_back ()));
+    CHECK (v == v_save);
+
+    exception_trigger::push (1);
+    EXPECT_TEST_EXCEPTION (static_cast<void> (v.try_emplace_back ()));
+    CHECK (v == v_save);
+  }
+
+#endif
+
+  return 0;
+}
@@ -0,0 +1,84 @@
+/** test-unchecked.cpp
+ * Copyright © 2022 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+#include "test_allocators.hpp"
+
+template <typename T, typename Allocator = std::allocator<T>>
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test_with_type (Allocator alloc = Allocator ())
+{
+  // Inlined.
+  {
+    gch::small_vector<T, 3, Allocator> v ({ T (1) }, alloc);
+    auto& ref = v.unchecked_emplace_back (2);
+
+    CHECK (&v.back () == &ref);
+    CHECK (T (2) == ref);
+
+    const T t (3);
+    v.unchecked_push_back (t);
+    CHECK (decltype (v) { T (1), T (2), T (3) } == v);
+    CHECK (3 == v.capacity ());
+  }
+
+  // Allocated.
+  {
+    gch::small_vector<T, 1, Allocator> v ({ T (1) }, alloc);
+    v.reserve (4);
+
+    const auto capacity = v.capacity ();
+    const auto data     = v.data ();
+
+    v.unchecked_push_back (T (2));
+    v.unchecked_emplace_back (3);
+    v.unchecked_push_back (T (4));
+
+    CHECK (decltype (v) { T (1), T (2), T (3), T (4) } == v);
+    CHECK (capacity == v.capacity ());
+    CHECK (data == v.data ());
+  }
+
+  return 0;
+}
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+  using namespace gch::test_types;
+
+  CHECK (0 == test_with_type<trivially_copyable_data_base> ());
+  CHECK (0 == test_with_type<nontrivial_data_base> ());
+
+  CHECK (0 == test_with_type<trivially_copyable_data_base,
+                             sized_allocator<trivially_copyable_data_base, std::uint8_t>> ());
+
+  CHECK (0 == test_with_type<nontrivial_data_base,
+                             fancy_pointer_allocator<nontrivial_data_base>> ());
+
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+  CHECK (0 == test_with_type<nontrivial_data_base, verifying_allocator<nontrivial_data_base>> ());
+
+  // Throw during construction of the element at the end (No change).
+  {
+    using vector_type =
+      gch::small_vector<triggering_type, 4, verifying_allocator<triggering_type>>;
+
+    vector_type v { 1, 2, 3 };
+    vector_type v_save = v;
+
+    exception_trigger::push (0);
+    EXPECT_TEST_EXCEPTION (v.unchecked_emplace_back (4));
+
+    CHECK (v == v_save);
+  }
+#endif
+
+  return 0;
+}
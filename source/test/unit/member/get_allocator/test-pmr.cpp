@@ -0,0 +1,146 @@
+/** test-pmr.cpp
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+
+#if defined (GCH_LIB_MEMORY_RESOURCE) && ! defined (GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR)
+
+static_assert (
+  std::is_same<gch::pmr::small_vector<int, 4>,
+               gch::small_vector<int, 4, std::pmr::polymorphic_allocator<int>>>::value, "");
+
+static_assert (
+  std::uses_allocator<gch::pmr::small_vector<int>, std::pmr::polymorphic_allocator<int>>::value,
+  "");
+
+template <typename T>
+void
+test_with_resources (std::pmr::memory_resource& mr, std::pmr::memory_resource& other_mr)
+{
+  using vector_type = gch::pmr::small_vector<T, 4>;
+
+  CHECK (std::pmr::get_default_resource () == vector_type ().get_allocator ().resource ());
+
+  vector_type v ({ 1, 2, 3, 4, 5, 6 }, &mr);
+  CHECK (&mr == v.get_allocator ().resource ());
+
+  // Moving steals the allocation.
+  {
+    const T *data = v.data ();
+    vector_type w (std::move (v));
+    CHECK (&mr == w.get_allocator ().resource ());
+    CHECK (data == w.data ());
+
+    v = std::move (w);
+    CHECK (data == v.data ());
+  }
+
+  // Move assignment steals the allocation if the resources are equal.
+  {
+    vector_type w (&mr);
+    const T *data = v.data ();
+    w = std::move (v);
+    CHECK (data == w.data ());
+    CHECK (vector_type ({ 1, 2, 3, 4, 5, 6 }) == w);
+    v = std::move (w);
+  }
+
+  // Otherwise, the elements are moved, and the resource stays the same.
+  {
+    vector_type w (&other_mr);
+    const T *data = v.data ();
+    w = std::move (v);
+    CHECK (data != w.data ());
+    CHECK (&other_mr == w.get_allocator ().resource ());
+    CHECK (vector_type ({ 1, 2, 3, 4, 5, 6 }) == w);
+    v = vector_type (w, &mr);
+  }
+
+  // Swapping exchanges the allocations if the resources are equal.
+  {
+    vector_type w ({ 7, 8, 9, 10, 11 }, &mr);
+    const T *v_data = v.data ();
+    const T *w_data = w.data ();
+    v.swap (w);
+    CHECK (w_data == v.data ());
+    CHECK (v_data == w.data ());
+    CHECK (vector_type ({ 7, 8, 9, 10, 11 }) == v);
+    v.swap (w);
+  }
+
+  // Otherwise, the elements are swapped, and the resources stay the same.
+  {
+    vector_type w ({ 7, 8, 9 }, &other_mr);
+    v.swap (w);
+    CHECK (&mr == v.get_allocator ().resource ());
+    CHECK (&other_mr == w.get_allocator ().resource ());
+    CHECK (vector_type ({ 7, 8, 9 }) == v);
+    CHECK (vector_type ({ 1, 2, 3, 4, 5, 6 }) == w);
+    v.swap (w);
+  }
+
+  // Copies use the default resource, and copy assignment keeps the resource.
+  {
+    vector_type w (v);
+    CHECK (std::pmr::get_default_resource () == w.get_allocator ().resource ());
+    CHECK (v == w);
+
+    vector_type x (&other_mr);
+    x = v;
+    CHECK (&other_mr == x.get_allocator ().resource ());
+    CHECK (v == x);
+  }
+
+  // Nested vectors are constructed with the resource of the outer vector.
+  {
+    gch::pmr::small_vector<vector_type, 2> nested (&mr);
+    nested.emplace_back ();
+    nested.emplace_back (3U, T ());
+    nested.push_back (v);
+    nested.push_back (vector_type ({ 1, 2 }, &other_mr));
+    nested.resize (6);
+
+    CHECK (6 == nested.size ());
+    for (const vector_type& inner : nested)
+      CHECK (&mr == inner.get_allocator ().resource ());
+
+    CHECK (v == nested[2]);
+    CHECK (vector_type ({ 1, 2 }) == nested[3]);
+
+    // The inner vectors keep their resource after the outer vector grows.
+    nested.reserve (32);
+    for (const vector_type& inner : nested)
+      CHECK (&mr == inner.get_allocator ().resource ());
+  }
+}
+
+#endif
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+#if defined (GCH_LIB_MEMORY_RESOURCE) && ! defined (GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR)
+  using namespace gch::test_types;
+
+  {
+    std::pmr::monotonic_buffer_resource mr;
+    std::pmr::monotonic_buffer_resource other_mr;
+    test_with_resources<int> (mr, other_mr);
+    test_with_resources<non_trivial> (mr, other_mr);
+  }
+
+  {
+    std::pmr::unsynchronized_pool_resource mr;
+    std::pmr::unsynchronized_pool_resource other_mr;
+    test_with_resources<int> (mr, other_mr);
+    test_with_resources<non_trivial> (mr, other_mr);
+  }
+#endif
+
+  return 0;
+}
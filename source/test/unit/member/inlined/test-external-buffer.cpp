@@ -0,0 +1,183 @@
+/** test-external-buffer.cpp
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+
+#include "gch/buffer_allocator.hpp"
+
+// Uninitialized storage for a buffer of `N` objects of type `T`.
+template <typename T, std::size_t N>
+struct buffer_storage
+{
+  T *
+  data (void) noexcept
+  {
+    return reinterpret_cast<T *> (&m_bytes[0]);
+  }
+
+  alignas (T) unsigned char m_bytes[N * sizeof (T)];
+};
+
+template <typename T>
+void
+test_with_type (void)
+{
+  buffer_storage<T, 8> storage;
+  buffer_storage<T, 8> other_storage;
+
+  // The buffer is used before allocating.
+  {
+    gch::external_buffer<T> buffer (storage.data (), 8);
+    gch::buffer_vector<T> v (buffer);
+    CHECK (v.inlined ());
+
+    v.push_back (0);
+    CHECK (v.inlined ());
+    CHECK (storage.data () == v.data ());
+    CHECK (8 == v.capacity ());
+    CHECK (buffer.in_use ());
+
+    for (int i = 1; i < 8; ++i)
+      v.push_back (i);
+    CHECK (v.inlined ());
+    CHECK (storage.data () == v.data ());
+
+    v.push_back (8);
+    CHECK (! v.inlined ());
+    CHECK (! buffer.in_use ());
+    CHECK (9 == v.size ());
+    CHECK (8 == v.back ());
+
+    // Shrinking moves back into the buffer.
+    v.resize (3);
+    v.shrink_to_fit ();
+    CHECK (v.inlined ());
+    CHECK (storage.data () == v.data ());
+    CHECK (gch::buffer_vector<T> { 0, 1, 2 } == v);
+
+    // Only one vector can use the buffer at a time.
+    gch::buffer_vector<T> w (buffer);
+    w.push_back (0);
+    CHECK (! w.inlined ());
+
+    v.clear ();
+    v.shrink_to_fit ();
+    CHECK (! buffer.in_use ());
+  }
+
+  // The inline storage is used first, then the buffer, then the allocator.
+  {
+    gch::external_buffer<T> buffer (storage.data (), 8);
+    gch::buffer_vector<T, 2> v (buffer);
+
+    v.append ({ 0, 1 });
+    CHECK (v.inlined ());
+    CHECK (! buffer.in_use ());
+
+    v.push_back (2);
+    CHECK (v.inlined ());
+    CHECK (storage.data () == v.data ());
+
+    v.append ({ 3, 4, 5, 6, 7, 8 });
+    CHECK (! v.inlined ());
+    CHECK (! buffer.in_use ());
+  }
+
+  // The buffer follows the elements on move and swap.
+  {
+    gch::external_buffer<T> buffer (storage.data (), 8);
+    gch::external_buffer<T> other_buffer (other_storage.data (), 8);
+
+    gch::buffer_vector<T> v ({ 0, 1, 2 }, buffer);
+    CHECK (storage.data () == v.data ());
+
+    gch::buffer_vector<T> w (std::move (v));
+    CHECK (w.inlined ());
+    CHECK (storage.data () == w.data ());
+    CHECK (&buffer == w.get_allocator ().buffer ());
+
+    // The buffer is still in use, so the moved-from vector allocates.
+    v.push_back (3);
+    CHECK (! v.inlined ());
+
+    gch::buffer_vector<T> x ({ 4, 5 }, other_buffer);
+    x.swap (w);
+    CHECK (&buffer == x.get_allocator ().buffer ());
+    CHECK (&other_buffer == w.get_allocator ().buffer ());
+    CHECK (storage.data () == x.data ());
+    CHECK (other_storage.data () == w.data ());
+
+    x = std::move (w);
+    CHECK (! buffer.in_use ());
+    CHECK (&other_buffer == x.get_allocator ().buffer ());
+    CHECK (other_storage.data () == x.data ());
+    CHECK (gch::buffer_vector<T> { 4, 5 } == x);
+
+    v.clear ();
+    v.shrink_to_fit ();
+  }
+
+  // Copies allocate with the wrapped allocator.
+  {
+    gch::external_buffer<T> buffer (storage.data (), 8);
+    gch::buffer_vector<T> v ({ 0, 1, 2 }, buffer);
+
+    gch::buffer_vector<T> w (v);
+    CHECK (nullptr == w.get_allocator ().buffer ());
+    CHECK (! w.inlined ());
+    CHECK (v == w);
+
+    gch::external_buffer<T> other_buffer (other_storage.data (), 8);
+    gch::buffer_vector<T> x (other_buffer);
+    x = v;
+    CHECK (&other_buffer == x.get_allocator ().buffer ());
+    CHECK (other_storage.data () == x.data ());
+    CHECK (v == x);
+  }
+
+  // Rebound copies keep the buffer, so they compare equal and can free from it.
+  {
+    gch::external_buffer<T> buffer (storage.data (), 8);
+    gch::buffer_allocator<T> alloc (buffer);
+
+    gch::buffer_allocator<char> rebound (alloc);
+    CHECK (nullptr == rebound.buffer ());
+    CHECK (alloc == rebound);
+    CHECK (gch::buffer_allocator<char> () != rebound);
+
+    gch::buffer_allocator<T> copy (rebound);
+    CHECK (&buffer == copy.buffer ());
+    CHECK (alloc == copy);
+
+    T *p = alloc.allocate (4);
+    CHECK (storage.data () == p);
+    copy.deallocate (p, 4);
+    CHECK (! buffer.in_use ());
+  }
+}
+
+#endif
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+  using namespace gch::test_types;
+
+  test_with_type<int> ();
+  test_with_type<non_trivial> ();
+
+  // Allocators without an external buffer never report one.
+  gch::small_vector<int, 0> v { 1, 2, 3 };
+  CHECK (! v.inlined ());
+#endif
+
+  return 0;
+}
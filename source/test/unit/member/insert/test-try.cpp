@@ -0,0 +1,133 @@
+/** test-try.cpp
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+#include "test_allocators.hpp"
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+  using namespace gch::test_types;
+
+  // Insert without reallocation.
+  {
+    gch::small_vector<int, 8> v { 1, 4 };
+    bool ret = v.try_insert (v.begin () + 1, 2);
+    CHECK (ret);
+    CHECK (decltype (v) { 1, 2, 4 } == v);
+
+    ret = v.try_insert (v.begin () + 2, 2, 3);
+    CHECK (ret);
+    CHECK (decltype (v) { 1, 2, 3, 3, 4 } == v);
+
+    ret = v.try_insert (v.end (), { 5, 6 });
+    CHECK (ret);
+    CHECK (decltype (v) { 1, 2, 3, 3, 4, 5, 6 } == v);
+    CHECK_IF_NOT_CONSTEXPR (v.inlined ());
+  }
+
+  // Insert with reallocation.
+  {
+    gch::small_vector<int, 2> v { 1, 4 };
+    bool ret = v.try_insert (v.begin () + 1, 2);
+    CHECK (ret);
+    CHECK (decltype (v) { 1, 2, 4 } == v);
+
+    v.shrink_to_fit ();
+    ret = v.try_insert (v.begin () + 2, 2, 3);
+    CHECK (ret);
+    CHECK (decltype (v) { 1, 2, 3, 3, 4 } == v);
+
+    v.shrink_to_fit ();
+    ret = v.try_insert (v.begin (), { -1, 0 });
+    CHECK (ret);
+    CHECK (decltype (v) { -1, 0, 1, 2, 3, 3, 4 } == v);
+  }
+
+  // The value may refer to an element which is moved during reallocation.
+  {
+    gch::small_vector<nontrivial_data_base, 2> v { 1, 2 };
+    bool ret = v.try_insert (v.begin (), v.back ());
+    CHECK (ret);
+    CHECK (decltype (v) { 2, 1, 2 } == v);
+
+    v.shrink_to_fit ();
+    ret = v.try_insert (v.begin (), 2, v[1]);
+    CHECK (ret);
+    CHECK (decltype (v) { 1, 1, 2, 1, 2 } == v);
+  }
+
+  // Insert from input iterators.
+  {
+    gch::small_vector<int, 2> v { 1, 4 };
+    int a[] = { 2, 3 };
+    using it = single_pass_iterator<int *>;
+    bool ret = v.try_insert (v.begin () + 1, it { std::begin (a) }, it { std::end (a) });
+    CHECK (ret);
+    CHECK (decltype (v) { 1, 2, 3, 4 } == v);
+  }
+
+  // Fail to allocate.
+  {
+    gch::small_vector<int, 4, try_limited_allocator<int, 4>> v { 1, 2, 3, 4 };
+    int a[] = { 5, 6 };
+    using it = single_pass_iterator<int *>;
+
+    bool ret = v.try_insert (v.begin (), 0);
+    CHECK (! ret);
+
+    ret = v.try_insert (v.begin (), 2, 0);
+    CHECK (! ret);
+
+    ret = v.try_insert (v.begin (), std::begin (a), std::end (a));
+    CHECK (! ret);
+
+    ret = v.try_insert (v.begin (), it { std::begin (a) }, it { std::end (a) });
+    CHECK (! ret);
+
+    CHECK (decltype (v) { 1, 2, 3, 4 } == v);
+  }
+
+  // Input ranges are removed if they don't fit.
+  {
+    gch::small_vector<int, 4, try_limited_allocator<int, 8>> v { 1, 2, 3, 4 };
+    int a[] = { 5, 6, 7, 8, 9, 10 };
+    using it = single_pass_iterator<int *>;
+
+    bool ret = v.try_insert (v.begin () + 1, it { std::begin (a) }, it { std::end (a) });
+    CHECK (! ret);
+    CHECK (decltype (v) { 1, 2, 3, 4 } == v);
+  }
+
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+
+  // Fail because of the maximum size.
+  {
+    gch::small_vector_with_allocator<std::int8_t, sized_allocator<std::int8_t, std::uint8_t>> w;
+    w.assign (w.max_size () - 1, 1);
+    auto w_save = w;
+
+    bool ret = w.try_insert (w.begin (), 2, 0);
+    CHECK (! ret);
+    CHECK (w == w_save);
+  }
+
+  // Test strong exception guarantees when the element throws while reallocating.
+  {
+    gch::small_vector<triggering_type, 2, verifying_allocator<triggering_type>> v (2);
+    auto v_save = v;
+
+    exception_trigger::push (0);
+    EXPECT_TEST_EXCEPTION (static_cast<void> (v.try_insert (v.begin (), 2, v.front ())));
+    CHECK (v == v_save);
+  }
+
+#endif
+
+  return 0;
+}
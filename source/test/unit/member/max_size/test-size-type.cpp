@@ -0,0 +1,187 @@
+/** test-size-type.cpp
+ * Copyright © 2022 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+#include "test_allocators.hpp"
+
+template <typename T, typename SizeType, unsigned N>
+using sized_vector = gch::small_vector_with_size_type<T, SizeType, N>;
+
+static_assert (std::is_same<std::uint32_t, sized_vector<int, std::uint32_t, 4>::size_type>::value,
+               "Unexpected size_type.");
+
+static_assert (std::is_same<std::int32_t,
+                            sized_vector<int, std::uint32_t, 4>::difference_type>::value
+               ||  sizeof (std::ptrdiff_t) <= sizeof (std::int32_t),
+               "Unexpected difference_type.");
+
+static_assert (sizeof (sized_vector<int, std::uint32_t, 0>)
+               == sizeof (int *) + 2 * sizeof (std::uint32_t),
+               "Unexpected header size.");
+
+static_assert (sizeof (sized_vector<int, std::uint16_t, 0>)
+               <= sizeof (sized_vector<int, std::uint32_t, 0>),
+               "Unexpected header size.");
+
+// The default inline capacity accounts for the smaller header.
+static_assert (gch::default_buffer_size<std::allocator<int>>::value
+               <= gch::default_buffer_size<std::allocator<int>,
+                                           gch::small_vector_size_options<std::uint32_t>>::value,
+               "Unexpected default buffer size.");
+
+static_assert (sizeof (gch::small_vector_with_size_type<int, std::uint32_t>)
+               <= sizeof (gch::small_vector<int>),
+               "Unexpected size.");
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+  // The maximum size is limited by `difference_type`.
+  {
+    sized_vector<int, std::uint16_t, 4> v;
+    CHECK ((std::numeric_limits<std::int16_t>::max) () == v.max_size ());
+
+    sized_vector<int, std::uint32_t, 4> w;
+    CHECK (static_cast<std::size_t> ((std::numeric_limits<std::int32_t>::max) ())
+       ==  w.max_size ());
+  }
+
+  // The size type may be smaller than that of the allocator, but never larger.
+  {
+    using alloc_type = gch::test_types::sized_allocator<std::int8_t, std::uint16_t>;
+    gch::small_vector<std::int8_t, 4, alloc_type,
+                      gch::small_vector_size_options<std::uint8_t>> v;
+
+    CHECK (127U == v.max_size ());
+
+    while (v.size () < v.max_size ())
+      v.push_back (static_cast<std::int8_t> (v.size ()));
+    CHECK (v.capacity () == v.max_size ());
+    CHECK (126 == v.back ());
+  }
+
+  // The other options are kept.
+  {
+    using options = gch::small_vector_size_options<
+      std::uint16_t,
+      gch::small_vector_size_options<std::uint8_t>>;
+
+    gch::small_vector<int, 2, std::allocator<int>, options> v { 1, 2, 3 };
+    CHECK (std::is_same<std::uint16_t, decltype (v)::size_type>::value);
+    CHECK (3 == v.size ());
+    CHECK (65535U / 2U == v.max_size ());
+  }
+
+  // Operations which would exceed the maximum size throw.
+  {
+    sized_vector<std::int8_t, std::uint8_t, 4> v (127, 1);
+    CHECK (127 == v.size ());
+
+    const auto v_save = v;
+
+    GCH_TRY
+    {
+      EXPECT_THROW (v.push_back (2));
+    }
+    GCH_CATCH (const std::length_error&)
+    { }
+    CHECK (v == v_save);
+
+    GCH_TRY
+    {
+      EXPECT_THROW (v.insert (v.begin (), 1, 2));
+    }
+    GCH_CATCH (const std::length_error&)
+    { }
+    CHECK (v == v_save);
+
+    v.clear ();
+    v.shrink_to_fit ();
+
+    GCH_TRY
+    {
+      EXPECT_THROW (v.reserve (128));
+    }
+    GCH_CATCH (const std::length_error&)
+    { }
+    CHECK (v.empty ());
+
+    GCH_TRY
+    {
+      EXPECT_THROW (v.resize (200));
+    }
+    GCH_CATCH (const std::length_error&)
+    { }
+    CHECK (v.empty ());
+  }
+
+  // Counts which the size type cannot represent throw instead of being truncated.
+  {
+    using vector_type = sized_vector<int, std::uint16_t, 4>;
+    static_assert (std::is_same<std::size_t, vector_type::count_type>::value,
+                   "Counts should be given as the size type of the allocator.");
+
+    vector_type v { 1, 2, 3 };
+    const auto v_save = v;
+
+    // 70000 is 4464 modulo 2^16.
+    GCH_TRY
+    {
+      EXPECT_THROW (v.reserve (70000));
+    }
+    GCH_CATCH (const std::length_error&)
+    { }
+    CHECK (v == v_save);
+    CHECK (v.capacity () < 4464);
+
+    GCH_TRY
+    {
+      EXPECT_THROW (v.resize (70000));
+    }
+    GCH_CATCH (const std::length_error&)
+    { }
+    CHECK (v == v_save);
+
+    GCH_TRY
+    {
+      EXPECT_THROW (v.resize (70000, 7));
+    }
+    GCH_CATCH (const std::length_error&)
+    { }
+    CHECK (v == v_save);
+
+    GCH_TRY
+    {
+      EXPECT_THROW (v.assign (70000, 7));
+    }
+    GCH_CATCH (const std::length_error&)
+    { }
+    CHECK (v == v_save);
+
+    GCH_TRY
+    {
+      EXPECT_THROW (v.insert (v.begin (), 70000, 7));
+    }
+    GCH_CATCH (const std::length_error&)
+    { }
+    CHECK (v == v_save);
+
+    GCH_TRY
+    {
+      EXPECT_THROW (vector_type (70000));
+    }
+    GCH_CATCH (const std::length_error&)
+    { }
+
+    CHECK (! v.try_reserve (70000));
+    CHECK (! v.try_resize (70000));
+    CHECK (v == v_save);
+  }
+
+  return 0;
+}
@@ -0,0 +1,237 @@
+/** test.cpp
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+#include "test_allocators.hpp"
+
+using compact_options = gch::small_vector_layout_options<gch::small_vector_layout::compact>;
+
+// Destroys the elements of a released allocation and deallocates it.
+template <typename Allocation>
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+void
+dispose (Allocation& a)
+{
+  using alloc_traits = std::allocator_traits<decltype (a.allocator)>;
+
+  if (a.ptr == nullptr)
+    return;
+
+  for (auto p = a.ptr; p != a.ptr + a.size; ++p)
+    alloc_traits::destroy (a.allocator, gch::test_types::to_address (p));
+  alloc_traits::deallocate (a.allocator, a.ptr, a.capacity);
+}
+
+template <typename T, typename Allocator = std::allocator<T>, typename Options = void>
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test_with_type (void)
+{
+  using vector_type = typename std::conditional<
+    std::is_void<Options>::value,
+    gch::small_vector<T, 2, Allocator>,
+    gch::small_vector<T, 2, Allocator, Options>>::type;
+
+  // An allocation is handed over as is.
+  {
+    vector_type v { 1, 2, 3, 4, 5 };
+    const T *data = v.data ();
+    const auto capacity = v.capacity ();
+
+    auto a = v.release ();
+    CHECK (data == a.ptr);
+    CHECK (5 == a.size);
+    CHECK (capacity == a.capacity);
+    CHECK (v.empty ());
+    CHECK_IF_NOT_CONSTEXPR (v.inlined ());
+    CHECK (2 == v.capacity ());
+
+    CHECK (1 == a.ptr[0]);
+    CHECK (5 == a.ptr[4]);
+
+    // The vector is usable afterward.
+    v.assign ({ 7, 8, 9 });
+    CHECK (vector_type { 7, 8, 9 } == v);
+
+    dispose (a);
+  }
+
+  // Inlined elements are moved to an allocation of exactly their size.
+  {
+    vector_type v { 1, 2 };
+    auto a = v.release ();
+    CHECK (nullptr != a.ptr);
+    CHECK (2 == a.size);
+    CHECK_IF_NOT_CONSTEXPR (2 == a.capacity);
+    CHECK (v.empty ());
+    CHECK_IF_NOT_CONSTEXPR (v.inlined ());
+
+    CHECK (1 == a.ptr[0]);
+    CHECK (2 == a.ptr[1]);
+
+    dispose (a);
+  }
+
+  // Nothing is allocated for an empty vector.
+  {
+    vector_type v;
+    auto a = v.release ();
+    CHECK_IF_NOT_CONSTEXPR (nullptr == a.ptr);
+    CHECK (0 == a.size);
+    CHECK_IF_NOT_CONSTEXPR (0 == a.capacity);
+    dispose (a);
+  }
+
+  // A released allocation can be adopted without copying.
+  {
+    vector_type v { 1, 2, 3, 4, 5 };
+    v.reserve (8);
+    const T *data = v.data ();
+
+    auto a = v.release ();
+    vector_type w (gch::adopt_allocation, a.ptr, a.size, a.capacity, a.allocator);
+    CHECK (! w.inlined ());
+    CHECK (data == w.data ());
+    CHECK (a.capacity == w.capacity ());
+    CHECK (vector_type { 1, 2, 3, 4, 5 } == w);
+
+    // It is then managed like any other allocation.
+    w.append ({ 6, 7, 8, 9 });
+    CHECK (vector_type { 1, 2, 3, 4, 5, 6, 7, 8, 9 } == w);
+  }
+
+  // Allocations which would fit in the inline storage are moved there and deallocated.
+  {
+    vector_type v { 1, 2 };
+    auto a = v.release ();
+    vector_type w (gch::adopt_allocation, a.ptr, a.size, a.capacity, a.allocator);
+    CHECK_IF_NOT_CONSTEXPR (w.inlined ());
+    CHECK (2 == w.capacity ());
+    CHECK (vector_type { 1, 2 } == w);
+  }
+
+  // An empty allocation may be adopted.
+  {
+    vector_type v;
+    auto a = v.release ();
+    vector_type w (gch::adopt_allocation, a.ptr, a.size, a.capacity, a.allocator);
+    CHECK (w.empty ());
+    CHECK_IF_NOT_CONSTEXPR (w.inlined ());
+  }
+
+  // Allocations may move between vectors with different inline capacities.
+  {
+    using other_vector_type = gch::small_vector<T, 4, Allocator>;
+    vector_type v { 1, 2, 3 };
+    auto a = v.release ();
+    other_vector_type w (gch::adopt_allocation, a.ptr, a.size, a.capacity, a.allocator);
+    CHECK_IF_NOT_CONSTEXPR (w.inlined ());
+    CHECK (other_vector_type { 1, 2, 3 } == w);
+
+    w.append ({ 4, 5, 6 });
+    a = w.release ();
+    vector_type x (gch::adopt_allocation, a.ptr, a.size, a.capacity, a.allocator);
+    CHECK (! x.inlined ());
+    CHECK (vector_type { 1, 2, 3, 4, 5, 6 } == x);
+  }
+
+  return 0;
+}
+
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+
+// Allocations of `std::allocator` may be handed to owners which deallocate with `operator delete`.
+static
+void
+test_unique_ptr_handoff (void)
+{
+  struct allocator_deleter
+  {
+    void
+    operator() (int *p) const noexcept
+    {
+      std::allocator<int> ().deallocate (p, capacity);
+    }
+
+    std::size_t capacity;
+  };
+
+  gch::small_vector<int, 2> v { 1, 2, 3, 4 };
+  const int *data = v.data ();
+
+  auto a = v.release ();
+  std::unique_ptr<int[], allocator_deleter> p (a.ptr, allocator_deleter { a.capacity });
+  CHECK (data == p.get ());
+  CHECK (4 == p[3]);
+
+  auto q = p.release ();
+  gch::small_vector<int, 2> w (gch::adopt_allocation, q, 4, a.capacity);
+  CHECK (data == w.data ());
+  CHECK (gch::small_vector<int, 2> { 1, 2, 3, 4 } == w);
+}
+
+#ifdef GCH_EXCEPTIONS
+
+// If moving the elements into the inline storage fails, the caller keeps the allocation.
+static
+void
+test_adopt_exception (void)
+{
+  using namespace gch::test_types;
+
+  using vector_type = gch::small_vector<triggering_type, 4>;
+
+  std::allocator<triggering_type> alloc;
+  for (std::size_t n = 0; ; ++n)
+  {
+    triggering_type *p = alloc.allocate (3);
+    for (int i = 0; i < 3; ++i)
+      ::new (p + i) triggering_type (i);
+
+    exception_trigger::push (n);
+    GCH_TRY
+    {
+      vector_type v (gch::adopt_allocation, p, 3, 3);
+      exception_trigger::reset ();
+      CHECK (vector_type { 0, 1, 2 } == v);
+      break;
+    }
+    GCH_CATCH (const test_exception&)
+    {
+      for (int i = 0; i < 3; ++i)
+        p[i].~triggering_type ();
+      alloc.deallocate (p, 3);
+    }
+  }
+}
+
+#endif
+
+#endif
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+  using namespace gch::test_types;
+
+  CHECK (0 == test_with_type<int> ());
+  CHECK (0 == test_with_type<non_trivial> ());
+  CHECK (0 == test_with_type<int, sized_allocator<int, std::uint8_t>> ());
+  CHECK (0 == test_with_type<int, std::allocator<int>, compact_options> ());
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+  CHECK (0 == test_with_type<non_trivial, verifying_allocator<non_trivial>> ());
+  CHECK (0 == test_with_type<non_trivial, std::allocator<non_trivial>, compact_options> ());
+
+  test_unique_ptr_handoff ();
+#ifdef GCH_EXCEPTIONS
+  test_adopt_exception ();
+#endif
+#endif
+
+  return 0;
+}
@@ -0,0 +1,134 @@
+/** test-exception-guarantee.cpp
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+#include "test_allocators.hpp"
+
+// Records whether it was copied. Its move constructor may throw, so it is copied when relocated
+// with the strong exception guarantee. Copying or moving a negative value throws, so that the
+// compiler cannot tell that the constructors never throw.
+template <int Tag>
+struct copy_recorder
+{
+  copy_recorder            (void)                     = default;
+  copy_recorder& operator= (const copy_recorder&)     = default;
+  copy_recorder& operator= (copy_recorder&&) noexcept = default;
+  ~copy_recorder           (void)                     = default;
+
+  GCH_SMALL_VECTOR_TEST_CONSTEXPR
+  copy_recorder (int i) noexcept
+    : data (i)
+  { }
+
+  GCH_SMALL_VECTOR_TEST_CONSTEXPR
+  copy_recorder (const copy_recorder& other)
+    : data (check (other.data)),
+      copied (true)
+  { }
+
+  GCH_SMALL_VECTOR_TEST_CONSTEXPR
+  copy_recorder (copy_recorder&& other) noexcept (false)
+    : data (check (other.data))
+  { }
+
+  static GCH_SMALL_VECTOR_TEST_CONSTEXPR
+  int
+  check (int i)
+  {
+#ifdef GCH_EXCEPTIONS
+    if (i < 0)
+      throw gch::test_types::test_exception { };
+#endif
+    return i;
+  }
+
+  int  data   = 0;
+  bool copied = false;
+};
+
+using strong_recorder  = copy_recorder<0>;
+using relaxed_recorder = copy_recorder<1>;
+
+namespace gch
+{
+
+  template <>
+  struct always_relocate_with_move<relaxed_recorder>
+    : std::true_type
+  { };
+
+}
+
+template <typename T, typename Options = gch::small_vector_default_options>
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+bool
+is_copied_on_reallocation (void)
+{
+  gch::small_vector<T, 2, std::allocator<T>, Options> v;
+  v.emplace_back (1);
+  v.emplace_back (2);
+  CHECK (! v[0].copied);
+
+  v.reserve (8);
+  CHECK (! v.inlined ());
+  CHECK (1 == v[0].data);
+  CHECK (2 == v[1].data);
+  CHECK (v[0].copied == v[1].copied);
+
+  // Reallocate from a heap allocation as well.
+  v[0].copied = false;
+  v[1].copied = false;
+  v.reserve (32);
+  CHECK (1 == v[0].data);
+  CHECK (2 == v[1].data);
+  CHECK (v[0].copied == v[1].copied);
+
+  return v[0].copied;
+}
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+  using basic_options = gch::small_vector_exception_guarantee_options<
+    gch::small_vector_exception_guarantee::basic>;
+
+  // Elements with throwing move constructors are copied by default.
+  CHECK (is_copied_on_reallocation<strong_recorder> ());
+
+  // They are moved if the container uses the basic guarantee...
+  CHECK (! (is_copied_on_reallocation<strong_recorder, basic_options> ()));
+
+  // ...or if the type opts in.
+  CHECK (! is_copied_on_reallocation<relaxed_recorder> ());
+
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+#ifdef GCH_SMALL_VECTOR_TEST_EXCEPTION_SAFETY_TESTING
+
+  // With the basic guarantee, the vector is left valid if a move constructor throws.
+  {
+    using namespace gch::test_types;
+
+    using alloc_type = verifying_allocator<triggering_move_ctor>;
+    gch::small_vector<triggering_move_ctor, 2, alloc_type, basic_options> v;
+    v.emplace_back (1);
+    v.emplace_back (2);
+
+    exception_trigger::push (1);
+    EXPECT_TEST_EXCEPTION (v.reserve (8));
+    CHECK (2 == v.size ());
+
+    v.clear ();
+    v.emplace_back (3);
+    CHECK (3 == v[0]);
+  }
+
+#endif
+#endif
+
+  return 0;
+}
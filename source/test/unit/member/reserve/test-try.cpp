@@ -0,0 +1,84 @@
+/** test-try.cpp
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+#include "test_allocators.hpp"
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+  using namespace gch::test_types;
+
+  // Reserving within the capacity is a no-op.
+  {
+    gch::small_vector<int, 4> v { 1, 2 };
+    bool ret = v.try_reserve (4);
+    CHECK (ret);
+    CHECK (decltype (v) { 1, 2 } == v);
+    CHECK_IF_NOT_CONSTEXPR (v.inlined ());
+  }
+
+  // Reserving past the capacity reallocates.
+  {
+    gch::small_vector<int, 4> v { 1, 2 };
+    bool ret = v.try_reserve (8);
+    CHECK (ret);
+    CHECK (8 <= v.capacity ());
+    CHECK (decltype (v) { 1, 2 } == v);
+    CHECK (! v.inlined ());
+  }
+
+  // Reserving past the maximum size fails.
+  {
+    gch::small_vector<int, 4> v { 1, 2 };
+    bool ret = v.try_reserve (v.max_size () + 1);
+    CHECK (! ret);
+    CHECK (decltype (v) { 1, 2 } == v);
+    CHECK_IF_NOT_CONSTEXPR (v.inlined ());
+  }
+
+  // The allocator may report failure through `try_allocate_at_least`.
+  {
+    gch::small_vector<int, 2, try_limited_allocator<int, 8>> v { 1, 2 };
+    bool ret = v.try_reserve (16);
+    CHECK (! ret);
+    CHECK (2 == v.capacity ());
+    CHECK (decltype (v) { 1, 2 } == v);
+
+    ret = v.try_reserve (8);
+    CHECK (ret);
+    CHECK (8 == v.capacity ());
+    CHECK (decltype (v) { 1, 2 } == v);
+  }
+
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+
+#ifdef GCH_EXCEPTIONS
+  // Otherwise, a `std::bad_alloc` thrown by the allocator is caught.
+  {
+    gch::small_vector<int, 2, limited_allocator<int, 8>> v { 1, 2 };
+    bool ret = v.try_reserve (16);
+    CHECK (! ret);
+    CHECK (decltype (v) { 1, 2 } == v);
+  }
+#endif
+
+  // Test strong exception guarantees when relocating.
+  {
+    gch::small_vector<triggering_type, 2, verifying_allocator<triggering_type>> v (2);
+    auto v_save = v;
+
+    exception_trigger::push (1);
+    EXPECT_TEST_EXCEPTION (static_cast<void> (v.try_reserve (4)));
+    CHECK (v == v_save);
+  }
+
+#endif
+
+  return 0;
+}
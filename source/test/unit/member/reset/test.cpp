@@ -0,0 +1,70 @@
+/** test.cpp
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+#include "test_allocators.hpp"
+
+template <typename T, typename Allocator = std::allocator<T>>
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test_with_type (void)
+{
+  using vector_type = gch::small_vector<T, 2, Allocator>;
+
+  vector_type v;
+  v.reset ();
+  CHECK (v.empty ());
+  CHECK_IF_NOT_CONSTEXPR (v.inlined ());
+  CHECK (2 == v.capacity ());
+
+  v.assign ({ 1, 2 });
+  v.reset ();
+  CHECK (v.empty ());
+  CHECK_IF_NOT_CONSTEXPR (v.inlined ());
+  CHECK (2 == v.capacity ());
+
+  // Unlike `clear`, the allocation is released.
+  v.assign ({ 1, 2, 3, 4, 5 });
+  CHECK (! v.inlined ());
+  v.clear ();
+  CHECK (5 <= v.capacity ());
+
+  v.assign ({ 1, 2, 3, 4, 5 });
+  v.reset ();
+  CHECK (v.empty ());
+  CHECK_IF_NOT_CONSTEXPR (v.inlined ());
+  CHECK (2 == v.capacity ());
+
+  // The vector is usable afterward.
+  v.push_back (7);
+  v.push_back (8);
+  v.push_back (9);
+  CHECK (vector_type { 7, 8, 9 } == v);
+
+  gch::small_vector<T, 0, Allocator> w { 1, 2, 3 };
+  w.reset ();
+  CHECK (w.empty ());
+  CHECK (0 == w.capacity ());
+
+  return 0;
+}
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+  using namespace gch::test_types;
+
+  CHECK (0 == test_with_type<int> ());
+  CHECK (0 == test_with_type<non_trivial> ());
+  CHECK (0 == test_with_type<int, sized_allocator<int, std::uint8_t>> ());
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+  CHECK (0 == test_with_type<non_trivial, verifying_allocator<non_trivial>> ());
+#endif
+
+  return 0;
+}
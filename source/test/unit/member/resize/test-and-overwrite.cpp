@@ -0,0 +1,176 @@
+/** test-and-overwrite.cpp
+ * Copyright © 2022 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+#include "test_allocators.hpp"
+
+struct iota_writer
+{
+  template <typename Pointer, typename SizeType>
+  GCH_SMALL_VECTOR_TEST_CONSTEXPR
+  SizeType
+  operator() (Pointer p, SizeType n) const
+  {
+    for (SizeType i = 0; i < n; ++i)
+      p[i] = static_cast<int> (i) + first;
+    return n < result ? n : result;
+  }
+
+  int         first;
+  std::size_t result;
+};
+
+// Claims to have written more elements than it was given.
+struct greedy_writer
+{
+  template <typename Pointer, typename SizeType>
+  SizeType
+  operator() (Pointer, SizeType n) const
+  {
+    return n + 1;
+  }
+};
+
+struct empty_writer
+{
+  template <typename Pointer, typename SizeType>
+  GCH_SMALL_VECTOR_TEST_CONSTEXPR
+  SizeType
+  operator() (Pointer, SizeType) const
+  {
+    return 0;
+  }
+};
+
+#ifdef GCH_SMALL_VECTOR_TEST_EXCEPTION_SAFETY_TESTING
+
+struct throwing_writer
+{
+  template <typename Pointer, typename SizeType>
+  SizeType
+  operator() (Pointer, SizeType) const
+  {
+    throw gch::test_types::test_exception ();
+  }
+};
+
+#endif
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+  // Cases:
+  //   capacity < count => reallocate.              (1)
+  //   size < count     => append to uninitialized. (2)
+  //   count <= size    => overwrite existing.      (3)
+
+  using namespace gch::test_types;
+
+  // (1)
+  {
+    gch::small_vector<int, 4> v { 1, 2 };
+    v.resize_and_overwrite (8, iota_writer { 10, 6 });
+    CHECK (decltype (v) { 10, 11, 12, 13, 14, 15 } == v);
+    CHECK (! v.inlined ());
+
+    // The capacity is exactly the requested size, not the size given by the growth policy.
+    CHECK (8 == v.capacity ());
+
+    v.resize_and_overwrite (9, iota_writer { 10, 9 });
+    CHECK (9 == v.capacity ());
+  }
+
+  // (2)
+  {
+    gch::small_vector<int, 4> v { 1 };
+    v.resize_and_overwrite (4, iota_writer { 10, 2 });
+    CHECK (decltype (v) { 10, 11 } == v);
+    CHECK_IF_NOT_CONSTEXPR (v.inlined ());
+
+    // Keep all of them.
+    v.resize_and_overwrite (4, iota_writer { 20, 4 });
+    CHECK (decltype (v) { 20, 21, 22, 23 } == v);
+
+    // Keep none of them.
+    v.resize_and_overwrite (4, empty_writer { });
+    CHECK (v.empty ());
+  }
+
+  // (3)
+  {
+    gch::small_vector<int, 0> v { 1, 2, 3, 4, 5 };
+    v.resize_and_overwrite (3, iota_writer { 10, 3 });
+    CHECK (decltype (v) { 10, 11, 12 } == v);
+
+    v.resize_and_overwrite (3, iota_writer { 10, 1 });
+    CHECK (decltype (v) { 10 } == v);
+  }
+
+  // Non-trivial types are default-constructed before they are overwritten.
+  {
+    gch::small_vector<non_trivial, 2> v { 1 };
+    v.resize_and_overwrite (
+      3,
+      [](non_trivial *p, std::size_t n) -> std::size_t {
+        for (std::size_t i = 0; i < n; ++i)
+          if (p[i] == non_trivial { 7 })
+            p[i] = non_trivial { 8 };
+        return n;
+      });
+    CHECK (decltype (v) { 1, 8, 8 } == v);
+  }
+
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+
+#ifdef GCH_SMALL_VECTOR_TEST_EXCEPTION_SAFETY_TESTING
+  // The elements added for `op` are removed if it throws.
+  {
+    gch::small_vector<int, 2, verifying_allocator<int>> v { 1, 2, 3 };
+    auto v_save = v;
+
+    EXPECT_TEST_EXCEPTION (v.resize_and_overwrite (6, throwing_writer { }));
+    CHECK (v == v_save);
+  }
+#endif
+
+  // Keeping more elements than `op` was given is an error, and the new elements are removed.
+  {
+    gch::small_vector<int, 2> v { 1, 2, 3 };
+    auto v_save = v;
+
+    GCH_TRY
+    {
+      EXPECT_THROW (v.resize_and_overwrite (6, greedy_writer { }));
+    }
+    GCH_CATCH (const std::length_error&)
+    { }
+
+    CHECK (v == v_save);
+  }
+
+  // Test strong exception guarantees when allocating over the maximum size.
+  {
+    gch::small_vector_with_allocator<std::int8_t, sized_allocator<std::int8_t, std::uint8_t>> w;
+    w.assign (w.max_size (), 1);
+
+    auto w_save = w;
+
+    GCH_TRY
+    {
+      EXPECT_THROW (w.resize_and_overwrite (w.max_size () + 1, empty_writer { }));
+    }
+    GCH_CATCH (const std::length_error&)
+    { }
+
+    CHECK (w == w_save);
+  }
+
+#endif
+
+  return 0;
+}
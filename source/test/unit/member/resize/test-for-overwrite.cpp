@@ -0,0 +1,114 @@
+/** test-for-overwrite.cpp
+ * Copyright © 2022 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+#include "test_allocators.hpp"
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+  // Cases:
+  //   0 == new_size       => erase all elements.      (1)
+  //   capacity < new_size => reallocate.              (2)
+  //   size < new_size     => append to uninitialized. (3)
+  //   size <= new_size    => erase to end.            (4)
+
+  using namespace gch::test_types;
+
+  // (1)
+  {
+    gch::small_vector<int, 4> v { 1, 2, 3 };
+    v.resize_for_overwrite (0);
+    CHECK (0 == v.size ());
+  }
+
+  // (2)
+  {
+    gch::small_vector<int, 4> v { 1, 2, 3 };
+    CHECK_IF_NOT_CONSTEXPR (v.inlined ());
+
+    v.resize_for_overwrite (6);
+    CHECK (6 == v.size ());
+    CHECK (! v.inlined ());
+
+    v[3] = 4;
+    v[4] = 5;
+    v[5] = 6;
+    CHECK (decltype (v) { 1, 2, 3, 4, 5, 6 } == v);
+  }
+
+  // (3)
+  {
+    gch::small_vector<int, 4> v { 1, 2 };
+    v.resize_for_overwrite (4);
+    CHECK (4 == v.size ());
+    CHECK_IF_NOT_CONSTEXPR (v.inlined ());
+
+    v[2] = 3;
+    v[3] = 4;
+    CHECK (decltype (v) { 1, 2, 3, 4 } == v);
+  }
+
+  // (4)
+  {
+    gch::small_vector<int, 0> v { 1, 2, 3, 4 };
+    v.resize_for_overwrite (2);
+    CHECK (decltype (v) { 1, 2 } == v);
+  }
+
+  // Non-trivial types are still default-constructed.
+  {
+    gch::small_vector<non_trivial, 2> v { 1 };
+    v.resize_for_overwrite (3);
+    CHECK (decltype (v) { 1, 7, 7 } == v);
+  }
+
+  // Construction.
+  {
+    gch::small_vector<int, 4> v (3, gch::for_overwrite);
+    CHECK (3 == v.size ());
+    CHECK_IF_NOT_CONSTEXPR (v.inlined ());
+
+    gch::small_vector<int, 4> w (5, gch::for_overwrite);
+    CHECK (5 == w.size ());
+    CHECK (! w.inlined ());
+
+    for (int i = 0; i < 5; ++i)
+      w[static_cast<std::size_t> (i)] = i;
+    CHECK (decltype (w) { 0, 1, 2, 3, 4 } == w);
+
+    gch::small_vector<non_trivial, 4> x (2, gch::for_overwrite, std::allocator<non_trivial> ());
+    CHECK (decltype (x) { 7, 7 } == x);
+  }
+
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+
+  // The allocator is used to construct the elements if it defines `construct`.
+  {
+    gch::small_vector<int, 2, verifying_allocator<int>> v { 1 };
+    v.resize_for_overwrite (4);
+    CHECK (decltype (v) { 1, 0, 0, 0 } == v);
+
+    gch::small_vector<int, 2, verifying_allocator<int>> w (3, gch::for_overwrite);
+    CHECK (decltype (w) { 0, 0, 0 } == w);
+  }
+
+  // Test strong exception guarantees when a default constructor throws during reallocation.
+  {
+    gch::small_vector<triggering_type, 2, verifying_allocator<triggering_type>> v (2);
+    auto v_save = v;
+
+    exception_trigger::push (1);
+    EXPECT_TEST_EXCEPTION (v.resize_for_overwrite (4));
+    CHECK (v == v_save);
+  }
+
+#endif
+
+  return 0;
+}
@@ -0,0 +1,80 @@
+/** test-try.cpp
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+#include "test_allocators.hpp"
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+  using namespace gch::test_types;
+
+  // Resize without and with reallocation.
+  {
+    gch::small_vector<int, 4> v { 1 };
+    bool ret = v.try_resize (3);
+    CHECK (ret);
+    CHECK (decltype (v) { 1, 0, 0 } == v);
+
+    ret = v.try_resize (5, 2);
+    CHECK (ret);
+    CHECK (decltype (v) { 1, 0, 0, 2, 2 } == v);
+    CHECK (! v.inlined ());
+
+    ret = v.try_resize (1);
+    CHECK (ret);
+    CHECK (decltype (v) { 1 } == v);
+  }
+
+  // The value may refer to an element which is moved during reallocation.
+  {
+    gch::small_vector<nontrivial_data_base, 2> v { 1, 2 };
+    bool ret = v.try_resize (4, v.back ());
+    CHECK (ret);
+    CHECK (decltype (v) { 1, 2, 2, 2 } == v);
+  }
+
+  // Fail to allocate.
+  {
+    gch::small_vector<int, 4, try_limited_allocator<int, 8>> v { 1, 2 };
+    bool ret = v.try_resize (9);
+    CHECK (! ret);
+    CHECK (decltype (v) { 1, 2 } == v);
+
+    ret = v.try_resize (9, 3);
+    CHECK (! ret);
+    CHECK (decltype (v) { 1, 2 } == v);
+  }
+
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+
+  // Fail because of the maximum size.
+  {
+    gch::small_vector_with_allocator<std::int8_t, sized_allocator<std::int8_t, std::uint8_t>> w;
+    w.assign (10, 1);
+    auto w_save = w;
+
+    bool ret = w.try_resize (w.max_size () + 1u);
+    CHECK (! ret);
+    CHECK (w == w_save);
+  }
+
+  // Test strong exception guarantees when the element throws while reallocating.
+  {
+    gch::small_vector<triggering_type, 2, verifying_allocator<triggering_type>> v (2);
+    auto v_save = v;
+
+    exception_trigger::push (1);
+    EXPECT_TEST_EXCEPTION (static_cast<void> (v.try_resize (4)));
+    CHECK (v == v_save);
+  }
+
+#endif
+
+  return 0;
+}
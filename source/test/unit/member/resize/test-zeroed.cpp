@@ -0,0 +1,244 @@
+/** test-zeroed.cpp
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+#include "test_allocators.hpp"
+
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+
+#include "gch/usable_size_allocator.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+#ifndef _WIN32
+#  include "gch/mmap_allocator.hpp"
+#endif
+
+static std::size_t num_zeroed_allocations = 0;
+
+// Allocates zeroed memory with `std::calloc` and counts the number of zeroed allocations. Other
+// allocations are filled with garbage.
+template <typename T>
+struct zeroing_allocator
+{
+  using value_type = T;
+
+  zeroing_allocator (void) = default;
+
+  template <typename U>
+  constexpr
+  zeroing_allocator (const zeroing_allocator<U>&) noexcept
+  { }
+
+  T *
+  allocate (std::size_t n)
+  {
+    void *p = check (std::malloc (n * sizeof (T)));
+    std::memset (p, 0xAB, n * sizeof (T));
+    return static_cast<T *> (p);
+  }
+
+  T *
+  allocate_zeroed (std::size_t n)
+  {
+    ++num_zeroed_allocations;
+    return static_cast<T *> (check (std::calloc (n, sizeof (T))));
+  }
+
+  void
+  deallocate (T *p, std::size_t) noexcept
+  {
+    std::free (p);
+  }
+
+  static
+  void *
+  check (void *p)
+  {
+    if (p == nullptr)
+    {
+#ifdef GCH_EXCEPTIONS
+      throw std::bad_alloc ();
+#else
+      std::abort ();
+#endif
+    }
+    return p;
+  }
+};
+
+template <typename T, typename U>
+constexpr
+bool
+operator== (const zeroing_allocator<T>&, const zeroing_allocator<U>&) noexcept
+{
+  return true;
+}
+
+template <typename T, typename U>
+constexpr
+bool
+operator!= (const zeroing_allocator<T>&, const zeroing_allocator<U>&) noexcept
+{
+  return false;
+}
+
+template <typename T, unsigned N = 4>
+using zeroing_vector = gch::small_vector<T, N, zeroing_allocator<T>>;
+
+template <typename Vector>
+bool
+is_zero (const Vector& v, std::size_t first = 0)
+{
+  for (std::size_t i = first; i < v.size (); ++i)
+  {
+    if (v[i] != typename Vector::value_type ())
+      return false;
+  }
+  return true;
+}
+
+enum class color
+{
+  red,
+  green,
+};
+
+#endif
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+  using namespace gch::test_types;
+
+  // Construction.
+  {
+    num_zeroed_allocations = 0;
+
+    zeroing_vector<int> v (1000);
+    CHECK (1 == num_zeroed_allocations);
+    CHECK (1000 == v.size ());
+    CHECK (is_zero (v));
+
+    zeroing_vector<double> w (1000);
+    CHECK (2 == num_zeroed_allocations);
+    CHECK (is_zero (w));
+
+    zeroing_vector<int *> x (1000);
+    CHECK (3 == num_zeroed_allocations);
+    CHECK (is_zero (x));
+
+    zeroing_vector<color> y (1000);
+    CHECK (4 == num_zeroed_allocations);
+    CHECK (is_zero (y));
+
+    // Inline elements are value-initialized as usual.
+    zeroing_vector<int> z (3);
+    CHECK (4 == num_zeroed_allocations);
+    CHECK (z.inlined ());
+    CHECK (is_zero (z));
+  }
+
+  // Resizing.
+  {
+    num_zeroed_allocations = 0;
+
+    zeroing_vector<int> v { 1, 2, 3 };
+    v.resize (1000);
+    CHECK (1 == num_zeroed_allocations);
+    CHECK (1000 == v.size ());
+    CHECK (1 == v[0]);
+    CHECK (2 == v[1]);
+    CHECK (3 == v[2]);
+    CHECK (is_zero (v, 3));
+
+    // The existing allocation is not zeroed, so the new elements are constructed.
+    v.resize (10);
+    v.resize (v.capacity ());
+    CHECK (1 == num_zeroed_allocations);
+    CHECK (is_zero (v, 3));
+
+    v.resize (v.capacity () + 1);
+    CHECK (2 == num_zeroed_allocations);
+    CHECK (1 == v[0]);
+    CHECK (is_zero (v, 3));
+  }
+
+  // Only value-initialization uses zeroed memory.
+  {
+    num_zeroed_allocations = 0;
+
+    zeroing_vector<int> v;
+    v.resize (1000, 7);
+    CHECK (0 == num_zeroed_allocations);
+    CHECK (7 == v.back ());
+
+    zeroing_vector<int> w (1000, 7);
+    CHECK (0 == num_zeroed_allocations);
+    CHECK (7 == w.back ());
+  }
+
+  // Types which are not zero-initializable are constructed.
+  {
+    num_zeroed_allocations = 0;
+
+    zeroing_vector<non_trivial> v (10);
+    CHECK (0 == num_zeroed_allocations);
+    CHECK (10 == v.size ());
+
+    v.resize (100);
+    CHECK (0 == num_zeroed_allocations);
+    CHECK (100 == v.size ());
+  }
+
+  // The header of the allocation is written over the zeroed memory.
+  {
+    using header_options =
+      gch::small_vector_layout_options<gch::small_vector_layout::heap_header>;
+    num_zeroed_allocations = 0;
+
+    gch::small_vector<int, 0, zeroing_allocator<int>, header_options> v (1000);
+    CHECK (1 == num_zeroed_allocations);
+    CHECK (1000 == v.size ());
+    CHECK (1000 <= v.capacity ());
+    CHECK (is_zero (v));
+
+    v.resize (2000);
+    CHECK (2 == num_zeroed_allocations);
+    CHECK (2000 == v.size ());
+    CHECK (is_zero (v));
+  }
+
+  {
+    gch::small_vector<int, 4, gch::usable_size_allocator<int>> v (1000);
+    CHECK (is_zero (v));
+
+    v.resize (2000);
+    CHECK (2000 == v.size ());
+    CHECK (is_zero (v));
+  }
+
+#ifndef _WIN32
+  {
+    gch::small_vector<int, 0, gch::mmap_allocator<int>> v (100000);
+    CHECK (100000 == v.size ());
+    CHECK (is_zero (v));
+
+    gch::small_vector<int, 0, gch::mmap_allocator<int>> w;
+    w.resize (100000);
+    CHECK (100000 == w.size ());
+    CHECK (is_zero (w));
+  }
+#endif
+
+#endif
+
+  return 0;
+}
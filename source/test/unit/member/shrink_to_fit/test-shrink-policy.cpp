@@ -0,0 +1,180 @@
+/** test-shrink-policy.cpp
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+#include "test_allocators.hpp"
+
+template <typename Policy, typename BaseOptions = gch::small_vector_default_options>
+using shrink_options = gch::small_vector_shrink_options<Policy, BaseOptions>;
+
+template <typename T, unsigned N, typename Allocator = std::allocator<T>,
+          typename Policy = gch::small_vector_shrink::hysteresis<>>
+using shrinking_vector = gch::small_vector<T, N, Allocator, shrink_options<Policy>>;
+
+static_assert (
+  4 == gch::small_vector_shrink::never::calculate_shrunk_capacity<int> (0U, 4U), "");
+
+static_assert (
+  16 == gch::small_vector_shrink::hysteresis<>::calculate_shrunk_capacity<int> (4U, 16U), "");
+
+static_assert (
+  6 == gch::small_vector_shrink::hysteresis<>::calculate_shrunk_capacity<int> (3U, 16U), "");
+
+static_assert (
+  3 == gch::small_vector_shrink::hysteresis<8, 1>::calculate_shrunk_capacity<int> (3U, 32U), "");
+
+template <typename T, typename Allocator = std::allocator<T>>
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test_with_type (void)
+{
+  // pop_back
+  {
+    shrinking_vector<T, 2, Allocator> v;
+    for (int i = 0; i < 16; ++i)
+      v.push_back (i);
+    CHECK (16 == v.capacity ());
+
+    while (4 < v.size ())
+      v.pop_back ();
+    CHECK (16 == v.capacity ());
+
+    v.pop_back ();
+    CHECK (6 == v.capacity ());
+    CHECK (shrinking_vector<T, 2, Allocator> { 0, 1, 2 } == v);
+
+    v.pop_back ();
+    v.pop_back ();
+    CHECK (6 == v.capacity ());
+    CHECK (shrinking_vector<T, 2, Allocator> { 0 } == v);
+
+    // Move back to the inline storage.
+    v.pop_back ();
+    CHECK (2 == v.capacity ());
+    CHECK_IF_NOT_CONSTEXPR (v.inlined ());
+    CHECK (v.empty ());
+  }
+
+  // erase
+  {
+    shrinking_vector<T, 2, Allocator> v;
+    for (int i = 0; i < 16; ++i)
+      v.push_back (i);
+
+    auto it = v.erase (std::next (v.begin (), 1), std::next (v.begin (), 14));
+    CHECK (6 == v.capacity ());
+    CHECK (std::next (v.begin (), 1) == it);
+    CHECK (14 == *it);
+    CHECK (shrinking_vector<T, 2, Allocator> { 0, 14, 15 } == v);
+
+    it = v.erase (v.begin ());
+    CHECK (6 == v.capacity ());
+    CHECK (v.begin () == it);
+    CHECK (14 == *it);
+
+    // Move back to the inline storage.
+    shrinking_vector<T, 4, Allocator> w;
+    for (int i = 0; i < 16; ++i)
+      w.push_back (i);
+
+    auto jt = w.erase (std::next (w.begin (), 1), std::next (w.begin (), 15));
+    CHECK (4 == w.capacity ());
+    CHECK_IF_NOT_CONSTEXPR (w.inlined ());
+    CHECK (std::next (w.begin (), 1) == jt);
+    CHECK (shrinking_vector<T, 4, Allocator> { 0, 15 } == w);
+  }
+
+  // clear
+  {
+    shrinking_vector<T, 2, Allocator> v;
+    for (int i = 0; i < 16; ++i)
+      v.push_back (i);
+
+    v.clear ();
+    CHECK (v.empty ());
+    CHECK (2 == v.capacity ());
+    CHECK_IF_NOT_CONSTEXPR (v.inlined ());
+
+    shrinking_vector<T, 0, Allocator> w;
+    for (int i = 0; i < 16; ++i)
+      w.push_back (i);
+    w.clear ();
+    CHECK (0 == w.capacity ());
+  }
+
+  // Shrinking stays amortized, so alternating pushes and pops do not reallocate.
+  {
+    shrinking_vector<T, 2, Allocator> v;
+    for (int i = 0; i < 16; ++i)
+      v.push_back (i);
+    while (3 < v.size ())
+      v.pop_back ();
+    CHECK (6 == v.capacity ());
+
+    for (int i = 0; i < 10; ++i)
+    {
+      v.push_back (i);
+      v.pop_back ();
+    }
+    CHECK (6 == v.capacity ());
+  }
+
+  // The default policy never shrinks.
+  {
+    gch::small_vector<T, 2, Allocator> v;
+    for (int i = 0; i < 16; ++i)
+      v.push_back (i);
+    v.clear ();
+    CHECK (16 == v.capacity ());
+  }
+
+  return 0;
+}
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+  using namespace gch::test_types;
+
+  CHECK (0 == test_with_type<int> ());
+  CHECK (0 == test_with_type<non_trivial> ());
+  CHECK (0 == test_with_type<int, sized_allocator<int, std::uint8_t>> ());
+
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+  CHECK (0 == test_with_type<non_trivial, verifying_allocator<non_trivial>> ());
+
+  // Other layouts.
+  {
+    using compact_options =
+      shrink_options<gch::small_vector_shrink::hysteresis<>,
+                     gch::small_vector_layout_options<gch::small_vector_layout::compact>>;
+
+    gch::small_vector<int, 2, std::allocator<int>, compact_options> v;
+    for (int i = 0; i < 16; ++i)
+      v.push_back (i);
+    v.erase (std::next (v.begin ()), v.end ());
+    CHECK (v.inlined ());
+    CHECK (1 == v.size ());
+    CHECK (0 == v.front ());
+
+    using header_options =
+      shrink_options<gch::small_vector_shrink::hysteresis<>,
+                     gch::small_vector_layout_options<gch::small_vector_layout::heap_header>>;
+
+    gch::small_vector<int, 0, std::allocator<int>, header_options> w;
+    for (int i = 0; i < 16; ++i)
+      w.push_back (i);
+    w.erase (std::next (w.begin (), 3), w.end ());
+    CHECK (6 == w.capacity ());
+    CHECK (3 == w.size ());
+    CHECK (2 == w.back ());
+  }
+#endif
+
+  return 0;
+}
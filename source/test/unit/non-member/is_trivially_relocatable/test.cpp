@@ -0,0 +1,298 @@
+/** test.cpp
+ * Copyright © 2022 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+
+#include <memory>
+
+// Counts the number of live objects, and the number of times the move constructor is called.
+// Since relocation doesn't call either the move constructor or the destructor, the counts tell
+// us which path was taken.
+struct relocation_counts
+{
+  static int live;
+  static int moves;
+  static bool throw_on_copy;
+};
+
+int  relocation_counts::live          = 0;
+int  relocation_counts::moves         = 0;
+bool relocation_counts::throw_on_copy = false;
+
+class relocatable
+{
+public:
+  relocatable (void)
+    : m_ptr (new int (0))
+  {
+    ++relocation_counts::live;
+  }
+
+  relocatable (int i)
+    : m_ptr (new int (i))
+  {
+    ++relocation_counts::live;
+  }
+
+  relocatable (const relocatable& other)
+    : m_ptr (new int (other.get ()))
+  {
+#ifdef GCH_EXCEPTIONS
+    if (relocation_counts::throw_on_copy)
+      throw gch::test_types::test_exception { };
+#endif
+    ++relocation_counts::live;
+  }
+
+  relocatable (relocatable&& other) noexcept
+    : m_ptr (std::move (other.m_ptr))
+  {
+    ++relocation_counts::live;
+    ++relocation_counts::moves;
+  }
+
+  relocatable&
+  operator= (const relocatable& other)
+  {
+    *m_ptr = other.get ();
+    return *this;
+  }
+
+  relocatable&
+  operator= (relocatable&& other) noexcept
+  {
+    m_ptr = std::move (other.m_ptr);
+    return *this;
+  }
+
+  ~relocatable (void)
+  {
+    --relocation_counts::live;
+  }
+
+  int
+  get (void) const noexcept
+  {
+    return m_ptr ? *m_ptr : -1;
+  }
+
+  friend
+  bool
+  operator== (const relocatable& lhs, const relocatable& rhs) noexcept
+  {
+    return lhs.get () == rhs.get ();
+  }
+
+private:
+  std::unique_ptr<int> m_ptr;
+};
+
+namespace gch
+{
+
+  template <>
+  struct is_trivially_relocatable<relocatable>
+    : std::true_type
+  { };
+
+}
+
+// A literal type with a non-trivial move constructor, so that we can check the constexpr path.
+struct constexpr_relocatable
+{
+  constexpr_relocatable (void) = default;
+
+  constexpr
+  constexpr_relocatable (int i) noexcept
+    : value (i)
+  { }
+
+  GCH_CPP14_CONSTEXPR
+  constexpr_relocatable (constexpr_relocatable&& other) noexcept
+    : value (other.value)
+  {
+    other.value = -1;
+  }
+
+  GCH_CPP14_CONSTEXPR constexpr_relocatable (const constexpr_relocatable&) = default;
+  GCH_CPP14_CONSTEXPR constexpr_relocatable& operator= (const constexpr_relocatable&) = default;
+  GCH_CPP14_CONSTEXPR constexpr_relocatable& operator= (constexpr_relocatable&&) = default;
+
+  friend constexpr
+  bool
+  operator== (const constexpr_relocatable& lhs, const constexpr_relocatable& rhs) noexcept
+  {
+    return lhs.value == rhs.value;
+  }
+
+  int value = 0;
+};
+
+namespace gch
+{
+
+  template <>
+  struct is_trivially_relocatable<constexpr_relocatable>
+    : std::true_type
+  { };
+
+}
+
+static_assert (gch::is_trivially_relocatable<int>::value, "");
+static_assert (gch::is_trivially_relocatable<gch::test_types::trivially_copyable>::value, "");
+static_assert (gch::is_trivially_relocatable<std::unique_ptr<int>>::value, "");
+static_assert (gch::is_trivially_relocatable<std::shared_ptr<int>>::value, "");
+static_assert (gch::is_trivially_relocatable<relocatable>::value, "");
+static_assert (! gch::is_trivially_relocatable<std::unique_ptr<int, void (*) (int *)>>::value,
+               "A custom deleter may not be trivially relocatable.");
+
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+
+static
+int
+test_runtime (void)
+{
+  using vector_type = gch::small_vector<relocatable, 2>;
+
+  // Reallocation relocates the existing elements.
+  {
+    vector_type v;
+    v.emplace_back (1);
+    v.emplace_back (2);
+    relocation_counts::moves = 0;
+
+    v.emplace_back (3);
+    v.reserve (32);
+    v.shrink_to_fit ();
+    v.insert (v.begin () + 1, 4, relocatable (5));
+    CHECK (0 == relocation_counts::moves);
+    CHECK (vector_type { 1, 5, 5, 5, 5, 2, 3 } == v);
+    CHECK (7 == relocation_counts::live);
+
+    v.resize (100);
+    CHECK (0 == relocation_counts::moves);
+    CHECK (100 == relocation_counts::live);
+  }
+  CHECK (0 == relocation_counts::live);
+
+  // Insertion and erasure in the middle shift the tail with `memmove`.
+  {
+    vector_type v { 1, 2, 3, 4, 5 };
+    v.reserve (16);
+    relocation_counts::moves = 0;
+
+    // Only the inserted element is move-constructed. The tail is relocated.
+    v.insert (v.begin () + 1, relocatable (6));
+    CHECK (1 == relocation_counts::moves);
+
+    // Elements are emplaced into a temporary first, which is then moved into place.
+    v.emplace (v.begin () + 2, 7);
+    CHECK (2 == relocation_counts::moves);
+
+    // Insert an element from the container itself.
+    v.insert (v.begin (), v[3]);
+    CHECK (vector_type { 2, 1, 6, 7, 2, 3, 4, 5 } == v);
+    CHECK (3 == relocation_counts::moves);
+
+    v.insert (v.begin () + 1, 2, v.back ());
+    CHECK (vector_type { 2, 5, 5, 1, 6, 7, 2, 3, 4, 5 } == v);
+
+    const relocatable arr[] = { 8, 9 };
+    v.insert (v.begin () + 3, std::begin (arr), std::end (arr));
+    CHECK (vector_type { 2, 5, 5, 8, 9, 1, 6, 7, 2, 3, 4, 5 } == v);
+    CHECK (14 == relocation_counts::live);
+
+    v.erase (v.begin ());
+    v.erase (v.begin () + 1, v.begin () + 5);
+    CHECK (vector_type { 5, 6, 7, 2, 3, 4, 5 } == v);
+    CHECK (3 == relocation_counts::moves);
+  }
+  CHECK (0 == relocation_counts::live);
+
+#ifdef GCH_SMALL_VECTOR_TEST_EXCEPTION_SAFETY_TESTING
+  // If a copy throws, the tail is shifted back into place.
+  {
+    vector_type v { 1, 2, 3, 4 };
+    v.reserve (16);
+    const vector_type v_save (v);
+
+    relocation_counts::throw_on_copy = true;
+    const relocatable arr[] = { 8, 9 };
+
+    GCH_TRY
+    {
+      EXPECT_THROW (v.insert (v.begin () + 1, 2, arr[0]));
+    }
+    GCH_CATCH (const gch::test_types::test_exception&)
+    { }
+    CHECK (v_save == v);
+
+    GCH_TRY
+    {
+      EXPECT_THROW (v.insert (v.begin () + 1, std::begin (arr), std::end (arr)));
+    }
+    GCH_CATCH (const gch::test_types::test_exception&)
+    { }
+    CHECK (v_save == v);
+
+    GCH_TRY
+    {
+      EXPECT_THROW (v.insert (v.begin () + 1, arr[1]));
+    }
+    GCH_CATCH (const gch::test_types::test_exception&)
+    { }
+    CHECK (v_save == v);
+
+    relocation_counts::throw_on_copy = false;
+  }
+  CHECK (0 == relocation_counts::live);
+#endif
+
+  // Standard library types.
+  {
+    gch::small_vector<std::unique_ptr<int>, 1> v;
+    for (int i = 0; i < 10; ++i)
+      v.emplace (v.begin (), new int (i));
+    v.erase (v.begin () + 2, v.begin () + 4);
+
+    CHECK (8 == v.size ());
+    CHECK (9 == *v.front ());
+    CHECK (5 == *v[2]);
+    CHECK (0 == *v.back ());
+  }
+
+  return 0;
+}
+
+#endif
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+  using vector_type = gch::small_vector<constexpr_relocatable, 2>;
+
+  vector_type v { 1, 2 };
+  v.push_back (3);
+  v.insert (v.begin () + 1, 4);
+  v.insert (v.begin (), 2, constexpr_relocatable (5));
+  CHECK (vector_type { 5, 5, 1, 4, 2, 3 } == v);
+
+  v.erase (v.begin () + 1, v.begin () + 3);
+  v.erase (v.begin ());
+  CHECK (vector_type { 4, 2, 3 } == v);
+
+  v.reserve (10);
+  v.shrink_to_fit ();
+  CHECK (vector_type { 4, 2, 3 } == v);
+
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+  CHECK (0 == test_runtime ());
+#endif
+
+  return 0;
+}
@@ -0,0 +1,273 @@
+/** test.cpp
+ * Copyright © 2026 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+
+#include "gch/small_vector_ref.hpp"
+
+#include <forward_list>
+
+static_assert (! std::is_constructible<gch::small_vector_ref<int>,
+                                       gch::small_vector<int, 4>&&>::value,
+               "A reference to a temporary vector should not be allowed.");
+
+static_assert (! std::is_copy_assignable<gch::small_vector_ref<int>>::value,
+               "A reference should not be reseated.");
+
+// Not a template on the inline capacity.
+template <typename T>
+void
+fill (gch::small_vector_ref<T> r, int count)
+{
+  for (int i = 0; i < count; ++i)
+    r.push_back (T (i));
+}
+
+template <typename T, unsigned N>
+void
+test_with_capacity (void)
+{
+  using vector_type = gch::small_vector<T, N>;
+  using ref_type    = gch::small_vector_ref<T>;
+
+  // Growth through the reference is seen by the vector.
+  {
+    vector_type v;
+    fill<T> (v, 10);
+    CHECK (10 == v.size ());
+    CHECK (T (9) == v.back ());
+
+    ref_type r (v);
+    CHECK (v.data () == r.data ());
+    CHECK (v.size () == r.size ());
+    CHECK (v.capacity () == r.capacity ());
+    CHECK (v.max_size () == r.max_size ());
+    CHECK (! r.inlined ());
+    CHECK (v.begin () == r.begin ());
+    CHECK (v.end () == r.end ());
+    CHECK (T (3) == r[3]);
+    CHECK (T (3) == r.at (3));
+    CHECK (T (0) == r.front ());
+    CHECK (T (9) == r.back ());
+    GCH_TRY
+    {
+      EXPECT_THROW (r.at (10));
+    }
+    GCH_CATCH (const std::out_of_range&)
+    { }
+
+    r.clear ();
+    CHECK (v.empty ());
+    CHECK (r.empty ());
+
+    r.reset ();
+    CHECK (N == v.capacity ());
+    CHECK (v.inlined ());
+    CHECK (r.inlined ());
+  }
+
+  // Capacity.
+  {
+    vector_type v;
+    ref_type r (v);
+    r.reserve (20);
+    CHECK (20 <= v.capacity ());
+    CHECK (r.try_reserve (30));
+    CHECK (30 <= v.capacity ());
+
+    r.resize (3);
+    CHECK (vector_type (3) == v);
+    r.resize (5, T (7));
+    CHECK (vector_type { T (), T (), T (), T (7), T (7) } == v);
+
+    r.shrink_to_fit ();
+    CHECK (std::max (5U, N) == v.capacity ());
+  }
+
+  // Insertion and erasure.
+  {
+    vector_type v { T (1), T (2) };
+    ref_type r (v);
+
+    const T t (3);
+    r.push_back (t);
+    r.push_back (T (4));
+    CHECK (T (5) == r.emplace_back (5));
+    CHECK (vector_type { T (1), T (2), T (3), T (4), T (5) } == v);
+
+    r.pop_back ();
+    CHECK (vector_type { T (1), T (2), T (3), T (4) } == v);
+
+    CHECK (T (0) == *r.insert (r.begin (), T (0)));
+    CHECK (T (3) == *r.insert (r.end (), t));
+    CHECK (vector_type { T (0), T (1), T (2), T (3), T (4), T (3) } == v);
+
+    auto it = r.insert (std::next (r.begin ()), 2, T (8));
+    CHECK (std::next (v.begin ()) == it);
+    CHECK (vector_type { T (0), T (8), T (8), T (1), T (2), T (3), T (4), T (3) } == v);
+
+    it = r.erase (std::next (r.begin ()), std::next (r.begin (), 3));
+    CHECK (std::next (v.begin ()) == it);
+    it = r.erase (std::prev (r.end ()));
+    CHECK (v.end () == it);
+    CHECK (vector_type { T (0), T (1), T (2), T (3), T (4) } == v);
+
+    it = r.insert (std::next (r.begin (), 2), { T (5), T (6) });
+    CHECK (std::next (v.begin (), 2) == it);
+    CHECK (vector_type { T (0), T (1), T (5), T (6), T (2), T (3), T (4) } == v);
+
+    it = r.emplace (r.begin (), 7);
+    CHECK (v.begin () == it);
+    CHECK (T (7) == v.front ());
+
+    r.append ({ T (8), T (9) });
+    CHECK (T (9) == v.back ());
+    CHECK (10 == v.size ());
+  }
+
+  // Ranges of iterators other than pointers.
+  {
+    const std::forward_list<T> list { T (4), T (5), T (6) };
+
+    vector_type v { T (1), T (2), T (3) };
+    ref_type r (v);
+
+    auto it = r.insert (std::next (r.begin ()), list.begin (), list.end ());
+    CHECK (std::next (v.begin ()) == it);
+    CHECK (vector_type { T (1), T (4), T (5), T (6), T (2), T (3) } == v);
+
+    r.append (list.begin (), list.end ());
+    CHECK (9 == v.size ());
+    CHECK (T (6) == v.back ());
+
+    r.assign (list.begin (), list.end ());
+    CHECK (vector_type { T (4), T (5), T (6) } == v);
+  }
+
+  // Assignment.
+  {
+    vector_type v { T (1), T (2), T (3) };
+    ref_type r (v);
+
+    r.assign (5, T (7));
+    CHECK (vector_type (5, T (7)) == v);
+
+    r.assign ({ T (1), T (2) });
+    CHECK (vector_type { T (1), T (2) } == v);
+
+    r = { T (3), T (4), T (5), T (6), T (7), T (8), T (9), T (10), T (11) };
+    CHECK (vector_type { T (3), T (4), T (5), T (6), T (7), T (8), T (9), T (10), T (11) } == v);
+  }
+
+  // References to vectors of different inline capacities may be compared.
+  {
+    vector_type v { T (1), T (2), T (3) };
+    gch::small_vector<T, 1> w { T (1), T (2), T (3) };
+    CHECK (ref_type (v) == ref_type (w));
+
+    w.push_back (T (4));
+    CHECK (ref_type (v) != ref_type (w));
+
+    ref_type r (w);
+    ref_type s (r);
+    CHECK (w.data () == s.data ());
+  }
+}
+
+template <typename T>
+void
+test_with_type (void)
+{
+  test_with_capacity<T, 0> ();
+  test_with_capacity<T, 2> ();
+  test_with_capacity<T, 8> ();
+}
+
+// Operations which need copies are not needed to build the table.
+static
+void
+test_move_only (void)
+{
+  using vector_type = gch::small_vector<std::unique_ptr<int>, 2>;
+
+  vector_type v;
+  gch::small_vector_ref<std::unique_ptr<int>> r (v);
+
+  r.push_back (std::unique_ptr<int> (new int (1)));
+  r.emplace_back (new int (2));
+  r.insert (r.begin (), std::unique_ptr<int> (new int (0)));
+  r.resize (4);
+  CHECK (4 == v.size ());
+  CHECK (0 == *v[0]);
+  CHECK (1 == *v[1]);
+  CHECK (2 == *v[2]);
+  CHECK (nullptr == v[3]);
+
+  r.erase (r.begin ());
+  CHECK (1 == *v[0]);
+}
+
+// Each vector keeps its own allocator.
+static
+void
+test_allocator (void)
+{
+  using namespace gch::test_types;
+
+  using allocator_type = sized_allocator<int, std::uint8_t>;
+
+  gch::small_vector<int, 2, allocator_type> v;
+  gch::small_vector_ref<int, allocator_type> r (v);
+  r.append ({ 1, 2, 3, 4 });
+  CHECK (4 == v.size ());
+  CHECK (v.get_allocator () == r.get_allocator ());
+  CHECK (v.max_size () == r.max_size ());
+}
+
+// Layouts without a plain header are read through the table.
+static
+void
+test_compact_layout (void)
+{
+  using options = gch::small_vector_layout_options<gch::small_vector_layout::compact>;
+
+  gch::small_vector<int, 2, std::allocator<int>, options> v { 1 };
+  gch::small_vector_ref<int, std::allocator<int>, options> r (v);
+  for (int i = 0; i < 10; ++i)
+  {
+    CHECK (v.data () == r.data ());
+    CHECK (v.size () == r.size ());
+    CHECK (v.capacity () == r.capacity ());
+    CHECK (v.inlined () == r.inlined ());
+    r.push_back (i);
+  }
+
+  r.reset ();
+  CHECK (r.inlined ());
+  CHECK (2 == r.capacity ());
+}
+
+#endif
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+  using namespace gch::test_types;
+
+  test_with_type<int> ();
+  test_with_type<non_trivial> ();
+  test_move_only ();
+  test_allocator ();
+  test_compact_layout ();
+#endif
+
+  return 0;
+}
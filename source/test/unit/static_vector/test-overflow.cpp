@@ -0,0 +1,178 @@
+/** test-overflow.cpp
+ * Copyright © 2022 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+
+#include "gch/static_vector.hpp"
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+  using namespace gch::test_types;
+
+  // The `try_` functions return `nullptr` when full.
+  {
+    gch::static_vector<int, 2> v;
+    int *p = v.try_push_back (1);
+    CHECK (p == v.data ());
+    CHECK (1 == *p);
+
+    p = v.try_emplace_back (2);
+    CHECK (p == v.data () + 1);
+    CHECK (2 == *p);
+
+    p = v.try_push_back (3);
+    CHECK (nullptr == p);
+
+    p = v.try_emplace_back (3);
+    CHECK (nullptr == p);
+    CHECK ((gch::static_vector<int, 2> { 1, 2 }) == v);
+  }
+
+  // The other `try_` functions return false when the result would not fit.
+  {
+    gch::static_vector<int, 4> v { 1, 2 };
+    const int arr[] = { 3, 4, 5 };
+    using it = single_pass_iterator<const int *>;
+
+    bool ret = v.try_insert (v.begin (), std::begin (arr), std::end (arr));
+    CHECK (! ret);
+    ret = v.try_append (it { std::begin (arr) }, it { std::end (arr) });
+    CHECK (! ret);
+    ret = v.try_insert (v.end (), 3, 0);
+    CHECK (! ret);
+    ret = v.try_resize (5);
+    CHECK (! ret);
+    CHECK (! v.try_reserve (5));
+    CHECK ((gch::static_vector<int, 4> { 1, 2 }) == v);
+
+    ret = v.try_insert (v.begin (), 0);
+    CHECK (ret);
+    ret = v.try_append (it { std::begin (arr) }, it { std::next (std::begin (arr)) });
+    CHECK (ret);
+    CHECK ((gch::static_vector<int, 4> { 0, 1, 2, 3 }) == v);
+
+    ret = v.try_insert (v.begin (), 7);
+    CHECK (! ret);
+    ret = v.try_resize (2);
+    CHECK (ret);
+    ret = v.try_insert (v.begin () + 1, { 8, 9 });
+    CHECK (ret);
+    CHECK ((gch::static_vector<int, 4> { 0, 8, 9, 1 }) == v);
+  }
+
+  // The `unchecked_` functions assume that there is space.
+  {
+    gch::static_vector<int, 4> v { 1 };
+    v.unchecked_push_back (2);
+    int& r = v.unchecked_emplace_back (3);
+    CHECK (&r == &v.back ());
+
+    const int arr[] = { 4 };
+    v.unchecked_append (std::begin (arr), std::end (arr));
+    CHECK ((gch::static_vector<int, 4> { 1, 2, 3, 4 }) == v);
+  }
+
+  // Input ranges which fit are accepted.
+  {
+    const int arr[] = { 1, 2, 3 };
+    using it = single_pass_iterator<const int *>;
+
+    gch::static_vector<int, 4> v (it { std::begin (arr) }, it { std::end (arr) });
+    CHECK ((gch::static_vector<int, 4> { 1, 2, 3 }) == v);
+
+    v.insert (v.begin (), it { std::begin (arr) }, it { std::next (std::begin (arr)) });
+    CHECK ((gch::static_vector<int, 4> { 1, 1, 2, 3 }) == v);
+  }
+
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+
+#ifdef GCH_EXCEPTIONS
+  // Operations which would exceed the capacity throw `std::bad_alloc` and leave the vector
+  // unchanged.
+  {
+    gch::static_vector<nontrivial_data_base, 3> v { 1, 2, 3 };
+    const auto v_save = v;
+    const nontrivial_data_base arr[] = { 4, 5 };
+    using it = single_pass_iterator<const nontrivial_data_base *>;
+
+    GCH_TRY
+    {
+      EXPECT_THROW (v.push_back (4));
+    }
+    GCH_CATCH (const std::bad_alloc&)
+    { }
+    CHECK (v == v_save);
+
+    GCH_TRY
+    {
+      EXPECT_THROW (v.emplace (v.begin (), 4));
+    }
+    GCH_CATCH (const std::bad_alloc&)
+    { }
+    CHECK (v == v_save);
+
+    GCH_TRY
+    {
+      EXPECT_THROW (v.insert (v.begin (), std::begin (arr), std::end (arr)));
+    }
+    GCH_CATCH (const std::bad_alloc&)
+    { }
+    CHECK (v == v_save);
+
+    GCH_TRY
+    {
+      EXPECT_THROW (v.append (it { std::begin (arr) }, it { std::end (arr) }));
+    }
+    GCH_CATCH (const std::bad_alloc&)
+    { }
+    CHECK (v == v_save);
+
+    GCH_TRY
+    {
+      EXPECT_THROW (v.resize (4));
+    }
+    GCH_CATCH (const std::bad_alloc&)
+    { }
+    CHECK (v == v_save);
+
+    GCH_TRY
+    {
+      EXPECT_THROW (v.reserve (4));
+    }
+    GCH_CATCH (const std::bad_alloc&)
+    { }
+    CHECK (v == v_save);
+
+    GCH_TRY
+    {
+      EXPECT_THROW (gch::static_vector<nontrivial_data_base, 3> (4));
+    }
+    GCH_CATCH (const std::bad_alloc&)
+    { }
+  }
+#endif
+
+#ifdef GCH_SMALL_VECTOR_TEST_EXCEPTION_SAFETY_TESTING
+  // Elements appended from an input range are removed if one of them throws.
+  {
+    gch::static_vector<triggering_type, 4> v (1);
+    const auto v_save = v;
+    const triggering_type arr[2];
+    using it = single_pass_iterator<const triggering_type *>;
+
+    exception_trigger::push (1);
+    EXPECT_TEST_EXCEPTION (v.append (it { std::begin (arr) }, it { std::end (arr) }));
+    CHECK (v == v_save);
+  }
+#endif
+
+#endif
+
+  return 0;
+}
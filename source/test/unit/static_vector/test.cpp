@@ -0,0 +1,213 @@
+/** test.cpp
+ * Copyright © 2022 Gene Harvey
+ *
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "unit_test_common.hpp"
+
+#include "gch/static_vector.hpp"
+
+template <typename T, unsigned N>
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test_with_type (void)
+{
+  using vector_type = gch::static_vector<T, N>;
+
+  static_assert (N == vector_type::capacity (), "Capacity should be fixed.");
+  static_assert (N == vector_type::max_size (), "Max size should be the capacity.");
+
+  // Construction.
+  {
+    vector_type v;
+    CHECK (v.empty ());
+
+    vector_type w (2, T (7));
+    CHECK (2 == w.size ());
+    CHECK (T (7) == w[0]);
+    CHECK (T (7) == w[1]);
+
+    vector_type x { T (1), T (2), T (3) };
+    CHECK (3 == x.size ());
+
+    vector_type y (x.begin (), x.end ());
+    CHECK (x == y);
+
+    vector_type z (x);
+    CHECK (x == z);
+
+    vector_type a (std::move (z));
+    CHECK (x == a);
+
+    vector_type b (3);
+    CHECK (3 == b.size ());
+  }
+
+  // Assignment.
+  {
+    vector_type v { T (1), T (2), T (3) };
+    vector_type w { T (4) };
+
+    w = v;
+    CHECK (v == w);
+
+    w = { T (5), T (6) };
+    CHECK ((vector_type { T (5), T (6) }) == w);
+
+    v = std::move (w);
+    CHECK ((vector_type { T (5), T (6) }) == v);
+
+    v.assign (3, T (1));
+    CHECK ((vector_type { T (1), T (1), T (1) }) == v);
+
+    v.assign ({ T (2), T (3) });
+    CHECK ((vector_type { T (2), T (3) }) == v);
+  }
+
+  // Modifiers.
+  {
+    vector_type v;
+    v.push_back (T (1));
+    v.emplace_back (3);
+    CHECK ((vector_type { T (1), T (3) }) == v);
+
+    v.insert (v.begin () + 1, T (2));
+    CHECK ((vector_type { T (1), T (2), T (3) }) == v);
+
+    v.erase (v.begin ());
+    CHECK ((vector_type { T (2), T (3) }) == v);
+
+    v.insert (v.begin (), 2, T (0));
+    CHECK ((vector_type { T (0), T (0), T (2), T (3) }) == v);
+
+    v.erase (v.begin (), v.begin () + 2);
+    CHECK ((vector_type { T (2), T (3) }) == v);
+
+    v.pop_back ();
+    CHECK ((vector_type { T (2) }) == v);
+
+    v.resize (3, T (4));
+    CHECK ((vector_type { T (2), T (4), T (4) }) == v);
+
+    v.resize (1);
+    CHECK ((vector_type { T (2) }) == v);
+
+    v.append ({ T (5), T (6) });
+    CHECK ((vector_type { T (2), T (5), T (6) }) == v);
+
+    v.clear ();
+    CHECK (v.empty ());
+  }
+
+  // Swap.
+  {
+    vector_type v { T (1), T (2), T (3) };
+    vector_type w { T (4) };
+    vector_type v_save = v;
+    vector_type w_save = w;
+
+    v.swap (w);
+    CHECK (v == w_save);
+    CHECK (w == v_save);
+
+    swap (v, w);
+    CHECK (v == v_save);
+    CHECK (w == w_save);
+  }
+
+  // Comparison.
+  {
+    vector_type v { T (1), T (2) };
+    vector_type w { T (1), T (3) };
+    CHECK (v != w);
+    CHECK (v < w);
+    CHECK (v <= w);
+    CHECK (w > v);
+    CHECK (w >= v);
+  }
+
+  // Non-member erasure.
+  {
+    vector_type v { T (1), T (2), T (1), T (3) };
+    auto ret = gch::erase (v, T (1));
+    CHECK ((vector_type { T (2), T (3) }) == v);
+    CHECK (2 == ret);
+
+    ret = gch::erase_if (v, [](const T& t) { return t == T (3); });
+    CHECK ((vector_type { T (2) }) == v);
+    CHECK (1 == ret);
+  }
+
+  return 0;
+}
+
+// Iterator arithmetic must be able to span the whole capacity.
+template <typename T, unsigned N>
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test_full_range (void)
+{
+  using vector_type = gch::static_vector<T, N>;
+
+  static_assert (N <= static_cast<std::size_t> (
+                        (std::numeric_limits<typename vector_type::difference_type>::max) ()),
+                 "The difference type should be able to hold the capacity.");
+
+  vector_type v;
+  for (unsigned i = 0; i < N; ++i)
+    v.emplace_back (static_cast<int> (i));
+
+  CHECK (N == static_cast<std::size_t> (v.end () - v.begin ()));
+  CHECK (N == static_cast<std::size_t> (std::distance (v.begin (), v.end ())));
+  CHECK (N == static_cast<std::size_t> (std::distance (v.rbegin (), v.rend ())));
+  CHECK (T (static_cast<int> (N - 1)) == *(v.begin () + static_cast<int> (N - 1)));
+
+  v.erase (v.begin () + static_cast<int> (N / 2));
+  CHECK (N - 1 == v.size ());
+  CHECK (T (static_cast<int> (N / 2 - 1)) == v[N / 2 - 1]);
+  for (unsigned i = N / 2; i < N - 1; ++i)
+    CHECK (T (static_cast<int> (i + 1)) == v[i]);
+
+  v.insert (v.begin () + static_cast<int> (N / 2), T (static_cast<int> (N / 2)));
+  CHECK (N == v.size ());
+  for (unsigned i = 0; i < N; ++i)
+    CHECK (T (static_cast<int> (i)) == v[i]);
+
+  return 0;
+}
+
+GCH_SMALL_VECTOR_TEST_CONSTEXPR
+int
+test (void)
+{
+  using namespace gch::test_types;
+
+  // Nothing is stored besides the elements and the size.
+  static_assert (sizeof (gch::static_vector<int, 4>) <= 5 * sizeof (int), "Unexpected size.");
+  static_assert (sizeof (gch::static_vector<char, 4>) == 5, "Unexpected size.");
+
+  {
+    gch::static_vector<int, 0> v;
+    CHECK (v.empty ());
+    CHECK (0 == v.capacity ());
+  }
+
+  CHECK (0 == test_with_type<int, 4> ());
+  CHECK (0 == test_with_type<int, 300> ());
+
+  CHECK (0 == test_full_range<int, 127> ());
+  CHECK (0 == test_full_range<int, 200> ());
+  CHECK (0 == test_full_range<int, 40000> ());
+
+  // Only types which are trivially default constructible and trivially destructible can be used
+  // during constant evaluation.
+#ifndef GCH_SMALL_VECTOR_TEST_HAS_CONSTEXPR
+  CHECK (0 == test_with_type<trivially_copyable_data_base, 4> ());
+  CHECK (0 == test_with_type<nontrivial_data_base, 4> ());
+  CHECK (0 == test_full_range<nontrivial_data_base, 200> ());
+#endif
+
+  return 0;
+}